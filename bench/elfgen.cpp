@@ -0,0 +1,608 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "elfgen.h"
+#include <elf.h>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+namespace bench {
+
+/* xorshift32()
+   deterministic pseudo-random sequence, so that a given shape always yields the same object
+*/
+static std::uint32_t xorshift32(std::uint32_t& state) noexcept
+{
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return state;
+}
+
+/* strtab_t
+   string table under construction
+*/
+struct strtab_t
+{
+  std::vector<char> data{0};
+
+  int   add(const std::string& name) noexcept {
+        int l_offset = data.size();
+        data.insert(data.end(), name.begin(), name.end());
+        data.push_back(0);
+        return l_offset;
+  }
+};
+
+static void  put_data(std::vector<std::uint8_t>& file, const void* data, std::size_t size) noexcept
+{
+      auto l_data = reinterpret_cast<const std::uint8_t*>(data);
+      file.insert(file.end(), l_data, l_data + size);
+}
+
+static int   put_align(std::vector<std::uint8_t>& file, int align) noexcept
+{
+      while(file.size() % align) {
+          file.push_back(0);
+      }
+      return file.size();
+}
+
+int   elfgen_get_buffer_align(int index) noexcept
+{
+      static const int s_align_list[] = {1, 8, 2, 16, 4};
+      return s_align_list[index % 5];
+}
+
+int   elfgen_get_buffer_size(int index) noexcept
+{
+      static const int s_size_list[] = {3, 24, 6, 48, 12};
+      return s_size_list[index % 5] + index / 5 % 3 * elfgen_get_buffer_align(index);
+}
+
+bool  elfgen_write(const char* path, const elfgen_t& shape) noexcept
+{
+      std::uint32_t l_seed = shape.seed ? shape.seed : 1u;
+      int  l_text_count = shape.section_count > 0 ? shape.section_count : 1;
+      int  l_func_count = shape.function_count;
+      int  l_func_size  = shape.function_size & ~3;
+      int  l_rel_count  = shape.rel_per_function;
+      if(l_rel_count * 4 > l_func_size) {
+          l_rel_count = l_func_size / 4;
+      }
+      int  l_mix_sum = 0;
+      for(int l_kind = 0; l_kind < rel_kind_count; l_kind++) {
+          l_mix_sum += shape.rel_mix[l_kind];
+      }
+      // section indices: null, text[n], .data, buffers, .rel.text[n], .rel.data, .symtab, .strtab, .shstrtab
+      int  l_text_base   = 1;
+      int  l_data_index  = l_text_base + l_text_count;
+      int  l_buf_index   = l_data_index + 1;
+      int  l_rel_base    = l_buf_index + shape.buffer_count;
+      int  l_rel_data    = l_rel_base + l_text_count;
+      int  l_symtab_index = l_rel_data + 1;
+      int  l_strtab_index = l_symtab_index + 1;
+      int  l_shstr_index = l_strtab_index + 1;
+      int  l_shdr_count  = l_shstr_index + 1;
+      // symbol indices: null, functions, objects, externs, imports, buffers
+      int  l_func_base   = 1;
+      int  l_obj_base    = l_func_base + l_func_count;
+      int  l_ext_base    = l_obj_base + shape.object_count;
+      int  l_imp_base    = l_ext_base + shape.extern_count;
+      int  l_buf_base    = l_imp_base + shape.import_count;
+      int  l_sym_count   = l_buf_base + shape.buffer_count;
+
+      strtab_t  l_strtab;
+      strtab_t  l_shstrtab;
+      std::vector<Elf32_Sym>              l_sym_list(l_sym_count);
+      std::vector<std::vector<Elf32_Rel>> l_rel_list(l_text_count);
+      std::vector<Elf32_Rel>              l_rel_data_list;
+      std::vector<int>                    l_text_size(l_text_count, 0);
+      std::memset(l_sym_list.data(), 0, l_sym_count * sizeof(Elf32_Sym));
+
+      // functions, spread over the code sections
+      for(int l_func = 0; l_func < l_func_count; l_func++) {
+          int        l_text = l_func % l_text_count;
+          Elf32_Sym& l_sym = l_sym_list[l_func_base + l_func];
+          l_sym.st_name  = l_strtab.add(shape.prefix + std::to_string(l_func));
+          l_sym.st_value = l_text_size[l_text];
+          l_sym.st_size  = l_func_size;
+          l_sym.st_info  = ELF32_ST_INFO(STB_GLOBAL, STT_FUNC);
+          l_sym.st_shndx = l_text_base + l_text;
+          if(l_func >= l_func_count - shape.hidden_count) {
+              l_sym.st_other = STV_HIDDEN;
+          }
+          // relocations within the body of the function
+          for(int l_rel = 0; l_rel < l_rel_count; l_rel++) {
+              int  l_pick = l_mix_sum > 0 ? xorshift32(l_seed) % l_mix_sum : 0;
+              int  l_kind = 0;
+              while((l_kind < rel_kind_count - 1) &&
+                  (l_pick >= shape.rel_mix[l_kind])) {
+                  l_pick -= shape.rel_mix[l_kind];
+                  l_kind++;
+              }
+              int  l_type;
+              int  l_target;
+              int  l_reach = xorshift32(l_seed) % 8;
+              if((l_reach == 0) &&
+                  (shape.extern_count > 0)) {
+                  // host symbols may be anywhere in the address space: only absolute relocations can reach them
+                  l_kind = rel_abs32;
+                  l_target = l_ext_base + xorshift32(l_seed) % shape.extern_count;
+              } else
+              if((l_reach == 1) &&
+                  (shape.import_count > 0)) {
+                  // calls into other objects are expected to be `long_call`s, see the README
+                  l_kind = rel_abs32;
+                  l_target = l_imp_base + xorshift32(l_seed) % shape.import_count;
+              } else
+              if((l_kind == rel_thm_call) ||
+                  (l_kind == rel_call)) {
+                  // the pages of a segment are not contiguous on a host heap: keep branches within reach by having the
+                  // function call itself
+                  l_target = l_func_base + l_func;
+              } else
+                  l_target = l_func_base + xorshift32(l_seed) % l_func_count;
+              switch(l_kind) {
+                  case rel_rel32:
+                      l_type = R_ARM_REL32;
+                      break;
+                  case rel_thm_call:
+                      l_type = R_ARM_THM_PC22;
+                      break;
+                  case rel_call:
+                      l_type = R_ARM_CALL;
+                      break;
+                  default:
+                      l_type = R_ARM_ABS32;
+                      break;
+              }
+              Elf32_Rel& l_rel_info = l_rel_list[l_text].emplace_back();
+              l_rel_info.r_offset = l_text_size[l_text] + l_rel * 4;
+              l_rel_info.r_info   = ELF32_R_INFO(l_target, l_type);
+          }
+          l_text_size[l_text] += l_func_size;
+      }
+      // data objects, each pointing to a function
+      for(int l_obj = 0; l_obj < shape.object_count; l_obj++) {
+          Elf32_Sym& l_sym = l_sym_list[l_obj_base + l_obj];
+          l_sym.st_name  = l_strtab.add(shape.prefix + "_data" + std::to_string(l_obj));
+          l_sym.st_value = l_obj * 4;
+          l_sym.st_size  = 4;
+          l_sym.st_info  = ELF32_ST_INFO(STB_GLOBAL, STT_OBJECT);
+          l_sym.st_shndx = l_data_index;
+          if(l_func_count > 0) {
+              Elf32_Rel& l_rel_info = l_rel_data_list.emplace_back();
+              l_rel_info.r_offset = l_obj * 4;
+              l_rel_info.r_info   = ELF32_R_INFO(l_func_base + xorshift32(l_seed) % l_func_count, R_ARM_ABS32);
+          }
+      }
+      // undefined references
+      for(int l_ext = 0; l_ext < shape.extern_count; l_ext++) {
+          Elf32_Sym& l_sym = l_sym_list[l_ext_base + l_ext];
+          l_sym.st_name  = l_strtab.add("ext_" + std::to_string(l_ext));
+          l_sym.st_info  = ELF32_ST_INFO(STB_GLOBAL, STT_NOTYPE);
+          l_sym.st_shndx = SHN_UNDEF;
+      }
+      for(int l_imp = 0; l_imp < shape.import_count; l_imp++) {
+          Elf32_Sym& l_sym = l_sym_list[l_imp_base + l_imp];
+          l_sym.st_name  = l_strtab.add(shape.import_prefix + std::to_string(l_imp));
+          l_sym.st_info  = ELF32_ST_INFO(STB_GLOBAL, STT_NOTYPE);
+          l_sym.st_shndx = SHN_UNDEF;
+      }
+      for(int l_buf = 0; l_buf < shape.buffer_count; l_buf++) {
+          Elf32_Sym& l_sym = l_sym_list[l_buf_base + l_buf];
+          l_sym.st_name  = l_strtab.add(shape.prefix + "_buf" + std::to_string(l_buf));
+          l_sym.st_size  = elfgen_get_buffer_size(l_buf);
+          l_sym.st_info  = ELF32_ST_INFO(STB_GLOBAL, STT_OBJECT);
+          l_sym.st_shndx = l_buf_index + l_buf;
+      }
+
+      // lay out the file: header, section contents, section headers
+      std::vector<std::uint8_t> l_file(sizeof(Elf32_Ehdr), 0);
+      std::vector<Elf32_Shdr>   l_shdr_list(l_shdr_count);
+      std::memset(l_shdr_list.data(), 0, l_shdr_count * sizeof(Elf32_Shdr));
+      for(int l_text = 0; l_text < l_text_count; l_text++) {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_text_base + l_text];
+          l_shdr.sh_name   = l_shstrtab.add(".text." + std::to_string(l_text));
+          l_shdr.sh_type   = SHT_PROGBITS;
+          l_shdr.sh_flags  = SHF_ALLOC | SHF_EXECINSTR;
+          l_shdr.sh_offset = put_align(l_file, 4);
+          l_shdr.sh_size   = l_text_size[l_text];
+          l_shdr.sh_addralign = 4;
+          l_file.resize(l_file.size() + l_text_size[l_text], 0);
+      }
+      {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_data_index];
+          l_shdr.sh_name   = l_shstrtab.add(".data");
+          l_shdr.sh_type   = SHT_PROGBITS;
+          l_shdr.sh_flags  = SHF_ALLOC | SHF_WRITE;
+          l_shdr.sh_offset = put_align(l_file, 4);
+          l_shdr.sh_size   = shape.object_count * 4;
+          l_shdr.sh_addralign = 4;
+          l_file.resize(l_file.size() + l_shdr.sh_size, 0);
+      }
+      for(int l_buf = 0; l_buf < shape.buffer_count; l_buf++) {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_buf_index + l_buf];
+          if(l_buf % 2) {
+              l_shdr.sh_name   = l_shstrtab.add(".bss.buf" + std::to_string(l_buf));
+              l_shdr.sh_type   = SHT_NOBITS;
+              l_shdr.sh_flags  = SHF_ALLOC | SHF_WRITE;
+              l_shdr.sh_offset = l_file.size();
+          } else {
+              l_shdr.sh_name   = l_shstrtab.add(".rodata.buf" + std::to_string(l_buf));
+              l_shdr.sh_type   = SHT_PROGBITS;
+              l_shdr.sh_flags  = SHF_ALLOC;
+              l_shdr.sh_offset = put_align(l_file, elfgen_get_buffer_align(l_buf));
+              l_file.resize(l_file.size() + elfgen_get_buffer_size(l_buf), l_buf & 0xff);
+          }
+          l_shdr.sh_size   = elfgen_get_buffer_size(l_buf);
+          l_shdr.sh_addralign = elfgen_get_buffer_align(l_buf);
+      }
+      for(int l_text = 0; l_text < l_text_count; l_text++) {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_rel_base + l_text];
+          l_shdr.sh_name   = l_shstrtab.add(".rel.text." + std::to_string(l_text));
+          l_shdr.sh_type   = SHT_REL;
+          l_shdr.sh_offset = put_align(l_file, 4);
+          l_shdr.sh_size   = l_rel_list[l_text].size() * sizeof(Elf32_Rel);
+          l_shdr.sh_link   = l_symtab_index;
+          l_shdr.sh_info   = l_text_base + l_text;
+          l_shdr.sh_addralign = 4;
+          l_shdr.sh_entsize = sizeof(Elf32_Rel);
+          put_data(l_file, l_rel_list[l_text].data(), l_shdr.sh_size);
+      }
+      {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_rel_data];
+          l_shdr.sh_name   = l_shstrtab.add(".rel.data");
+          l_shdr.sh_type   = SHT_REL;
+          l_shdr.sh_offset = put_align(l_file, 4);
+          l_shdr.sh_size   = l_rel_data_list.size() * sizeof(Elf32_Rel);
+          l_shdr.sh_link   = l_symtab_index;
+          l_shdr.sh_info   = l_data_index;
+          l_shdr.sh_addralign = 4;
+          l_shdr.sh_entsize = sizeof(Elf32_Rel);
+          put_data(l_file, l_rel_data_list.data(), l_shdr.sh_size);
+      }
+      {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_symtab_index];
+          l_shdr.sh_name   = l_shstrtab.add(".symtab");
+          l_shdr.sh_type   = SHT_SYMTAB;
+          l_shdr.sh_offset = put_align(l_file, 4);
+          l_shdr.sh_size   = l_sym_count * sizeof(Elf32_Sym);
+          l_shdr.sh_link   = l_strtab_index;
+          l_shdr.sh_info   = 1;
+          l_shdr.sh_addralign = 4;
+          l_shdr.sh_entsize = sizeof(Elf32_Sym);
+          put_data(l_file, l_sym_list.data(), l_shdr.sh_size);
+      }
+      {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_strtab_index];
+          l_shdr.sh_name   = l_shstrtab.add(".strtab");
+          l_shdr.sh_type   = SHT_STRTAB;
+          l_shdr.sh_offset = l_file.size();
+          l_shdr.sh_size   = l_strtab.data.size();
+          l_shdr.sh_addralign = 1;
+          put_data(l_file, l_strtab.data.data(), l_shdr.sh_size);
+      }
+      {
+          Elf32_Shdr& l_shdr = l_shdr_list[l_shstr_index];
+          l_shdr.sh_name   = l_shstrtab.add(".shstrtab");
+          l_shdr.sh_type   = SHT_STRTAB;
+          l_shdr.sh_offset = l_file.size();
+          l_shdr.sh_size   = l_shstrtab.data.size();
+          l_shdr.sh_addralign = 1;
+          put_data(l_file, l_shstrtab.data.data(), l_shdr.sh_size);
+      }
+      int  l_shdr_offset = put_align(l_file, 4);
+      put_data(l_file, l_shdr_list.data(), l_shdr_count * sizeof(Elf32_Shdr));
+
+      Elf32_Ehdr l_head;
+      std::memset(std::addressof(l_head), 0, sizeof(l_head));
+      std::memcpy(l_head.e_ident, ELFMAG, SELFMAG);
+      l_head.e_ident[EI_CLASS]   = ELFCLASS32;
+      l_head.e_ident[EI_DATA]    = ELFDATA2LSB;
+      l_head.e_ident[EI_VERSION] = EV_CURRENT;
+      l_head.e_ident[EI_OSABI]   = ELFOSABI_NONE;
+      l_head.e_type      = ET_REL;
+      l_head.e_machine   = EM_ARM;
+      l_head.e_version   = EV_CURRENT;
+      l_head.e_shoff     = l_shdr_offset;
+      l_head.e_flags     = EF_ARM_EABI_VER5;
+      l_head.e_ehsize    = sizeof(Elf32_Ehdr);
+      l_head.e_shentsize = sizeof(Elf32_Shdr);
+      l_head.e_shnum     = l_shdr_count;
+      l_head.e_shstrndx  = l_shstr_index;
+      std::memcpy(l_file.data(), std::addressof(l_head), sizeof(l_head));
+
+      FILE* l_fp = std::fopen(path, "wb");
+      if(l_fp == nullptr) {
+          return false;
+      }
+      bool  l_write_success = std::fwrite(l_file.data(), 1, l_file.size(), l_fp) == l_file.size();
+      std::fclose(l_fp);
+      return l_write_success;
+}
+
+/* put_code()
+   append an instruction to a code section, with room for the 32 bit field of its relocation, if any, which is then
+   recorded against symbol `symbol` with addend `addend`
+*/
+static void  put_code(std::vector<std::uint8_t>& code, std::initializer_list<std::uint8_t> bytes, std::vector<Elf64_Rela>* rel_list = nullptr, int symbol = 0, int type = R_X86_64_NONE, std::int64_t addend = 0) noexcept
+{
+      code.insert(code.end(), bytes);
+      if(rel_list != nullptr) {
+          Elf64_Rela& l_rela_info = rel_list->emplace_back();
+          l_rela_info.r_offset = code.size();
+          l_rela_info.r_info   = ELF64_R_INFO(symbol, type);
+          l_rela_info.r_addend = addend;
+          code.insert(code.end(), 4, 0);
+      }
+}
+
+std::int64_t elfgen64_get_table_value(const elfgen64_t& shape, int index) noexcept
+{
+      return (index * 7 + shape.seed) % 1009 + 1;
+}
+
+bool  elfgen64_write(const char* path, const elfgen64_t& shape) noexcept
+{
+      constexpr int l_func_size = 64;
+      int  l_text_count = shape.section_count > 0 ? shape.section_count : 1;
+      int  l_func_count = shape.function_count;
+      // section indices: null, text[n], .data, .data.rel, .debug_bench, .rela.text[n], .rela.data.rel, .rela.debug_bench,
+      // .symtab, .strtab, .shstrtab
+      int  l_text_base   = 1;
+      int  l_table_index = l_text_base + l_text_count;
+      int  l_ptrs_index  = l_table_index + 1;
+      int  l_debug_index = l_ptrs_index + 1;
+      int  l_rel_base    = l_debug_index + 1;
+      int  l_rel_ptrs    = l_rel_base + l_text_count;
+      int  l_rel_debug   = l_rel_ptrs + 1;
+      int  l_symtab_index = l_rel_debug + 1;
+      int  l_strtab_index = l_symtab_index + 1;
+      int  l_shstr_index = l_strtab_index + 1;
+      int  l_shdr_count  = l_shstr_index + 1;
+      // symbol indices: null, functions, table, ptrs, callee of the first function, host_bias
+      int  l_func_base   = 1;
+      int  l_table_sym   = l_func_base + l_func_count;
+      int  l_ptrs_sym    = l_table_sym + 1;
+      int  l_callee_sym  = l_ptrs_sym + 1;
+      int  l_bias_sym    = l_callee_sym + 1;
+      int  l_sym_count   = l_bias_sym + 1;
+
+      strtab_t  l_strtab;
+      strtab_t  l_shstrtab;
+      std::vector<Elf64_Sym>                   l_sym_list(l_sym_count);
+      std::vector<std::vector<std::uint8_t>>   l_text_list(l_text_count);
+      std::vector<std::vector<Elf64_Rela>>     l_rel_list(l_text_count);
+      std::vector<std::int64_t>                l_table(l_func_count);
+      std::vector<Elf64_Rela>                  l_rel_ptrs_list;
+      std::vector<Elf64_Rela>                  l_rel_debug_list;
+      std::memset(l_sym_list.data(), 0, l_sym_count * sizeof(Elf64_Sym));
+
+      // functions, spread over the code sections
+      for(int l_func = 0; l_func < l_func_count; l_func++) {
+          int  l_text = l_func % l_text_count;
+          auto& l_code = l_text_list[l_text];
+          auto& l_rels = l_rel_list[l_text];
+          int  l_func_base_offset = l_code.size();
+          std::int32_t l_disp = l_func * 8;
+          Elf64_Sym& l_sym = l_sym_list[l_func_base + l_func];
+          l_sym.st_name  = l_strtab.add(shape.prefix + std::to_string(l_func));
+          l_sym.st_value = l_func_base_offset;
+          l_sym.st_size  = l_func_size;
+          l_sym.st_info  = ELF64_ST_INFO(STB_GLOBAL, STT_FUNC);
+          l_sym.st_shndx = l_text_base + l_text;
+          put_code(l_code, {0x53});                                                           // push %rbx
+          put_code(l_code, {0x48, 0x8b, 0x05}, &l_rels, l_ptrs_sym, R_X86_64_REX_GOTPCRELX, -4); // mov ptrs@GOTPCREL(%rip), %rax
+          put_code(l_code, {0x48, 0x8b, 0x98,                                                 // mov <8n>(%rax), %rbx
+              static_cast<std::uint8_t>(l_disp), static_cast<std::uint8_t>(l_disp >> 8),
+              static_cast<std::uint8_t>(l_disp >> 16), static_cast<std::uint8_t>(l_disp >> 24)});
+          put_code(l_code, {0x48, 0x8b, 0x1b});                                               // mov (%rbx), %rbx
+          put_code(l_code, {0x48, 0x03, 0x1d}, &l_rels, l_table_sym, R_X86_64_PC32, l_disp - 4); // add table+<8n>(%rip), %rbx
+          put_code(l_code, {0x48, 0x8b, 0x15}, &l_rels, l_bias_sym, R_X86_64_GOTPCREL, -4);    // mov host_bias@GOTPCREL(%rip), %rdx
+          put_code(l_code, {0x48, 0x03, 0x1a});                                               // add (%rdx), %rbx
+          if(shape.abs32s) {
+              put_code(l_code, {0x48, 0xc7, 0xc2}, &l_rels, l_table_sym, R_X86_64_32S, l_disp); // mov $table+<8n>, %rdx
+              put_code(l_code, {0x48, 0x03, 0x1a});                                           // add (%rdx), %rbx
+          }
+          put_code(l_code, {0xe8}, &l_rels, l_func > 0 ? l_func_base + l_func - 1 : l_callee_sym, R_X86_64_PLT32, -4); // call
+          put_code(l_code, {0x48, 0x01, 0xd8});                                               // add %rbx, %rax
+          put_code(l_code, {0x5b, 0xc3});                                                     // pop %rbx; ret
+          l_code.resize(l_func_base_offset + l_func_size, 0xcc);
+          l_table[l_func] = elfgen64_get_table_value(shape, l_func);
+          // the pointer to the table entry of the function
+          Elf64_Rela& l_rela_info = l_rel_ptrs_list.emplace_back();
+          l_rela_info.r_offset = l_func * 8;
+          l_rela_info.r_info   = ELF64_R_INFO(l_table_sym, R_X86_64_64);
+          l_rela_info.r_addend = l_disp;
+      }
+      {
+          // debug info the loader leaves out, relocations and all
+          Elf64_Rela& l_rela_info = l_rel_debug_list.emplace_back();
+          l_rela_info.r_offset = 0;
+          l_rela_info.r_info   = ELF64_R_INFO(l_table_sym, R_X86_64_64);
+          l_rela_info.r_addend = 0;
+      }
+      {
+          Elf64_Sym& l_sym = l_sym_list[l_table_sym];
+          l_sym.st_name  = l_strtab.add(shape.prefix + "_table");
+          l_sym.st_size  = l_func_count * 8;
+          l_sym.st_info  = ELF64_ST_INFO(STB_GLOBAL, STT_OBJECT);
+          l_sym.st_shndx = l_table_index;
+      }
+      {
+          Elf64_Sym& l_sym = l_sym_list[l_ptrs_sym];
+          l_sym.st_name  = l_strtab.add(shape.prefix + "_ptrs");
+          l_sym.st_size  = l_func_count * 8;
+          l_sym.st_info  = ELF64_ST_INFO(STB_GLOBAL, STT_OBJECT);
+          l_sym.st_shndx = l_ptrs_index;
+      }
+      {
+          Elf64_Sym& l_sym = l_sym_list[l_callee_sym];
+          if(shape.import_prefix.empty()) {
+              l_sym.st_name = l_strtab.add("host_leaf");
+          } else
+              l_sym.st_name = l_strtab.add(shape.import_prefix + std::to_string(shape.import_index));
+          l_sym.st_info  = ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE);
+          l_sym.st_shndx = SHN_UNDEF;
+      }
+      {
+          Elf64_Sym& l_sym = l_sym_list[l_bias_sym];
+          l_sym.st_name  = l_strtab.add("host_bias");
+          l_sym.st_info  = ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE);
+          l_sym.st_shndx = SHN_UNDEF;
+      }
+
+      // lay out the file: header, section contents, section headers
+      std::vector<std::uint8_t> l_file(sizeof(Elf64_Ehdr), 0);
+      std::vector<Elf64_Shdr>   l_shdr_list(l_shdr_count);
+      std::memset(l_shdr_list.data(), 0, l_shdr_count * sizeof(Elf64_Shdr));
+      for(int l_text = 0; l_text < l_text_count; l_text++) {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_text_base + l_text];
+          l_shdr.sh_name   = l_shstrtab.add(".text." + std::to_string(l_text));
+          l_shdr.sh_type   = SHT_PROGBITS;
+          l_shdr.sh_flags  = SHF_ALLOC | SHF_EXECINSTR;
+          l_shdr.sh_offset = put_align(l_file, 16);
+          l_shdr.sh_size   = l_text_list[l_text].size();
+          l_shdr.sh_addralign = 16;
+          put_data(l_file, l_text_list[l_text].data(), l_shdr.sh_size);
+      }
+      {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_table_index];
+          l_shdr.sh_name   = l_shstrtab.add(".data");
+          l_shdr.sh_type   = SHT_PROGBITS;
+          l_shdr.sh_flags  = SHF_ALLOC | SHF_WRITE;
+          l_shdr.sh_offset = put_align(l_file, 8);
+          l_shdr.sh_size   = l_func_count * 8;
+          l_shdr.sh_addralign = 8;
+          put_data(l_file, l_table.data(), l_shdr.sh_size);
+      }
+      {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_ptrs_index];
+          l_shdr.sh_name   = l_shstrtab.add(".data.rel");
+          l_shdr.sh_type   = SHT_PROGBITS;
+          l_shdr.sh_flags  = SHF_ALLOC | SHF_WRITE;
+          l_shdr.sh_offset = put_align(l_file, 8);
+          l_shdr.sh_size   = l_func_count * 8;
+          l_shdr.sh_addralign = 8;
+          l_file.resize(l_file.size() + l_shdr.sh_size, 0);
+      }
+      {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_debug_index];
+          l_shdr.sh_name   = l_shstrtab.add(".debug_bench");
+          l_shdr.sh_type   = SHT_PROGBITS;
+          l_shdr.sh_offset = put_align(l_file, 8);
+          l_shdr.sh_size   = 8;
+          l_shdr.sh_addralign = 1;
+          l_file.resize(l_file.size() + l_shdr.sh_size, 0);
+      }
+      for(int l_rel = 0; l_rel < l_text_count + 2; l_rel++) {
+          std::vector<Elf64_Rela>* l_rels;
+          std::string l_name;
+          int  l_info;
+          if(l_rel < l_text_count) {
+              l_rels = std::addressof(l_rel_list[l_rel]);
+              l_name = ".rela.text." + std::to_string(l_rel);
+              l_info = l_text_base + l_rel;
+          } else
+          if(l_rel == l_text_count) {
+              l_rels = std::addressof(l_rel_ptrs_list);
+              l_name = ".rela.data.rel";
+              l_info = l_ptrs_index;
+          } else {
+              l_rels = std::addressof(l_rel_debug_list);
+              l_name = ".rela.debug_bench";
+              l_info = l_debug_index;
+          }
+          Elf64_Shdr& l_shdr = l_shdr_list[l_rel_base + l_rel];
+          l_shdr.sh_name   = l_shstrtab.add(l_name);
+          l_shdr.sh_type   = SHT_RELA;
+          l_shdr.sh_offset = put_align(l_file, 8);
+          l_shdr.sh_size   = l_rels->size() * sizeof(Elf64_Rela);
+          l_shdr.sh_link   = l_symtab_index;
+          l_shdr.sh_info   = l_info;
+          l_shdr.sh_addralign = 8;
+          l_shdr.sh_entsize = sizeof(Elf64_Rela);
+          put_data(l_file, l_rels->data(), l_shdr.sh_size);
+      }
+      {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_symtab_index];
+          l_shdr.sh_name   = l_shstrtab.add(".symtab");
+          l_shdr.sh_type   = SHT_SYMTAB;
+          l_shdr.sh_offset = put_align(l_file, 8);
+          l_shdr.sh_size   = l_sym_count * sizeof(Elf64_Sym);
+          l_shdr.sh_link   = l_strtab_index;
+          l_shdr.sh_info   = 1;
+          l_shdr.sh_addralign = 8;
+          l_shdr.sh_entsize = sizeof(Elf64_Sym);
+          put_data(l_file, l_sym_list.data(), l_shdr.sh_size);
+      }
+      {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_strtab_index];
+          l_shdr.sh_name   = l_shstrtab.add(".strtab");
+          l_shdr.sh_type   = SHT_STRTAB;
+          l_shdr.sh_offset = l_file.size();
+          l_shdr.sh_size   = l_strtab.data.size();
+          l_shdr.sh_addralign = 1;
+          put_data(l_file, l_strtab.data.data(), l_shdr.sh_size);
+      }
+      {
+          Elf64_Shdr& l_shdr = l_shdr_list[l_shstr_index];
+          l_shdr.sh_name   = l_shstrtab.add(".shstrtab");
+          l_shdr.sh_type   = SHT_STRTAB;
+          l_shdr.sh_offset = l_file.size();
+          l_shdr.sh_size   = l_shstrtab.data.size();
+          l_shdr.sh_addralign = 1;
+          put_data(l_file, l_shstrtab.data.data(), l_shdr.sh_size);
+      }
+      int  l_shdr_offset = put_align(l_file, 8);
+      put_data(l_file, l_shdr_list.data(), l_shdr_count * sizeof(Elf64_Shdr));
+
+      Elf64_Ehdr l_head;
+      std::memset(std::addressof(l_head), 0, sizeof(l_head));
+      std::memcpy(l_head.e_ident, ELFMAG, SELFMAG);
+      l_head.e_ident[EI_CLASS]   = ELFCLASS64;
+      l_head.e_ident[EI_DATA]    = ELFDATA2LSB;
+      l_head.e_ident[EI_VERSION] = EV_CURRENT;
+      l_head.e_ident[EI_OSABI]   = ELFOSABI_NONE;
+      l_head.e_type      = ET_REL;
+      l_head.e_machine   = EM_X86_64;
+      l_head.e_version   = EV_CURRENT;
+      l_head.e_shoff     = l_shdr_offset;
+      l_head.e_ehsize    = sizeof(Elf64_Ehdr);
+      l_head.e_shentsize = sizeof(Elf64_Shdr);
+      l_head.e_shnum     = l_shdr_count;
+      l_head.e_shstrndx  = l_shstr_index;
+      std::memcpy(l_file.data(), std::addressof(l_head), sizeof(l_head));
+
+      FILE* l_fp = std::fopen(path, "wb");
+      if(l_fp == nullptr) {
+          return false;
+      }
+      bool  l_write_success = std::fwrite(l_file.data(), 1, l_file.size(), l_fp) == l_file.size();
+      std::fclose(l_fp);
+      return l_write_success;
+}
+
+/*namespace bench*/ }
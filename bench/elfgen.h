@@ -0,0 +1,99 @@
+#ifndef uld_bench_elfgen_h
+#define uld_bench_elfgen_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <cstdint>
+#include <string>
+
+namespace bench {
+
+/* rel_*
+   relocation kinds the generator can emit, used as indices into `elfgen_t::rel_mix`
+*/
+constexpr int rel_abs32 = 0;      // R_ARM_ABS32
+constexpr int rel_rel32 = 1;      // R_ARM_REL32
+constexpr int rel_thm_call = 2;   // R_ARM_THM_CALL (R_ARM_THM_PC22)
+constexpr int rel_call = 3;       // R_ARM_CALL
+constexpr int rel_kind_count = 4;
+
+/* elfgen_t
+   shape of a synthetic ARM ELF32 relocatable object
+*/
+struct elfgen_t
+{
+  std::string   prefix = "f";           // name prefix of the functions defined by the object
+  int           function_count = 64;
+  int           function_size = 64;     // bytes; relocations are placed in distinct words of the function body
+  int           hidden_count = 0;       // functions, the last ones of the object, given STV_HIDDEN visibility
+  int           section_count = 1;      // code sections, functions are spread over them round robin
+  int           object_count = 16;      // data objects in `.data`, each holding the address of a function
+  int           rel_per_function = 4;
+  int           rel_mix[rel_kind_count] = {4, 1, 2, 1};  // relative weights of the relocation kinds
+  int           extern_count = 0;       // undefined references `ext_<n>`, always relocated as R_ARM_ABS32
+  std::string   import_prefix;          // name prefix of the functions of another object to reference, if any
+  int           import_count = 0;
+  int           buffer_count = 0;       // data sections of mixed alignments, each holding an object, see `elfgen_get_buffer_align()`
+  std::uint32_t seed = 1;
+};
+
+/* elfgen_get_buffer_align(), elfgen_get_buffer_size()
+   alignment and size of the `index`th buffer of an object: buffers `<prefix>_buf<n>` go to `.rodata.buf<n>` sections for
+   even `n` and to `.bss.buf<n>` ones for odd `n`, cycling through alignments of 1 to 16 bytes, with sizes multiple of them
+*/
+int   elfgen_get_buffer_align(int index) noexcept;
+int   elfgen_get_buffer_size(int index) noexcept;
+
+/* elfgen_write()
+   generate an object file with the given shape at `path`
+*/
+bool  elfgen_write(const char* path, const elfgen_t& shape) noexcept;
+
+/* elfgen64_t
+   shape of a synthetic x86-64 ELF64 relocatable object the host can run: `<prefix><n>` returns what `<prefix><n-1>` does,
+   plus twice (thrice with `abs32s`) the `n`th entry of the table `<prefix>_table` and the value of `host_bias`, where
+   `<prefix>0` calls `host_leaf()` or, given an import prefix, `<import_prefix><import_index>`. The functions reach the
+   table through R_X86_64_REX_GOTPCRELX, R_X86_64_64 and R_X86_64_PC32, `host_bias` through R_X86_64_GOTPCREL and call
+   through R_X86_64_PLT32
+*/
+struct elfgen64_t
+{
+  std::string   prefix = "x";           // name prefix of the functions defined by the object
+  int           function_count = 64;
+  int           section_count = 1;      // code sections, functions are spread over them round robin
+  bool          abs32s = false;         // also reach the table through R_X86_64_32S, for objects loaded within the low 2GB
+  std::string   import_prefix;          // name prefix of the functions of another object to call, if any
+  int           import_index = 0;
+  std::uint32_t seed = 1;
+};
+
+/* elfgen64_get_table_value()
+   `index`th entry of the table of an object
+*/
+std::int64_t elfgen64_get_table_value(const elfgen64_t& shape, int index) noexcept;
+
+/* elfgen64_write()
+   generate an x86-64 object file with the given shape at `path`
+*/
+bool  elfgen64_write(const char* path, const elfgen64_t& shape) noexcept;
+
+/*namespace bench*/ }
+#endif
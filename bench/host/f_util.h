@@ -1,3 +1,5 @@
+#ifndef uld_bench_f_util_h
+#define uld_bench_f_util_h
 /** 
     Copyright (c) 2022, wicked systems
     All rights reserved.
@@ -19,11 +21,7 @@
     CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
-#include "elf64.h"
-#include "bin.h"
-#include <log.h>
-#include <elf.h>
-#include <limits>
+#include <ff.h>
 
-namespace uld {
-/*namespace uld*/ }
+const char* FRESULT_str(FRESULT);
+#endif
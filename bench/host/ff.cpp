@@ -0,0 +1,116 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <ff.h>
+#include <f_util.h>
+#include <storage.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+FRESULT f_open(FIL* fp, const char* path, BYTE mode)
+{
+      int  l_flags = O_RDONLY;
+      if(mode & FA_WRITE) {
+          l_flags = O_RDWR;
+      }
+      int  l_fd = open(path, l_flags);
+      if(l_fd < 0) {
+          return FR_NO_FILE;
+      }
+      struct stat l_stat;
+      if(fstat(l_fd, &l_stat) != 0) {
+          close(l_fd);
+          return FR_DISK_ERR;
+      }
+      fp->fd = l_fd + 1;
+      fp->fptr = 0;
+      fp->objsize = l_stat.st_size;
+      bench::storage_on_open(fp, path);
+      return FR_OK;
+}
+
+FRESULT f_close(FIL* fp)
+{
+      if(fp->fd > 0) {
+          close(fp->fd - 1);
+          fp->fd = 0;
+          return FR_OK;
+      }
+      return FR_INVALID_OBJECT;
+}
+
+FRESULT f_read(FIL* fp, void* data, UINT size, UINT* read_size)
+{
+      *read_size = 0;
+      if(fp->fd <= 0) {
+          return FR_INVALID_OBJECT;
+      }
+      bench::storage_on_read(fp, size);
+      ssize_t l_read_size = pread(fp->fd - 1, data, size, fp->fptr);
+      if(l_read_size < 0) {
+          return FR_DISK_ERR;
+      }
+      fp->fptr += l_read_size;
+      *read_size = l_read_size;
+      return FR_OK;
+}
+
+FRESULT f_lseek(FIL* fp, FSIZE_t offset)
+{
+      if(fp->fd <= 0) {
+          return FR_INVALID_OBJECT;
+      }
+      // FatFs clamps read-only seeks to the file size
+      if(offset > fp->objsize) {
+          offset = fp->objsize;
+      }
+      fp->fptr = offset;
+      bench::storage_on_lseek(fp);
+      return FR_OK;
+}
+
+const char* FRESULT_str(FRESULT rc)
+{
+      switch(rc) {
+          case FR_OK:
+              return "Succeeded";
+          case FR_DISK_ERR:
+              return "A hard error occurred in the low level disk I/O layer";
+          case FR_INT_ERR:
+              return "Assertion failed";
+          case FR_NOT_READY:
+              return "The physical drive cannot work";
+          case FR_NO_FILE:
+              return "Could not find the file";
+          case FR_NO_PATH:
+              return "Could not find the path";
+          case FR_INVALID_NAME:
+              return "The path name format is invalid";
+          case FR_DENIED:
+              return "Access denied due to prohibited access or directory full";
+          case FR_EXIST:
+              return "Access denied due to prohibited access";
+          case FR_INVALID_OBJECT:
+              return "The file/directory object is invalid";
+      }
+      return "Unknown error";
+}
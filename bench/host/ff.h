@@ -0,0 +1,68 @@
+#ifndef uld_bench_ff_h
+#define uld_bench_ff_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+/* ff.h
+   FatFs stand-in over POSIX files, providing the subset of the FatFs API the loader uses
+*/
+#include <cstdint>
+
+typedef unsigned int  UINT;
+typedef unsigned char BYTE;
+typedef std::uint32_t FSIZE_t;
+
+typedef enum {
+    FR_OK = 0,
+    FR_DISK_ERR,
+    FR_INT_ERR,
+    FR_NOT_READY,
+    FR_NO_FILE,
+    FR_NO_PATH,
+    FR_INVALID_NAME,
+    FR_DENIED,
+    FR_EXIST,
+    FR_INVALID_OBJECT
+} FRESULT;
+
+/* FIL
+   file object; a zero-filled FIL is a closed file
+*/
+typedef struct {
+    int     fd;         // POSIX file descriptor + 1
+    FSIZE_t fptr;
+    FSIZE_t objsize;
+    int     open_id;    // storage model: identity of the open file
+    int     win_sector; // storage model: sector held by the sector window, -1 if none
+} FIL;
+
+#define FA_READ          0x01
+#define FA_WRITE         0x02
+#define FA_OPEN_EXISTING 0x00
+
+FRESULT f_open(FIL*, const char*, BYTE);
+FRESULT f_close(FIL*);
+FRESULT f_read(FIL*, void*, UINT, UINT*);
+FRESULT f_lseek(FIL*, FSIZE_t);
+
+#define f_size(fp) ((fp)->objsize)
+#define f_tell(fp) ((fp)->fptr)
+#endif
@@ -0,0 +1,1921 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "elfgen.h"
+#include "storage.h"
+#include <uld.h>
+#include <target.h>
+#include <image.h>
+#include <image/symbol_store.h>
+#include <image/export_table.h>
+#include <profile.h>
+#include <stats.h>
+#include <elf.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <fcntl.h>
+
+/* uld_bench
+   host benchmarks for the loader hot paths; each result is written as a single line of JSON
+
+   usage: uld_bench [-o <file>] [-d <directory>] [-q] [-k] [-t <prefix>] [-r <trace>]
+     -o  write the results to <file> instead of stdout
+     -d  directory for the generated objects (default: /tmp)
+     -q  quick run, fewer and smaller samples
+     -k  keep the generated objects
+     -t  save the file accesses recorded by the storage suite to <prefix>.<sample>.trace
+     -r  only replay the file accesses saved in <trace> against the storage models and cache sizes
+*/
+
+/* ext_<n>
+   the host symbols the generated objects reference, as the firmware export table built from `exports.list` names them
+*/
+extern "C" {
+std::uint32_t ext_0, ext_1, ext_2, ext_3, ext_4, ext_5, ext_6, ext_7, ext_8, ext_9, ext_10, ext_11, ext_12, ext_13, ext_14, ext_15;
+}
+
+#if defined(__x86_64__) && defined(__linux__)
+/* host_leaf(), host_bias
+   the host symbols the generated x86-64 objects reference
+*/
+extern "C" {
+std::int64_t host_bias = 3;
+std::int64_t host_leaf() noexcept
+{
+      return 1000;
+}
+}
+#endif
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr double s_time_min = 0.2;    // minimum time, in seconds, to spend on each sample
+constexpr int    s_extern_count = 16;
+
+FILE*        s_out = stdout;
+std::string  s_dir = "/tmp";
+bool         s_quick = false;
+bool         s_keep = false;
+std::string  s_trace_prefix;
+
+const bench::storage_model_t* s_storage_model_list[] = {
+    std::addressof(bench::storage_model_sd_spi),
+    std::addressof(bench::storage_model_sd_sdio),
+    std::addressof(bench::storage_model_qspi)
+};
+
+/* s_reserve_list
+   data cache reserve sizes the recorded accesses are replayed against; -1 stands for the sizes the loader asked for
+*/
+constexpr int s_reserve_list[] = {-1, 128, 512, 1024, 4096};
+
+std::uint8_t s_extern_data[s_extern_count * 4];
+
+double  get_seconds(clock_type::time_point base) noexcept
+{
+      return std::chrono::duration<double>(clock_type::now() - base).count();
+}
+
+std::string get_path(const char* name) noexcept
+{
+      return s_dir + "/uld_bench_" + std::to_string(getpid()) + "_" + name + ".o";
+}
+
+/* define_externs()
+   define the `ext_<n>` host symbols the generated objects reference
+*/
+void  define_externs(uld::image& image) noexcept
+{
+      for(int l_ext = 0; l_ext < s_extern_count; l_ext++) {
+          std::string l_name = "ext_" + std::to_string(l_ext);
+          image.make_symbol(l_name.c_str(), uld::symbol_t::type_object, uld::symbol_t::bind_global, s_extern_data + l_ext * 4);
+      }
+}
+
+void  put_stats(const uld::load_stats_t* stats, int iterations) noexcept
+{
+      if(stats == nullptr) {
+          return;
+      }
+      static const char* s_phase_name[uld::load_stats_t::phase_count] = {
+          "prefetch", "import", "bind", "resolve", "export", "fixup"
+      };
+      // the stats are those of the latest load: report them per load
+      std::fprintf(s_out, ",\"phase_us\":{");
+      for(int l_phase = 0; l_phase < uld::load_stats_t::phase_count; l_phase++) {
+          std::fprintf(s_out, "%s\"%s\":%u", l_phase ? "," : "", s_phase_name[l_phase], stats->phase_time[l_phase]);
+      }
+      std::fprintf(
+          s_out,
+          "},\"reads\":%u,\"read_bytes\":%u,\"seeks\":%u,\"cache_hits\":%u,\"cache_misses\":%u,\"cache_refills\":%u"
+          ",\"lookups\":%u,\"probes\":%u,\"probe_max\":%u,\"relocations\":%u,\"heap_peak\":%u,\"align_pad\":%u,\"align_saved\":%d",
+          stats->read_count,
+          stats->read_bytes,
+          stats->seek_count,
+          stats->cache_hit_count,
+          stats->cache_miss_count,
+          stats->cache_refill_count,
+          stats->lookup_count,
+          stats->lookup_probe_count,
+          stats->lookup_probe_max,
+          stats->rel_count,
+          stats->heap_peak,
+          stats->align_pad_size,
+          stats->align_saved_size
+      );
+      (void)iterations;
+}
+
+void  put_memory(const char* name, const uld::memory_stats_t& stats) noexcept
+{
+      std::fprintf(
+          s_out,
+          "\"%s\":{\"pages\":%u,\"alloc\":%u,\"head\":%u,\"used\":%u,\"pad\":%u,\"slack\":%u}",
+          name,
+          stats.page_count,
+          stats.alloc_size,
+          stats.head_size,
+          stats.used_size,
+          stats.pad_size,
+          stats.slack_size
+      );
+}
+
+void  put_memory(const uld::image_memory_stats_t& stats) noexcept
+{
+      std::fprintf(s_out, ",\"memory\":{");
+      put_memory("strings", stats.string_table);
+      std::fprintf(s_out, ",");
+      put_memory("symbols", stats.symbol_table);
+      std::fprintf(s_out, ",");
+      put_memory("fixups", stats.fixup_table);
+      std::fprintf(s_out, ",");
+      put_memory("segments", stats.program_table);
+      std::fprintf(s_out, ",");
+      put_memory("total", stats.total);
+      std::fprintf(s_out, ",\"heap_peak\":%u}", stats.heap_peak);
+}
+
+/* run_load()
+   time image::load_all() over the given objects, with a fresh image for every iteration; with `arena_size` set, the
+   image pools take their memory from an arena of that size, such that `heap_blocks` only counts the scratch chunks;
+   `options` are the load options of the image
+*/
+void  run_load(
+          const char* suite,
+          const bench::elfgen_t& shape,
+          std::vector<std::string>& path_list,
+          std::size_t arena_size = 0,
+          unsigned int options = uld::image::load_default
+      ) noexcept
+{
+      std::vector<std::uint8_t> l_arena_data(arena_size);
+      std::vector<const char*> l_path_list;
+      for(auto& l_path : path_list) {
+          l_path_list.push_back(l_path.c_str());
+      }
+      uld::target l_target(EM_ARM, uld::bin_32, true, true);
+      int    l_iterations = 0;
+      int    l_failures = 0;
+      double l_load_time = 0.0;
+      std::vector<std::uint8_t> l_last_stats(sizeof(uld::load_stats_t), 0);
+      bool   l_have_stats = false;
+      uld::image_memory_stats_t l_memory_stats;
+      std::uint32_t l_heap_blocks = 0;
+      auto   l_base = clock_type::now();
+      do {
+          uld::arena_allocator_t l_arena(l_arena_data.data(), l_arena_data.size());
+          uld::image l_image(std::addressof(l_target), arena_size ? std::addressof(l_arena) : nullptr);
+          define_externs(l_image);
+          l_image.set_load_options(options);
+          auto l_load_base = clock_type::now();
+          auto l_heap_base = uld::get_heap_allocator()->get_make_count();
+          if(l_image.load_all(l_path_list.data(), l_path_list.size()) == false) {
+              l_failures++;
+          }
+          l_load_time += get_seconds(l_load_base);
+          l_heap_blocks = uld::get_heap_allocator()->get_make_count() - l_heap_base;
+          if(const uld::load_stats_t*
+              l_stats = l_image.get_load_stats();
+              l_stats != nullptr) {
+              std::memcpy(l_last_stats.data(), l_stats, sizeof(uld::load_stats_t));
+              l_have_stats = true;
+          }
+          l_image.get_memory_stats(l_memory_stats);
+          l_iterations++;
+      }
+      while((get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min)) || (l_iterations < 3));
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"%s\",\"objects\":%d,\"functions\":%d,\"rel_per_function\":%d,\"sections\":%d"
+          ",\"options\":%u,\"iterations\":%d,\"failures\":%d,\"us_per_load\":%.3f",
+          suite,
+          static_cast<int>(path_list.size()),
+          shape.function_count,
+          shape.rel_per_function,
+          shape.section_count,
+          options,
+          l_iterations,
+          l_failures,
+          l_load_time * 1e6 / l_iterations
+      );
+      if(l_have_stats) {
+          put_stats(reinterpret_cast<const uld::load_stats_t*>(l_last_stats.data()), l_iterations);
+      }
+      put_memory(l_memory_stats);
+      std::fprintf(s_out, ",\"heap_blocks\":%u}\n", l_heap_blocks);
+}
+
+/* run_exhaust()
+   fill arenas to their end: make symbols, then strings, in images over a 16 KiB arena until they run out, then load an
+   object over arenas from 4 KiB up to one large enough to hold it; past the end of an arena every allocation has to
+   fail, and the call report it, rather than loop or crash. The errors the image prints are muted.
+*/
+void  run_exhaust(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      constexpr int arena_size_min = 4096;
+      constexpr int make_arena_size = 16384;
+      constexpr int make_count_max = 65536;
+      const char* l_path = path.c_str();
+      uld::target l_target(EM_ARM, uld::bin_32, true, true);
+      int    l_failures = 0;
+      int    l_symbol_count = 0;
+      int    l_string_count = 0;
+      int    l_load_count = 0;
+      int    l_arena_count = 0;
+      std::fflush(stdout);
+      int    l_stdout = dup(STDOUT_FILENO);
+      int    l_null = open("/dev/null", O_WRONLY);
+      if(l_null >= 0) {
+          dup2(l_null, STDOUT_FILENO);
+          close(l_null);
+      }
+      {
+          std::vector<std::uint8_t> l_arena_data(make_arena_size);
+          uld::arena_allocator_t l_arena(l_arena_data.data(), l_arena_data.size());
+          uld::image l_image(std::addressof(l_target), std::addressof(l_arena));
+          while(l_symbol_count < make_count_max) {
+              std::string l_name = "sym_" + std::to_string(l_symbol_count);
+              if(l_image.make_symbol(l_name.c_str(), uld::symbol_t::type_object, uld::symbol_t::bind_global) == nullptr) {
+                  break;
+              }
+              l_symbol_count++;
+          }
+          if(l_symbol_count == make_count_max) {
+              l_failures++;
+          }
+      }
+      {
+          std::vector<std::uint8_t> l_arena_data(make_arena_size);
+          uld::arena_allocator_t l_arena(l_arena_data.data(), l_arena_data.size());
+          uld::image l_image(std::addressof(l_target), std::addressof(l_arena));
+          while(l_string_count < make_count_max) {
+              std::string l_name = "str_" + std::to_string(l_string_count);
+              if(l_image.get_string_table()->make_string(l_name.c_str()) == nullptr) {
+                  break;
+              }
+              l_string_count++;
+          }
+          if(l_string_count == make_count_max) {
+              l_failures++;
+          }
+      }
+      for(int l_arena_size = arena_size_min; l_arena_size <= (1 << 20); l_arena_size *= 4) {
+          std::vector<std::uint8_t> l_arena_data(l_arena_size);
+          uld::arena_allocator_t l_arena(l_arena_data.data(), l_arena_data.size());
+          uld::image l_image(std::addressof(l_target), std::addressof(l_arena));
+          define_externs(l_image);
+          if(l_image.load_all(std::addressof(l_path), 1)) {
+              l_load_count++;
+          } else
+          if(l_arena_size == (1 << 20)) {
+              // as large as the one of the `load_arena` suite, which holds the object
+              l_failures++;
+          }
+          l_arena_count++;
+      }
+      std::fflush(stdout);
+      if(l_stdout >= 0) {
+          dup2(l_stdout, STDOUT_FILENO);
+          close(l_stdout);
+      }
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"exhaust\",\"functions\":%d,\"symbols\":%d,\"strings\":%d,\"arenas\":%d,\"loads\":%d"
+          ",\"failures\":%d}\n",
+          shape.function_count,
+          l_symbol_count,
+          l_string_count,
+          l_arena_count,
+          l_load_count,
+          l_failures
+      );
+}
+
+/* run_plan()
+   time image::plan() over an object, and check its estimates against an actual load of the same object
+*/
+void  run_plan(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      uld::target      l_target(EM_ARM, uld::bin_32, true, true);
+      uld::image       l_image(std::addressof(l_target));
+      uld::load_plan_t l_plan;
+      uld::image_memory_stats_t l_base_stats;
+      uld::image_memory_stats_t l_load_stats;
+      const char* l_path = path.c_str();
+      int    l_iterations = 0;
+      int    l_failures = 0;
+      define_externs(l_image);
+      l_image.get_memory_stats(l_base_stats);
+      auto   l_base = clock_type::now();
+      do {
+          if(l_image.plan(l_path, l_plan) == false) {
+              l_failures++;
+          }
+          l_iterations++;
+      }
+      while((get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min)) || (l_iterations < 3));
+      double l_time = get_seconds(l_base);
+      // the plan must not have touched the image
+      l_image.get_memory_stats(l_load_stats);
+      if(l_load_stats.program_table.used_size != l_base_stats.program_table.used_size) {
+          l_failures++;
+      }
+      if(l_image.load_all(std::addressof(l_path), 1) == false) {
+          l_failures++;
+      }
+      l_image.get_memory_stats(l_load_stats);
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"plan\",\"functions\":%d,\"iterations\":%d,\"failures\":%d,\"us_per_plan\":%.3f"
+          ",\"data_size\":%u,\"loaded_size\":%u,\"symbols\":%u,\"exports\":%u,\"imports\":%u,\"unresolved\":%u"
+          ",\"conflicts\":%u,\"relocations\":%u,\"read_size\":%u",
+          shape.function_count,
+          l_iterations,
+          l_failures,
+          l_time * 1e6 / l_iterations,
+          l_plan.data_size,
+          l_load_stats.program_table.used_size - l_base_stats.program_table.used_size,
+          l_plan.symbol_count,
+          l_plan.export_count,
+          l_plan.import_count,
+          l_plan.unresolved_count,
+          l_plan.conflict_count,
+          l_plan.rel_count,
+          l_plan.read_size
+      );
+      if(const uld::load_stats_t*
+          l_stats = l_image.get_load_stats();
+          l_stats != nullptr) {
+          std::fprintf(s_out, ",\"read_bytes\":%u", l_stats->read_bytes);
+      }
+      std::fprintf(s_out, "}\n");
+}
+
+/* run_store()
+   time symbol_store_t::find_symbol() hits and misses against a store holding the symbols of `image`, and compare the
+   memory held by the store with that of the image symbol and string tables
+*/
+void  run_store(const bench::elfgen_t& shape, uld::image& image, std::vector<std::string>& hit_list, std::vector<std::string>& miss_list) noexcept
+{
+      uld::symbol_store_t       l_store(image.get_program_table());
+      uld::image_memory_stats_t l_image_stats;
+      uld::memory_stats_t       l_store_stats = {};
+      int    l_load_count = l_store.load(*image.get_symbol_table(), uld::symbol_t::bind_any);
+      int    l_failures = l_load_count < 0 ? 1 : 0;
+      image.get_memory_stats(l_image_stats);
+      l_store.get_memory_stats(l_store_stats);
+      // the store has to give back what the table holds
+      for(auto& l_name : hit_list) {
+          uld::symbol_t  l_symbol;
+          uld::symbol_t* l_table_ptr = image.find_symbol(l_name.c_str());
+          if((l_table_ptr == nullptr) ||
+              (l_store.get_symbol(l_store.find_symbol(l_name.c_str()), l_symbol) == false) ||
+              (l_symbol.ea != l_table_ptr->ea) ||
+              (l_symbol.ra != l_table_ptr->ra) ||
+              (l_symbol.size != l_table_ptr->size) ||
+              (l_symbol.type != l_table_ptr->type)) {
+              l_failures++;
+          }
+      }
+      for(int l_pass = 0; l_pass < 2; l_pass++) {
+          auto&  l_name_list = l_pass == 0 ? hit_list : miss_list;
+          long   l_lookups = 0;
+          long   l_found = 0;
+          auto   l_base = clock_type::now();
+          do {
+              for(auto& l_name : l_name_list) {
+                  if(l_store.find_symbol(l_name.c_str()) >= 0) {
+                      l_found++;
+                  }
+              }
+              l_lookups += l_name_list.size();
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          double l_time = get_seconds(l_base);
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"symbol_store\",\"kind\":\"%s\",\"functions\":%d,\"symbols\":%d,\"failures\":%d,\"lookups\":%ld,\"found\":%ld"
+              ",\"ns_per_lookup\":%.3f,\"table_bytes\":%d,\"store_bytes\":%d}\n",
+              l_pass == 0 ? "hit" : "miss",
+              shape.function_count,
+              l_store.get_symbol_count(),
+              l_failures,
+              l_lookups,
+              l_found,
+              l_time * 1e9 / l_lookups,
+              l_image_stats.symbol_table.alloc_size + l_image_stats.string_table.alloc_size,
+              l_store_stats.alloc_size
+          );
+      }
+}
+
+/* run_frozen()
+   freeze `image`, then time image::find_symbol() hits and misses again, and compare the memory held by the symbol table
+   before and after
+*/
+void  run_frozen(const bench::elfgen_t& shape, uld::image& image, std::vector<std::string>& hit_list, std::vector<std::string>& miss_list) noexcept
+{
+      uld::image_memory_stats_t  l_table_stats;
+      uld::image_memory_stats_t  l_frozen_stats;
+      std::vector<std::uint8_t*> l_ea_list;
+      int    l_failures = 0;
+      for(auto& l_name : hit_list) {
+          uld::symbol_t* l_symbol_ptr = image.find_symbol(l_name.c_str());
+          l_ea_list.push_back(l_symbol_ptr != nullptr ? l_symbol_ptr->ea : nullptr);
+      }
+      image.get_memory_stats(l_table_stats);
+      auto   l_freeze_base = clock_type::now();
+      if(image.freeze() == false) {
+          l_failures++;
+      }
+      double l_freeze_time = get_seconds(l_freeze_base);
+      image.get_memory_stats(l_frozen_stats);
+      // the frozen table has to give back what the table held
+      for(std::size_t l_index = 0; l_index < hit_list.size(); l_index++) {
+          uld::symbol_t* l_symbol_ptr = image.find_symbol(hit_list[l_index].c_str());
+          if((l_symbol_ptr == nullptr) ||
+              (l_symbol_ptr->ea != l_ea_list[l_index])) {
+              l_failures++;
+          }
+      }
+      for(int l_pass = 0; l_pass < 2; l_pass++) {
+          auto&  l_name_list = l_pass == 0 ? hit_list : miss_list;
+          long   l_lookups = 0;
+          long   l_found = 0;
+          auto   l_base = clock_type::now();
+          do {
+              for(auto& l_name : l_name_list) {
+                  if(image.find_symbol(l_name.c_str()) != nullptr) {
+                      l_found++;
+                  }
+              }
+              l_lookups += l_name_list.size();
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          double l_time = get_seconds(l_base);
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"frozen\",\"kind\":\"%s\",\"functions\":%d,\"symbols\":%d,\"spilled\":%d,\"failures\":%d"
+              ",\"lookups\":%ld,\"found\":%ld,\"ns_per_lookup\":%.3f,\"us_per_freeze\":%.3f,\"table_bytes\":%d,\"frozen_bytes\":%d}\n",
+              l_pass == 0 ? "hit" : "miss",
+              shape.function_count,
+              image.get_frozen_table()->get_symbol_count(),
+              image.get_frozen_table()->get_spill_count(),
+              l_failures,
+              l_lookups,
+              l_found,
+              l_time * 1e9 / l_lookups,
+              l_freeze_time * 1e6,
+              l_table_stats.symbol_table.alloc_size,
+              l_frozen_stats.symbol_table.alloc_size
+          );
+      }
+}
+
+/* run_find()
+   time image::find_symbol() hits and misses against an image holding the symbols of a single object
+*/
+void  run_find(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      uld::target l_target(EM_ARM, uld::bin_32, true, true);
+      uld::image  l_image(std::addressof(l_target));
+      const char* l_path = path.c_str();
+      define_externs(l_image);
+      if(l_image.load_all(std::addressof(l_path), 1) == false) {
+          std::fprintf(s_out, "{\"suite\":\"find_symbol\",\"functions\":%d,\"failures\":1}\n", shape.function_count);
+          return;
+      }
+      std::vector<std::string> l_hit_list;
+      std::vector<std::string> l_miss_list;
+      for(int l_func = 0; l_func < shape.function_count; l_func++) {
+          l_hit_list.push_back(shape.prefix + std::to_string(l_func));
+          l_miss_list.push_back("missing_" + std::to_string(l_func));
+      }
+      for(int l_pass = 0; l_pass < 2; l_pass++) {
+          auto&  l_name_list = l_pass == 0 ? l_hit_list : l_miss_list;
+          long   l_lookups = 0;
+          long   l_found = 0;
+          auto   l_base = clock_type::now();
+          do {
+              for(auto& l_name : l_name_list) {
+                  if(l_image.find_symbol(l_name.c_str()) != nullptr) {
+                      l_found++;
+                  }
+              }
+              l_lookups += l_name_list.size();
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          double l_time = get_seconds(l_base);
+          // share of the names the filter lets through to the tables: all of the hits, and the false positives among
+          // the misses
+          int    l_filter_pass = 0;
+          for(auto& l_name : l_name_list) {
+              if(l_image.get_symbol_filter()->has_hash(uld::get_name_hash(l_name.c_str()))) {
+                  l_filter_pass++;
+              }
+          }
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"find_symbol\",\"kind\":\"%s\",\"functions\":%d,\"lookups\":%ld,\"found\":%ld,\"ns_per_lookup\":%.3f"
+              ",\"filter_pass\":%.3f}\n",
+              l_pass == 0 ? "hit" : "miss",
+              shape.function_count,
+              l_lookups,
+              l_found,
+              l_time * 1e9 / l_lookups,
+              static_cast<double>(l_filter_pass) / l_name_list.size()
+          );
+      }
+      run_store(shape, l_image, l_hit_list, l_miss_list);
+      run_frozen(shape, l_image, l_hit_list, l_miss_list);
+}
+
+/* run_address()
+   time image::find_symbol_by_address() on an address within each function of the image (`hit`), and on addresses out of
+   the image (`miss`), and check every one of them maps back to its function, before and after freezing the image
+*/
+void  run_address(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      uld::target l_target(EM_ARM, uld::bin_32, true, true);
+      uld::image  l_image(std::addressof(l_target));
+      const char* l_path = path.c_str();
+      define_externs(l_image);
+      if(l_image.load_all(std::addressof(l_path), 1) == false) {
+          std::fprintf(s_out, "{\"suite\":\"address\",\"functions\":%d,\"failures\":1}\n", shape.function_count);
+          return;
+      }
+      std::vector<std::string>   l_name_list;
+      std::vector<const void*>   l_hit_list;
+      std::vector<const void*>   l_miss_list;
+      for(int l_func = 0; l_func < shape.function_count; l_func++) {
+          uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + std::to_string(l_func)).c_str());
+          if(l_symbol_ptr != nullptr) {
+              l_name_list.push_back(l_symbol_ptr->name);
+              l_hit_list.push_back(l_symbol_ptr->ea + l_symbol_ptr->size / 2);
+          }
+          l_miss_list.push_back(s_extern_data + l_func % sizeof(s_extern_data));
+      }
+      for(int l_state = 0; l_state < 2; l_state++) {
+          int  l_failures = 0;
+          if(l_state == 1) {
+              if(l_image.freeze() == false) {
+                  l_failures++;
+              }
+          }
+          for(std::size_t l_index = 0; l_index < l_hit_list.size(); l_index++) {
+              uld::symbol_t* l_symbol_ptr = l_image.find_symbol_by_address(l_hit_list[l_index]);
+              if((l_symbol_ptr == nullptr) ||
+                  (l_name_list[l_index] != l_symbol_ptr->name)) {
+                  l_failures++;
+              }
+          }
+          for(int l_pass = 0; l_pass < 2; l_pass++) {
+              auto&  l_address_list = l_pass == 0 ? l_hit_list : l_miss_list;
+              long   l_lookups = 0;
+              long   l_found = 0;
+              auto   l_base = clock_type::now();
+              do {
+                  for(const void* l_address : l_address_list) {
+                      if(l_image.find_symbol_by_address(l_address) != nullptr) {
+                          l_found++;
+                      }
+                  }
+                  l_lookups += l_address_list.size();
+              }
+              while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+              uld::memory_stats_t l_index_stats{};
+              l_image.get_address_index()->get_memory_stats(l_index_stats);
+              std::fprintf(
+                  s_out,
+                  "{\"suite\":\"address\",\"kind\":\"%s\",\"frozen\":%s,\"functions\":%d,\"entries\":%d,\"failures\":%d"
+                  ",\"lookups\":%ld,\"found\":%ld,\"ns_per_lookup\":%.3f,\"index_bytes\":%d}\n",
+                  l_pass == 0 ? "hit" : "miss",
+                  l_state == 1 ? "true" : "false",
+                  shape.function_count,
+                  l_image.get_address_index()->get_symbol_count(),
+                  l_failures,
+                  l_lookups,
+                  l_found,
+                  get_seconds(l_base) * 1e9 / l_lookups,
+                  l_index_stats.alloc_size
+              );
+          }
+      }
+}
+
+/* run_profile()
+   feed the profiler samples within the functions of an image, weighted by function, and time sampling and attribution,
+   checking the histogram and its dump against the weights (`synthetic`); then sample the benchmark itself from the
+   profiling timer (`timer`), all of which the image attributes to `other`
+*/
+void  run_profile(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      uld::target l_target(EM_ARM, uld::bin_32, true, true);
+      uld::image  l_image(std::addressof(l_target));
+      const char* l_path = path.c_str();
+      define_externs(l_image);
+      if(l_image.load_all(std::addressof(l_path), 1) == false) {
+          std::fprintf(s_out, "{\"suite\":\"profile\",\"functions\":%d,\"failures\":1}\n", shape.function_count);
+          return;
+      }
+      // sample address list: the middle of each function, function n being hit (n % 4) + 1 times per round
+      std::vector<const void*> l_sample_list;
+      for(int l_func = 0; l_func < shape.function_count; l_func++) {
+          uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + std::to_string(l_func)).c_str());
+          if(l_symbol_ptr != nullptr) {
+              for(int l_hit = 0; l_hit <= l_func % 4; l_hit++) {
+                  l_sample_list.push_back(l_symbol_ptr->ea + l_symbol_ptr->size / 2);
+              }
+          }
+      }
+      uld::profiler_t l_profiler(std::addressof(l_image), 1024);
+      int    l_failures = 0;
+      long   l_rounds = 0;
+      double l_put_time = 0;
+      double l_drain_time = 0;
+      do {
+          for(std::size_t l_offset = 0; l_offset < l_sample_list.size(); l_offset += 1024) {
+              std::size_t l_count = std::min<std::size_t>(1024, l_sample_list.size() - l_offset);
+              auto l_put_base = clock_type::now();
+              for(std::size_t l_index = 0; l_index < l_count; l_index++) {
+                  l_profiler.put_sample(l_sample_list[l_offset + l_index]);
+              }
+              l_put_time += get_seconds(l_put_base);
+              auto l_drain_base = clock_type::now();
+              l_profiler.drain();
+              l_drain_time += get_seconds(l_drain_base);
+          }
+          l_rounds++;
+      }
+      while(l_put_time + l_drain_time < (s_quick ? s_time_min / 4 : s_time_min));
+      std::vector<uld::profile_bucket_t> l_bucket_list(l_profiler.get_bucket_count());
+      int    l_bucket_count = l_profiler.get_histogram(l_bucket_list.data(), l_bucket_list.size());
+      if((l_bucket_count != shape.function_count) ||
+          (l_profiler.get_drop_count() != 0) ||
+          (l_profiler.get_other_count() != 0)) {
+          l_failures++;
+      }
+      for(int l_index = 0; l_index < l_bucket_count; l_index++) {
+          int l_func = std::atoi(l_bucket_list[l_index].name + shape.prefix.size());
+          if(l_bucket_list[l_index].count != l_rounds * (l_func % 4 + 1)) {
+              l_failures++;
+          }
+          if((l_index > 0) &&
+              (l_bucket_list[l_index].count > l_bucket_list[l_index - 1].count)) {
+              l_failures++;
+          }
+      }
+      std::vector<std::uint8_t> l_dump(l_profiler.get_dump_size());
+      if((l_profiler.dump(l_dump.data(), l_dump.size()) != static_cast<int>(l_dump.size())) ||
+          (std::memcmp(l_dump.data(), "ULDP", 4) != 0)) {
+          l_failures++;
+      }
+      long   l_samples = l_rounds * l_sample_list.size();
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"profile\",\"kind\":\"synthetic\",\"functions\":%d,\"failures\":%d,\"samples\":%ld"
+          ",\"ns_per_sample\":%.3f,\"ns_per_drain\":%.3f,\"buckets\":%d,\"dump_bytes\":%d}\n",
+          shape.function_count,
+          l_failures,
+          l_samples,
+          l_put_time * 1e9 / l_samples,
+          l_drain_time * 1e9 / l_samples,
+          l_bucket_count,
+          static_cast<int>(l_dump.size())
+      );
+      // the profiling timer, sampling the benchmark every millisecond of CPU time
+      volatile std::uint32_t l_spin = 0;
+      l_failures = 0;
+      l_profiler.clear();
+      if(l_profiler.start(1000) == false) {
+          l_failures++;
+      }
+      auto   l_base = clock_type::now();
+      while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min)) {
+          for(int l_iteration = 0; l_iteration < 100000; l_iteration++) {
+              l_spin = l_spin + l_iteration;
+          }
+          l_profiler.drain();
+      }
+      l_profiler.stop();
+      l_profiler.drain();
+      if((l_profiler.get_sample_count() == 0) ||
+          (l_profiler.get_other_count() != l_profiler.get_sample_count())) {
+          l_failures++;
+      }
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"profile\",\"kind\":\"timer\",\"functions\":%d,\"failures\":%d,\"samples\":%u"
+          ",\"dropped\":%u,\"other\":%u,\"seconds\":%.3f}\n",
+          shape.function_count,
+          l_failures,
+          l_profiler.get_sample_count(),
+          l_profiler.get_drop_count(),
+          l_profiler.get_other_count(),
+          get_seconds(l_base)
+      );
+}
+
+/* run_probes()
+   cost of the counting trampolines: time of a load with every other function probed, against that of a plain load, and
+   time of the probe_enter() and probe_leave() halves of a probed call, nested two deep, checking the counts and the
+   return addresses they hand back
+*/
+void  run_probes(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      const char* l_path = path.c_str();
+      uld::target l_target(EM_ARM, uld::bin_32, true, true);
+      int    l_failures = 0;
+      long   l_site_count = 0;
+      double l_load_time[2] = {0, 0};
+      for(int l_kind = 0; l_kind < 2; l_kind++) {
+          long l_loads = 0;
+          auto l_base = clock_type::now();
+          do {
+              uld::image l_image(std::addressof(l_target));
+              define_externs(l_image);
+              if(l_kind == 1) {
+                  for(int l_func = 0; l_func < shape.function_count; l_func += 2) {
+                      if(l_image.make_probe((shape.prefix + std::to_string(l_func)).c_str()) == nullptr) {
+                          l_failures++;
+                      }
+                  }
+              }
+              if(l_image.load_all(std::addressof(l_path), 1) == false) {
+                  l_failures++;
+              }
+              if(l_kind == 1) {
+                  l_site_count = 0;
+                  for(uld::probe_t& l_probe : *l_image.get_probe_table()) {
+                      if(l_probe.site_count > 0) {
+                          if(l_probe.body != l_image.find_symbol(l_probe.name)->ra) {
+                              l_failures++;
+                          }
+                      }
+                      l_site_count += l_probe.site_count;
+                  }
+              }
+              l_loads++;
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          l_load_time[l_kind] = get_seconds(l_base) / l_loads;
+      }
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"probes\",\"kind\":\"load\",\"functions\":%d,\"probed\":%d,\"failures\":%d,\"sites\":%ld"
+          ",\"us_per_load\":%.3f,\"us_per_probed_load\":%.3f}\n",
+          shape.function_count,
+          (shape.function_count + 1) / 2,
+          l_failures,
+          l_site_count,
+          l_load_time[0] * 1e6,
+          l_load_time[1] * 1e6
+      );
+      // the calls themselves, as the trampolines and the exit thunk would make them
+      uld::probe_table_t l_probe_table;
+      uld::probe_t* l_outer_ptr = l_probe_table.make_probe("outer");
+      uld::probe_t* l_inner_ptr = l_probe_table.make_probe("inner");
+      std::uint8_t  l_return_address[2];
+      long   l_calls = 0;
+      l_failures = 0;
+      auto   l_base = clock_type::now();
+      do {
+          for(int l_call = 0; l_call < 1024; l_call++) {
+              uld::probe_enter(l_outer_ptr, l_return_address + 0);
+              uld::probe_enter(l_inner_ptr, l_return_address + 1);
+              if(uld::probe_leave() != l_return_address + 1) {
+                  l_failures++;
+              }
+              if(uld::probe_leave() != l_return_address + 0) {
+                  l_failures++;
+              }
+          }
+          l_calls += 2048;
+      }
+      while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+      double l_time = get_seconds(l_base);
+      if((l_outer_ptr->call_count + l_inner_ptr->call_count != l_calls) ||
+          (l_outer_ptr->time < l_inner_ptr->time)) {
+          l_failures++;
+      }
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"probes\",\"kind\":\"call\",\"failures\":%d,\"calls\":%ld,\"ns_per_call\":%.3f}\n",
+          l_failures,
+          l_calls,
+          l_time * 1e9 / l_calls
+      );
+}
+
+/* run_placement()
+   code placement from a profile listing every eighth function, hottest last, and chaining them by calls, against the
+   plain load: time of the loads, and span of the code segment the hot functions occupy (`hot_span`) and 4 KiB pages they
+   touch; the placed functions have to follow the order of the profile
+*/
+void  run_placement(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      static const char* s_kind_name[] = {"plain", "placed"};
+      const char*  l_path = path.c_str();
+      uld::target  l_target(EM_ARM, uld::bin_32, true, true);
+      uld::placement_t l_placement;
+      int    l_hot_count = 0;
+      for(int l_func = shape.function_count - 1; l_func >= 0; l_func--) {
+          if(l_func % 8 == 0) {
+              l_placement.add_function((shape.prefix + std::to_string(l_func)).c_str());
+              l_hot_count++;
+          }
+      }
+      for(int l_func = 0; l_func + 8 < shape.function_count; l_func += 8) {
+          l_placement.add_edge(
+              (shape.prefix + std::to_string(l_func)).c_str(),
+              (shape.prefix + std::to_string(l_func + 8)).c_str(),
+              shape.function_count - l_func
+          );
+      }
+      l_placement.update();
+      for(int l_kind = 0; l_kind < 2; l_kind++) {
+          int    l_failures = 0;
+          long   l_loads = 0;
+          long   l_hot_span = 0;
+          long   l_hot_pages = 0;
+          auto   l_base = clock_type::now();
+          do {
+              uld::image l_image(std::addressof(l_target));
+              define_externs(l_image);
+              if(l_kind == 1) {
+                  l_image.set_placement(std::addressof(l_placement));
+              }
+              if(l_image.load_all(std::addressof(l_path), 1) == false) {
+                  l_failures++;
+                  break;
+              }
+              if(l_loads == 0) {
+                  std::uint8_t* l_last_ptr = nullptr;
+                  std::uintptr_t l_span_base = UINTPTR_MAX;
+                  std::uintptr_t l_span_last = 0;
+                  std::vector<std::uintptr_t> l_page_list;
+                  for(int l_rank = 0; l_rank < l_placement.get_function_count(); l_rank++) {
+                      uld::symbol_t* l_symbol_ptr = l_image.find_symbol(l_placement.get_function(l_rank));
+                      if((l_symbol_ptr == nullptr) ||
+                          (l_symbol_ptr->ea == nullptr)) {
+                          l_failures++;
+                          continue;
+                      }
+                      if(l_kind == 1) {
+                          if(l_symbol_ptr->ea < l_last_ptr) {
+                              l_failures++;
+                          }
+                      }
+                      l_last_ptr = l_symbol_ptr->ea;
+                      l_span_base = std::min(l_span_base, reinterpret_cast<std::uintptr_t>(l_symbol_ptr->ea));
+                      l_span_last = std::max(l_span_last, reinterpret_cast<std::uintptr_t>(l_symbol_ptr->ea + l_symbol_ptr->size));
+                      for(std::uintptr_t l_page = reinterpret_cast<std::uintptr_t>(l_symbol_ptr->ea) >> 12;
+                          l_page <= (reinterpret_cast<std::uintptr_t>(l_symbol_ptr->ea + l_symbol_ptr->size) - 1) >> 12;
+                          l_page++) {
+                          if(std::find(l_page_list.begin(), l_page_list.end(), l_page) == l_page_list.end()) {
+                              l_page_list.push_back(l_page);
+                          }
+                      }
+                  }
+                  l_hot_span = l_span_last > l_span_base ? l_span_last - l_span_base : 0;
+                  l_hot_pages = l_page_list.size();
+              }
+              l_loads++;
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"placement\",\"kind\":\"%s\",\"functions\":%d,\"hot\":%d,\"failures\":%d,\"hot_span\":%ld"
+              ",\"hot_pages\":%ld,\"us_per_load\":%.3f}\n",
+              s_kind_name[l_kind],
+              shape.function_count,
+              l_hot_count,
+              l_failures,
+              l_hot_span,
+              l_hot_pages,
+              l_loads > 0 ? get_seconds(l_base) * 1e6 / l_loads : 0.0
+          );
+      }
+}
+
+/* run_regions()
+   region placement rules over simulated memories: the first code section of the object goes to a scratch bank, and the
+   writable data to a SRAM bank, both static arrays; time of the load against the plain one, and check that each
+   function and object lands in the region its section maps to
+*/
+void  run_regions(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      static const char* s_kind_name[] = {"plain", "regions"};
+      alignas(16) static std::uint8_t s_scratch_bank[64 * 1024];
+      alignas(16) static std::uint8_t s_sram_bank[64 * 1024];
+      const char*  l_path = path.c_str();
+      for(int l_kind = 0; l_kind < 2; l_kind++) {
+          int    l_failures = 0;
+          long   l_loads = 0;
+          int    l_scratch_count = 0;
+          int    l_sram_count = 0;
+          auto   l_base = clock_type::now();
+          do {
+              uld::target l_target(EM_ARM, uld::bin_32, true, true);
+              if(l_kind == 1) {
+                  l_target.add_region("scratch_x", s_scratch_bank, sizeof(s_scratch_bank), uld::target::region_rwx);
+                  l_target.add_region("sram_a", s_sram_bank, sizeof(s_sram_bank), uld::target::region_rwx);
+              }
+              uld::image  l_image(std::addressof(l_target));
+              if(l_kind == 1) {
+                  uld::program_table_t* l_program_ptr = l_image.get_program_table();
+                  if((l_program_ptr->add_region_rule(".text.0", 0, 0, "scratch_x") == false) ||
+                      (l_program_ptr->add_region_rule(nullptr, uld::section_t::data_write, uld::section_t::data_write, "sram_a") == false)) {
+                      l_failures++;
+                  }
+              }
+              define_externs(l_image);
+              if(l_image.load_all(std::addressof(l_path), 1) == false) {
+                  l_failures++;
+                  break;
+              }
+              if(l_loads == 0) {
+                  for(int l_func = 0; l_func < shape.function_count; l_func++) {
+                      uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + std::to_string(l_func)).c_str());
+                      if(l_symbol_ptr == nullptr) {
+                          l_failures++;
+                          continue;
+                      }
+                      const uld::region_t* l_region_ptr = l_target.get_region_by_address(l_symbol_ptr->ea);
+                      bool l_scratch = (l_kind == 1) && (l_func % std::max(shape.section_count, 1) == 0);
+                      if(l_scratch) {
+                          if((l_region_ptr == nullptr) ||
+                              (std::strcmp(l_region_ptr->name, "scratch_x") != 0)) {
+                              l_failures++;
+                          }
+                          l_scratch_count++;
+                      } else
+                      if(l_region_ptr != nullptr) {
+                          l_failures++;
+                      }
+                  }
+                  for(int l_object = 0; l_object < shape.object_count; l_object++) {
+                      uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + "_data" + std::to_string(l_object)).c_str());
+                      if(l_symbol_ptr == nullptr) {
+                          continue;
+                      }
+                      const uld::region_t* l_region_ptr = l_target.get_region_by_address(l_symbol_ptr->ea);
+                      if((l_kind == 1) != (l_region_ptr != nullptr)) {
+                          l_failures++;
+                      }
+                      if(l_region_ptr != nullptr) {
+                          l_sram_count++;
+                      }
+                  }
+              }
+              l_loads++;
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"regions\",\"kind\":\"%s\",\"functions\":%d,\"sections\":%d,\"failures\":%d,\"in_scratch\":%d"
+              ",\"in_sram\":%d,\"us_per_load\":%.3f}\n",
+              s_kind_name[l_kind],
+              shape.function_count,
+              shape.section_count,
+              l_failures,
+              l_scratch_count,
+              l_sram_count,
+              l_loads > 0 ? get_seconds(l_base) * 1e6 / l_loads : 0.0
+          );
+      }
+}
+
+/* run_segments()
+   segment rules: sections `.text.3` then `.text.1` go to a `.text.hot` segment, in the order of their rules, and the
+   object data to a `.data.tables` one; checks where the functions and objects land, and times the load against the
+   plain one; then times get_segment_by_name() on the names of `count` extra segments (`hit`) and on other names
+   (`miss`)
+*/
+void  run_segments(const bench::elfgen_t& shape, const std::string& path, int count) noexcept
+{
+      static const char* s_kind_name[] = {"plain", "rules"};
+      const char*  l_path = path.c_str();
+      uld::target  l_target(EM_ARM, uld::bin_32, true, true);
+      for(int l_kind = 0; l_kind < 2; l_kind++) {
+          int    l_failures = 0;
+          long   l_loads = 0;
+          auto   l_base = clock_type::now();
+          do {
+              uld::image l_image(std::addressof(l_target));
+              uld::program_table_t* l_program_ptr = l_image.get_program_table();
+              if(l_kind == 1) {
+                  if((l_program_ptr->make_segment(".text.hot", uld::section_t::type_progbits, uld::section_t::data_alloc | uld::section_t::data_execute, 4) == nullptr) ||
+                      (l_program_ptr->make_segment(".data.tables", uld::section_t::type_progbits, uld::section_t::data_alloc | uld::section_t::data_write, 4) == nullptr) ||
+                      (l_program_ptr->add_segment_rule(".text.3", 0, 0, ".text.hot") == false) ||
+                      (l_program_ptr->add_segment_rule(".text.1", 0, 0, ".text.hot") == false) ||
+                      (l_program_ptr->add_segment_rule(".data*", 0, 0, ".data.tables") == false)) {
+                      l_failures++;
+                  }
+              }
+              define_externs(l_image);
+              if(l_image.load_all(std::addressof(l_path), 1) == false) {
+                  l_failures++;
+                  break;
+              }
+              if((l_loads == 0) &&
+                  (l_kind == 1)) {
+                  uld::segment* l_hot_ptr = l_program_ptr->get_segment_by_name(".text.hot");
+                  uld::segment* l_data_ptr = l_program_ptr->get_segment_by_name(".data.tables");
+                  std::uint8_t* l_last_ptr = nullptr;
+                  for(int l_func = 0; l_func < shape.function_count; l_func++) {
+                      uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + std::to_string(l_func)).c_str());
+                      if(l_symbol_ptr == nullptr) {
+                          l_failures++;
+                          continue;
+                      }
+                      int  l_section = l_func % shape.section_count;
+                      bool l_hot = (l_section == 1) || (l_section == 3);
+                      if(l_hot != (l_hot_ptr->get_table_offset(l_symbol_ptr->ea) >= 0)) {
+                          l_failures++;
+                      }
+                      // the whole of `.text.3` comes before `.text.1`
+                      if(l_section == 3) {
+                          l_last_ptr = std::max(l_last_ptr, l_symbol_ptr->ea);
+                      }
+                  }
+                  for(int l_func = 1; l_func < shape.function_count; l_func += shape.section_count) {
+                      uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + std::to_string(l_func)).c_str());
+                      if((l_symbol_ptr != nullptr) &&
+                          (l_symbol_ptr->ea < l_last_ptr)) {
+                          l_failures++;
+                      }
+                  }
+                  for(int l_object = 0; l_object < shape.object_count; l_object++) {
+                      uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + "_data" + std::to_string(l_object)).c_str());
+                      if((l_symbol_ptr == nullptr) ||
+                          (l_data_ptr->get_table_offset(l_symbol_ptr->ea) < 0)) {
+                          l_failures++;
+                      }
+                  }
+              }
+              l_loads++;
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"segments\",\"kind\":\"%s\",\"functions\":%d,\"sections\":%d,\"failures\":%d,\"us_per_load\":%.3f}\n",
+              s_kind_name[l_kind],
+              shape.function_count,
+              shape.section_count,
+              l_failures,
+              l_loads > 0 ? get_seconds(l_base) * 1e6 / l_loads : 0.0
+          );
+      }
+      // lookups by name, past the default segments
+      uld::image l_image(std::addressof(l_target));
+      uld::program_table_t* l_program_ptr = l_image.get_program_table();
+      std::vector<std::string> l_hit_list;
+      std::vector<std::string> l_miss_list;
+      int  l_failures = 0;
+      for(int l_segment = 0; l_segment < count; l_segment++) {
+          l_hit_list.push_back(".seg." + std::to_string(l_segment));
+          l_miss_list.push_back(".none." + std::to_string(l_segment));
+          if(l_program_ptr->make_segment(l_hit_list.back().c_str(), uld::section_t::type_progbits, uld::section_t::data_alloc | uld::section_t::data_write) == nullptr) {
+              l_failures++;
+          }
+      }
+      for(const std::string& l_name : l_hit_list) {
+          uld::segment* l_segment_ptr = l_program_ptr->get_segment_by_name(l_name.c_str());
+          if((l_segment_ptr == nullptr) ||
+              (l_name != l_segment_ptr->get_name())) {
+              l_failures++;
+          }
+      }
+      for(int l_pass = 0; l_pass < 2; l_pass++) {
+          auto&  l_name_list = l_pass == 0 ? l_hit_list : l_miss_list;
+          long   l_lookups = 0;
+          long   l_found = 0;
+          auto   l_base = clock_type::now();
+          do {
+              for(const std::string& l_name : l_name_list) {
+                  if(l_program_ptr->get_segment_by_name(l_name.c_str()) != nullptr) {
+                      l_found++;
+                  }
+              }
+              l_lookups += l_name_list.size();
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"segments\",\"kind\":\"%s\",\"segments\":%d,\"failures\":%d,\"lookups\":%ld,\"found\":%ld"
+              ",\"ns_per_lookup\":%.3f}\n",
+              l_pass == 0 ? "hit" : "miss",
+              l_program_ptr->get_segment_count(),
+              l_failures,
+              l_lookups,
+              l_found,
+              get_seconds(l_base) * 1e9 / l_lookups
+          );
+      }
+}
+
+/* run_align()
+   data sections of mixed alignments (see `bench::elfgen_get_buffer_align()`): checks that each buffer lands at the
+   alignment of its section, with its contents, and reports the padding the load took and the bytes it saved over
+   rounding every section to the alignment of its segment
+*/
+void  run_align(const bench::elfgen_t& shape, const std::string& path) noexcept
+{
+      const char*  l_path = path.c_str();
+      uld::target  l_target(EM_ARM, uld::bin_32, true, true);
+      const uld::load_stats_t* l_stats = nullptr;
+      int    l_failures = 0;
+      int    l_data_size = 0;
+      int    l_pad_size = 0;
+      int    l_saved_size = 0;
+      long   l_loads = 0;
+      auto   l_base = clock_type::now();
+      do {
+          uld::image l_image(std::addressof(l_target));
+          define_externs(l_image);
+          if(l_image.load_all(std::addressof(l_path), 1) == false) {
+              l_failures++;
+              break;
+          }
+          if(l_loads == 0) {
+              for(int l_buffer = 0; l_buffer < shape.buffer_count; l_buffer++) {
+                  uld::symbol_t* l_symbol_ptr = l_image.find_symbol((shape.prefix + "_buf" + std::to_string(l_buffer)).c_str());
+                  int  l_align = bench::elfgen_get_buffer_align(l_buffer);
+                  int  l_size = bench::elfgen_get_buffer_size(l_buffer);
+                  if((l_symbol_ptr == nullptr) ||
+                      (reinterpret_cast<std::uintptr_t>(l_symbol_ptr->ea) % l_align != 0)) {
+                      l_failures++;
+                      continue;
+                  }
+                  std::uint8_t l_fill = l_buffer % 2 ? 0 : l_buffer & 0xff;
+                  for(int l_byte = 0; l_byte < l_size; l_byte++) {
+                      if(l_symbol_ptr->ea[l_byte] != l_fill) {
+                          l_failures++;
+                          break;
+                      }
+                  }
+                  l_data_size += l_size;
+              }
+          }
+          l_stats = l_image.get_load_stats();
+          if(l_stats != nullptr) {
+              l_pad_size = l_stats->align_pad_size;
+              l_saved_size = l_stats->align_saved_size;
+          }
+          l_loads++;
+      }
+      while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"align\",\"buffers\":%d,\"failures\":%d,\"data_size\":%d,\"pad_size\":%d,\"saved_size\":%d"
+          ",\"us_per_load\":%.3f}\n",
+          shape.buffer_count,
+          l_failures,
+          l_data_size,
+          l_pad_size,
+          l_saved_size,
+          l_loads > 0 ? get_seconds(l_base) * 1e6 / l_loads : 0.0
+      );
+}
+
+/* run_scopes()
+   plugin images sharing a base image through set_parent(): memory of a plugin linked against the base, against that of
+   an image holding its own copy of the base (`copy`), and time of the lookups of the base names through the plugin, and
+   of missing names, with and without the miss cache (`child_cache`)
+*/
+void  run_scopes(const bench::elfgen_t& shape, const std::string& base_path, const std::string& plugin_path) noexcept
+{
+      static const char* s_kind_name[] = {"copy", "child", "child_cache"};
+      const char*  l_base_path = base_path.c_str();
+      const char*  l_plugin_path = plugin_path.c_str();
+      uld::target  l_target(EM_ARM, uld::bin_32, true, true);
+      uld::image   l_base(std::addressof(l_target));
+      define_externs(l_base);
+      if(l_base.load_all(std::addressof(l_base_path), 1) == false) {
+          std::fprintf(s_out, "{\"suite\":\"scopes\",\"functions\":%d,\"failures\":1}\n", shape.function_count);
+          return;
+      }
+      std::vector<std::string> l_hit_list;
+      std::vector<std::string> l_miss_list;
+      for(int l_func = 0; l_func < shape.function_count; l_func++) {
+          l_hit_list.push_back(shape.prefix + std::to_string(l_func));
+          l_miss_list.push_back("missing_" + std::to_string(l_func));
+      }
+      for(int l_kind = 0; l_kind < 3; l_kind++) {
+          uld::image l_image(std::addressof(l_target), nullptr, nullptr, l_kind > 0 ? std::addressof(l_base) : nullptr);
+          int  l_failures = 0;
+          if(l_kind == 0) {
+              define_externs(l_image);
+              if(l_image.load_all(std::addressof(l_base_path), 1) == false) {
+                  l_failures++;
+              }
+          }
+          if(l_kind == 2) {
+              l_image.set_miss_cache_size(256);
+          }
+          if(l_image.load_all(std::addressof(l_plugin_path), 1) == false) {
+              l_failures++;
+          }
+          uld::image_memory_stats_t l_memory_stats;
+          l_image.get_memory_stats(l_memory_stats);
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"scopes\",\"kind\":\"%s\",\"functions\":%d,\"failures\":%d",
+              s_kind_name[l_kind],
+              shape.function_count,
+              l_failures
+          );
+          for(int l_pass = 0; l_pass < 2; l_pass++) {
+              auto&  l_name_list = l_pass == 0 ? l_hit_list : l_miss_list;
+              long   l_lookups = 0;
+              long   l_found = 0;
+              auto   l_base_time = clock_type::now();
+              do {
+                  for(auto& l_name : l_name_list) {
+                      if(l_image.find_symbol(l_name.c_str()) != nullptr) {
+                          l_found++;
+                      }
+                  }
+                  l_lookups += l_name_list.size();
+              }
+              while(get_seconds(l_base_time) < (s_quick ? s_time_min / 4 : s_time_min));
+              std::fprintf(
+                  s_out,
+                  ",\"%s_found\":%ld,\"%s_ns_per_lookup\":%.3f",
+                  l_pass == 0 ? "hit" : "miss",
+                  l_found,
+                  l_pass == 0 ? "hit" : "miss",
+                  get_seconds(l_base_time) * 1e9 / l_lookups
+              );
+          }
+          put_memory(l_memory_stats);
+          std::fprintf(s_out, "}\n");
+      }
+}
+
+bool  is_export_less(const uld::export_t& lhs, const uld::export_t& rhs) noexcept
+{
+      return lhs.hash < rhs.hash;
+}
+
+/* run_exports()
+   compare `export_count` firmware exports registered with the image one by one at startup (`register`) against the
+   same exports in an export table (`table`), and the `ext_<n>` host symbols registered against the export table linked
+   into the benchmark (`default`): time to set an image up and load an object referencing some of them, image memory
+   once loaded, and lookup time of the exports
+*/
+void  run_exports(int export_count, const std::string& path) noexcept
+{
+      std::vector<std::string>   l_name_list;
+      std::vector<uld::export_t> l_export_list;
+      for(int l_export = 0; l_export < export_count; l_export++) {
+          l_name_list.push_back("fw_" + std::to_string(l_export));
+      }
+      for(int l_ext = 0; l_ext < s_extern_count; l_ext++) {
+          l_name_list.push_back("ext_" + std::to_string(l_ext));
+      }
+      for(int l_export = 0; l_export < static_cast<int>(l_name_list.size()); l_export++) {
+          bool          l_ext = l_export >= export_count;
+          std::uint16_t l_type = l_ext ? uld::symbol_t::type_object : uld::symbol_t::type_function;
+          l_export_list.push_back(
+              uld::export_t{
+                  l_name_list[l_export].c_str(),
+                  uld::get_name_hash(l_name_list[l_export].c_str()),
+                  l_type,
+                  uld::symbol_t::bind_global,
+                  l_ext ? s_extern_data + (l_export - export_count) * 4 : s_extern_data
+              }
+          );
+      }
+      std::sort(l_export_list.begin(), l_export_list.end(), is_export_less);
+      uld::export_table_t l_export_table(l_export_list.data(), l_export_list.size());
+
+      static const char* s_kind_name[] = {"register", "table", "default"};
+      const char*  l_path = path.c_str();
+      uld::target  l_target(EM_ARM, uld::bin_32, true, true);
+      for(int l_kind = 0; l_kind < 3; l_kind++) {
+          int    l_iterations = 0;
+          int    l_failures = 0;
+          double l_setup_time = 0.0;
+          double l_load_time = 0.0;
+          auto   l_base = clock_type::now();
+          do {
+              uld::image l_image(std::addressof(l_target));
+              auto l_setup_base = clock_type::now();
+              if(l_kind == 0) {
+                  l_image.set_export_table(nullptr);
+                  for(auto& l_export : l_export_list) {
+                      l_image.make_symbol(l_export.name, l_export.type, l_export.flags, const_cast<void*>(l_export.address));
+                  }
+              } else
+              if(l_kind == 1) {
+                  l_image.set_export_table(std::addressof(l_export_table));
+              }
+              l_setup_time += get_seconds(l_setup_base);
+              auto l_load_base = clock_type::now();
+              if(l_image.load_all(std::addressof(l_path), 1) == false) {
+                  l_failures++;
+              }
+              l_load_time += get_seconds(l_load_base);
+              l_iterations++;
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+
+          // lookups and memory, on an image of their own
+          uld::image l_image(std::addressof(l_target));
+          if(l_kind == 0) {
+              l_image.set_export_table(nullptr);
+              for(auto& l_export : l_export_list) {
+                  l_image.make_symbol(l_export.name, l_export.type, l_export.flags, const_cast<void*>(l_export.address));
+              }
+          } else
+          if(l_kind == 1) {
+              l_image.set_export_table(std::addressof(l_export_table));
+          }
+          if(l_image.load_all(std::addressof(l_path), 1) == false) {
+              l_failures++;
+          }
+          uld::image_memory_stats_t l_memory_stats;
+          l_image.get_memory_stats(l_memory_stats);
+          int  l_first = l_kind == 2 ? export_count : 0;
+          long l_lookups = 0;
+          long l_found = 0;
+          l_base = clock_type::now();
+          do {
+              for(int i_name = l_first; i_name < static_cast<int>(l_name_list.size()); i_name++) {
+                  if(l_image.find_symbol(l_name_list[i_name].c_str()) != nullptr) {
+                      l_found++;
+                  }
+              }
+              l_lookups += l_name_list.size() - l_first;
+          }
+          while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+          double l_lookup_time = get_seconds(l_base);
+          std::fprintf(
+              s_out,
+              "{\"suite\":\"exports\",\"kind\":\"%s\",\"exports\":%d,\"iterations\":%d,\"failures\":%d"
+              ",\"setup_us\":%.3f,\"load_us\":%.3f,\"lookups\":%ld,\"found\":%ld,\"ns_per_lookup\":%.3f",
+              s_kind_name[l_kind],
+              l_kind == 2 ? s_extern_count : static_cast<int>(l_export_list.size()),
+              l_iterations,
+              l_failures,
+              l_setup_time * 1e6 / l_iterations,
+              l_load_time * 1e6 / l_iterations,
+              l_lookups,
+              l_found,
+              l_lookup_time * 1e9 / l_lookups
+          );
+          put_memory(l_memory_stats);
+          std::fprintf(s_out, "}\n");
+      }
+}
+
+void  put_storage(const bench::storage_stats_t& stats) noexcept
+{
+      std::fprintf(
+          s_out,
+          ",\"storage_us\":%.1f,\"file_reads\":%ld,\"file_seeks\":%ld,\"commands\":%ld,\"device_seeks\":%ld"
+          ",\"sectors\":%ld,\"bytes\":%ld",
+          stats.time_us,
+          stats.call_count,
+          stats.lseek_count,
+          stats.command_count,
+          stats.seek_count,
+          stats.sector_count,
+          stats.byte_count
+      );
+}
+
+/* run_replay()
+   replay recorded file accesses against every storage model and data cache size
+*/
+void  run_replay(const char* sample, const bench::io_log_t& log) noexcept
+{
+      for(auto l_model : s_storage_model_list) {
+          for(int l_reserve_size : s_reserve_list) {
+              bench::storage_reset(*l_model);
+              bool l_success = bench::io_replay(log, l_reserve_size);
+              std::fprintf(
+                  s_out,
+                  "{\"suite\":\"storage\",\"sample\":\"%s\",\"model\":\"%s\",\"reserve\":%d,\"events\":%d,\"failures\":%d",
+                  sample,
+                  l_model->name,
+                  l_reserve_size,
+                  static_cast<int>(log.event_list.size()),
+                  l_success ? 0 : 1
+              );
+              put_storage(bench::storage_get_stats());
+              std::fprintf(s_out, "}\n");
+          }
+      }
+}
+
+/* run_storage()
+   record the file accesses of a single load_all() over the given objects, then replay them against the storage models
+*/
+void  run_storage(const char* sample, std::vector<std::string>& path_list) noexcept
+{
+      std::vector<const char*> l_path_list;
+      for(auto& l_path : path_list) {
+          l_path_list.push_back(l_path.c_str());
+      }
+      uld::target     l_target(EM_ARM, uld::bin_32, true, true);
+      bench::io_log_t l_log;
+      bool            l_success;
+      bench::storage_reset(bench::storage_model_sd_spi);
+      bench::io_record_begin(l_log);
+      {
+          uld::image l_image(std::addressof(l_target));
+          define_externs(l_image);
+          l_success = l_image.load_all(l_path_list.data(), l_path_list.size());
+      }
+      bench::io_record_end();
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"storage\",\"sample\":\"%s\",\"model\":\"%s\",\"reserve\":\"live\",\"events\":%d,\"failures\":%d",
+          sample,
+          bench::storage_model_sd_spi.name,
+          static_cast<int>(l_log.event_list.size()),
+          l_success ? 0 : 1
+      );
+      put_storage(bench::storage_get_stats());
+      std::fprintf(s_out, "}\n");
+      if(s_trace_prefix.size()) {
+          std::string l_trace_path = s_trace_prefix + "." + sample + ".trace";
+          if(l_log.save(l_trace_path.c_str()) == false) {
+              std::fprintf(stderr, "uld_bench: cannot write `%s`.\n", l_trace_path.c_str());
+          }
+      }
+      run_replay(sample, l_log);
+}
+
+/*namespace*/ }
+
+#if defined(__x86_64__) && defined(__linux__)
+/* run_x86()
+   native x86-64 objects, loaded into executable pages of the host and run: the code of each load is called once and its
+   result checked against the value the tables of the objects give; `low` maps the pages within the first 2GB, for the
+   objects with absolute 32 bit relocations
+*/
+void  run_x86(const char* kind, const std::vector<bench::elfgen64_t>& shape_list, const std::vector<std::string>& path_list, bool low) noexcept
+{
+      std::vector<const char*> l_path_list;
+      std::int64_t l_expect = host_leaf();
+      int    l_function_count = 0;
+      int    l_rel_count = 0;
+      for(std::size_t l_object = 0; l_object < shape_list.size(); l_object++) {
+          const bench::elfgen64_t& l_shape = shape_list[l_object];
+          for(int l_func = 0; l_func < l_shape.function_count; l_func++) {
+              l_expect += bench::elfgen64_get_table_value(l_shape, l_func) * (l_shape.abs32s ? 3 : 2) + host_bias;
+          }
+          l_function_count += l_shape.function_count;
+          l_rel_count += l_shape.function_count * (l_shape.abs32s ? 6 : 5);
+          l_path_list.push_back(path_list[l_object].c_str());
+      }
+      const bench::elfgen64_t& l_last_shape = shape_list.back();
+      std::string l_entry_name = l_last_shape.prefix + std::to_string(l_last_shape.function_count - 1);
+      int    l_failures = 0;
+      long   l_loads = 0;
+      double l_load_time = 0.0;
+      uld::map_allocator_t l_map(l_function_count * 256 + 64 * 1024, low);
+      if(l_map.get_map_ptr() == nullptr) {
+          std::fprintf(s_out, "{\"suite\":\"x86_64\",\"kind\":\"%s\",\"functions\":%d,\"failures\":1}\n", kind, l_function_count);
+          return;
+      }
+      auto   l_base = clock_type::now();
+      do {
+          {
+              uld::target l_target(EM_X86_64, uld::bin_64, true, false);
+              if(l_target.add_region("host", l_map.get_map_ptr(), l_map.get_map_size(), uld::target::region_rwx, std::addressof(l_map)) == nullptr) {
+                  l_failures++;
+                  break;
+              }
+              uld::image  l_image(std::addressof(l_target));
+              if(l_image.get_program_table()->add_region_rule(nullptr, 0, 0, "host") == false) {
+                  l_failures++;
+                  break;
+              }
+              l_image.make_symbol("host_leaf", uld::symbol_t::type_function, uld::symbol_t::bind_global, reinterpret_cast<void*>(host_leaf));
+              l_image.make_symbol("host_bias", uld::symbol_t::type_object, uld::symbol_t::bind_global, std::addressof(host_bias));
+              auto l_load_base = clock_type::now();
+              if(l_image.load_all(l_path_list.data(), l_path_list.size()) == false) {
+                  l_failures++;
+                  break;
+              }
+              l_load_time += get_seconds(l_load_base);
+              uld::symbol_t* l_entry_ptr = l_image.find_symbol(l_entry_name.c_str());
+              if((l_entry_ptr == nullptr) ||
+                  (reinterpret_cast<std::int64_t(*)()>(l_entry_ptr->ea)() != l_expect)) {
+                  l_failures++;
+              }
+          }
+          l_map.reset();
+          l_loads++;
+      }
+      while(get_seconds(l_base) < (s_quick ? s_time_min / 4 : s_time_min));
+      std::fprintf(
+          s_out,
+          "{\"suite\":\"x86_64\",\"kind\":\"%s\",\"objects\":%d,\"functions\":%d,\"relocations\":%d,\"failures\":%d,\"us_per_load\":%.3f}\n",
+          kind,
+          static_cast<int>(shape_list.size()),
+          l_function_count,
+          l_rel_count,
+          l_failures,
+          l_loads > 0 ? l_load_time * 1e6 / l_loads : 0.0
+      );
+}
+#endif
+
+int   main(int argc, char** argv)
+{
+      int  l_opt;
+      const char* l_replay_path = nullptr;
+      while((l_opt = getopt(argc, argv, "o:d:qkt:r:")) != -1) {
+          switch(l_opt) {
+              case 'o':
+                  s_out = std::fopen(optarg, "w");
+                  if(s_out == nullptr) {
+                      std::fprintf(stderr, "uld_bench: cannot open `%s`.\n", optarg);
+                      return 1;
+                  }
+                  break;
+              case 'd':
+                  s_dir = optarg;
+                  break;
+              case 'q':
+                  s_quick = true;
+                  break;
+              case 'k':
+                  s_keep = true;
+                  break;
+              case 't':
+                  s_trace_prefix = optarg;
+                  break;
+              case 'r':
+                  l_replay_path = optarg;
+                  break;
+              default:
+                  std::fprintf(stderr, "usage: %s [-o <file>] [-d <directory>] [-q] [-k] [-t <prefix>] [-r <trace>]\n", argv[0]);
+                  return 1;
+          }
+      }
+      if(l_replay_path != nullptr) {
+          bench::io_log_t l_log;
+          if(l_log.load(l_replay_path) == false) {
+              std::fprintf(stderr, "uld_bench: cannot read `%s`.\n", l_replay_path);
+              return 1;
+          }
+          run_replay("replay", l_log);
+          if(s_out != stdout) {
+              std::fclose(s_out);
+          }
+          return 0;
+      }
+      std::vector<std::string> l_temp_list;
+      auto  make_object = [&](const char* name, const bench::elfgen_t& shape) -> std::string {
+            std::string l_path = get_path(name);
+            if(bench::elfgen_write(l_path.c_str(), shape) == false) {
+                std::fprintf(stderr, "uld_bench: cannot write `%s`.\n", l_path.c_str());
+                std::exit(1);
+            }
+            l_temp_list.push_back(l_path);
+            return l_path;
+      };
+
+      // load: scaling with the number of symbols
+      for(int l_count : {64, 256, 1024, 2048}) {
+          if(s_quick && (l_count > 256)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.object_count = l_count / 4;
+          l_shape.extern_count = s_extern_count;
+          std::vector<std::string> l_path_list{make_object(("load" + std::to_string(l_count)).c_str(), l_shape)};
+          run_load("load", l_shape, l_path_list);
+      }
+      // resolve: scaling with the number of relocations, at a fixed number of symbols
+      for(int l_rel_count : {1, 4, 16, 64}) {
+          if(s_quick && (l_rel_count > 4)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = 256;
+          l_shape.function_size = l_rel_count * 4 > 64 ? l_rel_count * 4 : 64;
+          l_shape.rel_per_function = l_rel_count;
+          l_shape.extern_count = s_extern_count;
+          std::vector<std::string> l_path_list{make_object(("resolve" + std::to_string(l_rel_count)).c_str(), l_shape)};
+          run_load("resolve", l_shape, l_path_list);
+      }
+      // load_all: scaling with the number of objects in a batch, each referencing the functions of the previous one
+      for(int l_object_count : {1, 2, 4, 8}) {
+          if(s_quick && (l_object_count > 2)) {
+              break;
+          }
+          std::vector<std::string> l_path_list;
+          bench::elfgen_t l_shape;
+          for(int l_object = 0; l_object < l_object_count; l_object++) {
+              l_shape.prefix = "o" + std::to_string(l_object) + "_f";
+              l_shape.function_count = 256;
+              l_shape.extern_count = s_extern_count;
+              l_shape.seed = l_object + 1;
+              if(l_object > 0) {
+                  l_shape.import_prefix = "o" + std::to_string(l_object - 1) + "_f";
+                  l_shape.import_count = 32;
+              }
+              l_path_list.push_back(make_object(("batch" + std::to_string(l_object_count) + "_" + std::to_string(l_object)).c_str(), l_shape));
+          }
+          run_load("load_all", l_shape, l_path_list);
+      }
+      // strip: a batch whose objects each reference a few functions of the previous one and hide a quarter of theirs,
+      // loaded with each of the strip options
+      {
+          std::vector<std::string> l_path_list;
+          bench::elfgen_t l_shape;
+          for(int l_object = 0; l_object < 4; l_object++) {
+              l_shape.prefix = "s" + std::to_string(l_object) + "_f";
+              l_shape.function_count = 256;
+              l_shape.hidden_count = 64;
+              l_shape.extern_count = s_extern_count;
+              l_shape.seed = l_object + 1;
+              if(l_object > 0) {
+                  l_shape.import_prefix = "s" + std::to_string(l_object - 1) + "_f";
+                  l_shape.import_count = 32;
+              }
+              l_path_list.push_back(make_object(("strip" + std::to_string(l_object)).c_str(), l_shape));
+          }
+          for(unsigned int l_options : {uld::image::load_default, uld::image::load_strip_hidden, uld::image::load_strip}) {
+              run_load("strip", l_shape, l_path_list, 0, l_options);
+          }
+      }
+      // load_arena: image pools in a static arena, the temporaries in a scratch arena
+      for(int l_count : {256, 1024}) {
+          if(s_quick && (l_count > 256)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.object_count = l_count / 4;
+          l_shape.extern_count = s_extern_count;
+          std::vector<std::string> l_path_list{make_object(("arena" + std::to_string(l_count)).c_str(), l_shape)};
+          run_load("load_arena", l_shape, l_path_list, 1 << 20);
+          // exhaust: the same object over arenas too small to hold it
+          if(l_count == 256) {
+              run_exhaust(l_shape, l_path_list[0]);
+          }
+      }
+      // find_symbol: scaling with the number of symbols in the image
+      for(int l_count : {64, 256, 1024, 2048}) {
+          if(s_quick && (l_count > 256)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.extern_count = s_extern_count;
+          run_find(l_shape, make_object(("find" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // address: reverse lookups, scaling with the number of functions in the image
+      for(int l_count : {64, 1024}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.object_count = l_count / 8;
+          l_shape.extern_count = s_extern_count;
+          run_address(l_shape, make_object(("address" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // profile: sampling and attribution cost of the profiler
+      for(int l_count : {64, 1024}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.extern_count = s_extern_count;
+          run_profile(l_shape, make_object(("profile" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // probes: load and call overhead of the counting trampolines
+      for(int l_count : {64, 512}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.extern_count = s_extern_count;
+          l_shape.rel_mix[bench::rel_thm_call] = 4;
+          run_probes(l_shape, make_object(("probes" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // placement: hot functions laid out ahead of the others, from a placement profile
+      for(int l_count : {64, 1024}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.section_count = l_count;
+          l_shape.extern_count = s_extern_count;
+          run_placement(l_shape, make_object(("placement" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // regions: sections placed into simulated memory regions by rules
+      for(int l_count : {64, 512}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.section_count = 4;
+          l_shape.object_count = l_count / 8;
+          l_shape.extern_count = s_extern_count;
+          run_regions(l_shape, make_object(("regions" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // segments: section to segment rules, and segment lookups by name
+      for(int l_count : {64, 512}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.section_count = 4;
+          l_shape.object_count = l_count / 8;
+          l_shape.extern_count = s_extern_count;
+          run_segments(l_shape, make_object(("segments" + std::to_string(l_count)).c_str(), l_shape), l_count / 2);
+      }
+      // align: data sections of mixed alignments, packed by decreasing alignment
+      for(int l_count : {64, 512}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = 16;
+          l_shape.object_count = 4;
+          l_shape.buffer_count = l_count;
+          l_shape.extern_count = s_extern_count;
+          run_align(l_shape, make_object(("align" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // scopes: a plugin linked against a shared base image, against one holding a copy of the base
+      for(int l_count : {256, 1024}) {
+          if(s_quick && (l_count > 256)) {
+              break;
+          }
+          bench::elfgen_t l_base_shape;
+          l_base_shape.prefix = "base_f";
+          l_base_shape.function_count = l_count;
+          l_base_shape.extern_count = s_extern_count;
+          bench::elfgen_t l_plugin_shape;
+          l_plugin_shape.prefix = "plugin_f";
+          l_plugin_shape.function_count = 64;
+          l_plugin_shape.extern_count = s_extern_count;
+          l_plugin_shape.import_prefix = l_base_shape.prefix;
+          l_plugin_shape.import_count = 32;
+          l_plugin_shape.seed = 2;
+          std::string l_base_path = make_object(("scopes_base" + std::to_string(l_count)).c_str(), l_base_shape);
+          run_scopes(l_base_shape, l_base_path, make_object(("scopes_plugin" + std::to_string(l_count)).c_str(), l_plugin_shape));
+      }
+      // exports: firmware exports registered at startup, against an export table
+      for(int l_count : {256, 1024, 4096}) {
+          if(s_quick && (l_count > 1024)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = 64;
+          l_shape.extern_count = s_extern_count;
+          run_exports(l_count, make_object(("exports" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // plan: cost of a pre-flight estimate, against that of the load
+      for(int l_count : {64, 256, 1024}) {
+          if(s_quick && (l_count > 256)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.object_count = l_count / 4;
+          l_shape.extern_count = s_extern_count + 4;
+          run_plan(l_shape, make_object(("plan" + std::to_string(l_count)).c_str(), l_shape));
+      }
+      // storage: simulated storage time of the file accesses of a load, for several data cache sizes
+      for(int l_count : {256, 1024}) {
+          if(s_quick && (l_count > 256)) {
+              break;
+          }
+          bench::elfgen_t l_shape;
+          l_shape.function_count = l_count;
+          l_shape.object_count = l_count / 4;
+          l_shape.extern_count = s_extern_count;
+          std::string l_sample = "load" + std::to_string(l_count);
+          std::vector<std::string> l_path_list{make_object(("storage" + std::to_string(l_count)).c_str(), l_shape)};
+          run_storage(l_sample.c_str(), l_path_list);
+      }
+      {
+          std::vector<std::string> l_path_list;
+          bench::elfgen_t l_shape;
+          for(int l_object = 0; l_object < 4; l_object++) {
+              l_shape.prefix = "o" + std::to_string(l_object) + "_f";
+              l_shape.function_count = 256;
+              l_shape.extern_count = s_extern_count;
+              l_shape.seed = l_object + 1;
+              if(l_object > 0) {
+                  l_shape.import_prefix = "o" + std::to_string(l_object - 1) + "_f";
+                  l_shape.import_count = 32;
+              }
+              l_path_list.push_back(make_object(("storage_batch_" + std::to_string(l_object)).c_str(), l_shape));
+          }
+          run_storage("load_all4", l_path_list);
+      }
+#if defined(__x86_64__) && defined(__linux__)
+      // x86_64: native objects loaded into executable host pages and run, alone and as a chained batch
+      for(int l_count : {64, 1024}) {
+          if(s_quick && (l_count > 64)) {
+              break;
+          }
+          for(bool l_low : {false, true}) {
+              bench::elfgen64_t l_shape;
+              l_shape.function_count = l_count;
+              l_shape.section_count = 4;
+              l_shape.abs32s = l_low;
+              std::string l_path = get_path(("x86_" + std::string(l_low ? "low" : "high") + std::to_string(l_count)).c_str());
+              if(bench::elfgen64_write(l_path.c_str(), l_shape) == false) {
+                  std::fprintf(stderr, "uld_bench: cannot write `%s`.\n", l_path.c_str());
+                  return 1;
+              }
+              l_temp_list.push_back(l_path);
+              run_x86(l_low ? "abs32s" : "plain", {l_shape}, {l_path}, l_low);
+          }
+          std::vector<bench::elfgen64_t> l_shape_list(2);
+          std::vector<std::string> l_path_list;
+          for(int l_object = 0; l_object < 2; l_object++) {
+              bench::elfgen64_t& l_shape = l_shape_list[l_object];
+              l_shape.prefix = "x" + std::to_string(l_object) + "_f";
+              l_shape.function_count = l_count;
+              l_shape.seed = l_object + 1;
+              if(l_object > 0) {
+                  l_shape.import_prefix = l_shape_list[l_object - 1].prefix;
+                  l_shape.import_index = l_count - 1;
+              }
+              l_path_list.push_back(get_path(("x86_batch" + std::to_string(l_count) + "_" + std::to_string(l_object)).c_str()));
+              if(bench::elfgen64_write(l_path_list.back().c_str(), l_shape) == false) {
+                  std::fprintf(stderr, "uld_bench: cannot write `%s`.\n", l_path_list.back().c_str());
+                  return 1;
+              }
+              l_temp_list.push_back(l_path_list.back());
+          }
+          run_x86("batch", l_shape_list, l_path_list, false);
+      }
+#endif
+      if(s_keep == false) {
+          for(auto& l_path : l_temp_list) {
+              unlink(l_path.c_str());
+          }
+      }
+      if(s_out != stdout) {
+          std::fclose(s_out);
+      }
+      return 0;
+}
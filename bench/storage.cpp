@@ -0,0 +1,406 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "storage.h"
+#include <trace.h>
+#include <bfd/util/file.h>
+#include <bfd/util/cache.h>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace bench {
+
+const storage_model_t storage_model_sd_spi = {"sd_spi", 512, 2.0, 60.0, 250.0, 42.0};
+const storage_model_t storage_model_sd_sdio = {"sd_sdio", 512, 2.0, 20.0, 150.0, 10.0};
+const storage_model_t storage_model_qspi = {"qspi", 512, 2.0, 2.0, 0.0, 8.0};
+
+namespace {
+
+constexpr int s_file_align = 64;    // sectors; files start at cluster boundaries
+
+storage_model_t s_model = storage_model_sd_spi;
+storage_stats_t s_stats;
+
+std::vector<std::string>         s_open_list;      // path of each f_open(), by `FIL::open_id` - 1
+std::map<std::string, long>      s_base_map;       // first sector of each file on the simulated device
+long            s_base_next = 0;
+long            s_sector_next = -1;                // sector following the latest device read
+
+long  get_base_sector(FIL* fp) noexcept
+{
+      if((fp->open_id <= 0) ||
+          (fp->open_id > static_cast<int>(s_open_list.size()))) {
+          return 0;
+      }
+      const std::string& l_path = s_open_list[fp->open_id - 1];
+      auto  l_base_iter = s_base_map.find(l_path);
+      if(l_base_iter != s_base_map.end()) {
+          return l_base_iter->second;
+      }
+      long  l_sector_count = (fp->objsize + s_model.sector_size - 1) / s_model.sector_size;
+      long  l_base = s_base_next;
+      s_base_next += ((l_sector_count + s_file_align - 1) / s_file_align + 1) * s_file_align;
+      s_base_map[l_path] = l_base;
+      return l_base;
+}
+
+void  put_command(long sector, long count) noexcept
+{
+      s_stats.command_count++;
+      s_stats.time_us += s_model.command_us;
+      if(sector != s_sector_next) {
+          s_stats.seek_count++;
+          s_stats.time_us += s_model.seek_us;
+      }
+      s_stats.sector_count += count;
+      s_stats.time_us += count * s_model.sector_us;
+      s_sector_next = sector + count;
+}
+
+/*namespace*/ }
+
+void  storage_reset(const storage_model_t& model) noexcept
+{
+      s_model = model;
+      s_stats = storage_stats_t{};
+      s_base_map.clear();
+      s_base_next = 0;
+      s_sector_next = -1;
+}
+
+const storage_stats_t& storage_get_stats() noexcept
+{
+      return s_stats;
+}
+
+void  storage_on_open(FIL* fp, const char* path) noexcept
+{
+      s_open_list.push_back(path);
+      fp->open_id = s_open_list.size();
+      fp->win_sector = -1;
+}
+
+void  storage_on_read(FIL* fp, unsigned int size) noexcept
+{
+      long  l_sector_size = s_model.sector_size;
+      long  l_base = get_base_sector(fp);
+      long  l_position = fp->fptr;
+      long  l_tail = l_position + size;
+      if(l_tail > static_cast<long>(fp->objsize)) {
+          l_tail = fp->objsize;
+      }
+      s_stats.call_count++;
+      s_stats.time_us += s_model.call_us;
+      if(l_tail > l_position) {
+          s_stats.byte_count += l_tail - l_position;
+      }
+      while(l_position < l_tail) {
+          long l_sector = l_position / l_sector_size;
+          long l_offset = l_position % l_sector_size;
+          // whole sectors bypass the window
+          if((l_offset == 0) &&
+              (l_tail - l_position >= l_sector_size)) {
+              long l_count = (l_tail - l_position) / l_sector_size;
+              put_command(l_base + l_sector, l_count);
+              l_position += l_count * l_sector_size;
+              continue;
+          }
+          // partial sectors are read through the window, which is only refilled on a sector change
+          if(fp->win_sector != l_sector) {
+              put_command(l_base + l_sector, 1);
+              fp->win_sector = l_sector;
+          }
+          l_position += l_sector_size - l_offset;
+      }
+}
+
+void  storage_on_lseek(FIL*) noexcept
+{
+      s_stats.lseek_count++;
+      s_stats.time_us += s_model.call_us;
+}
+
+namespace {
+
+/* recorder_t
+   io_trace_t receiver appending to an io_log_t
+*/
+struct recorder_t
+{
+  uld::io_trace_t  trace;
+  io_log_t*        log;
+  std::unordered_map<const void*, int> cache_map;
+  std::unordered_map<int, int>         file_map;    // FIL::open_id -> index in `io_log_t::path_list`
+};
+
+recorder_t  s_recorder;
+
+int   get_file_index(const void* file) noexcept
+{
+      auto  l_fp = static_cast<const FIL*>(file);
+      auto  l_file_iter = s_recorder.file_map.find(l_fp->open_id);
+      if(l_file_iter != s_recorder.file_map.end()) {
+          return l_file_iter->second;
+      }
+      int   l_index = s_recorder.log->path_list.size();
+      if((l_fp->open_id > 0) &&
+          (l_fp->open_id <= static_cast<int>(s_open_list.size()))) {
+          s_recorder.log->path_list.push_back(s_open_list[l_fp->open_id - 1]);
+      } else {
+          s_recorder.log->path_list.push_back(std::string());
+      }
+      s_recorder.file_map[l_fp->open_id] = l_index;
+      return l_index;
+}
+
+int   get_cache_index(const void* cache) noexcept
+{
+      auto  l_cache_iter = s_recorder.cache_map.find(cache);
+      if(l_cache_iter != s_recorder.cache_map.end()) {
+          return l_cache_iter->second;
+      }
+      return -1;
+}
+
+void  put_event(char op, int a, int b = 0, int c = 0) noexcept
+{
+      s_recorder.log->event_list.push_back({op, a, b, c});
+}
+
+void  on_cache_make(void*, const void* cache, const void* file, int reserve_size) noexcept
+{
+      int  l_index = s_recorder.log->cache_count++;
+      s_recorder.cache_map[cache] = l_index;
+      put_event('c', l_index, get_file_index(file), reserve_size);
+}
+
+void  on_cache_free(void*, const void* cache) noexcept
+{
+      int  l_index = get_cache_index(cache);
+      if(l_index >= 0) {
+          put_event('d', l_index);
+          s_recorder.cache_map.erase(cache);
+      }
+}
+
+void  on_cache_seek(void*, const void* cache, int position) noexcept
+{
+      put_event('s', get_cache_index(cache), position);
+}
+
+void  on_cache_fetch(void*, const void* cache, int size) noexcept
+{
+      put_event('g', get_cache_index(cache), size);
+}
+
+void  on_cache_lock(void*, const void* cache) noexcept
+{
+      put_event('a', get_cache_index(cache));
+}
+
+void  on_cache_unlock(void*, const void* cache) noexcept
+{
+      put_event('l', get_cache_index(cache));
+}
+
+void  on_file_read(void*, const void* file, int position, int size) noexcept
+{
+      put_event('r', get_file_index(file), position, size);
+}
+
+/*namespace*/ }
+
+bool  io_log_t::save(const char* path) const noexcept
+{
+      FILE* l_file = std::fopen(path, "w");
+      if(l_file == nullptr) {
+          return false;
+      }
+      for(std::size_t l_index = 0; l_index < path_list.size(); l_index++) {
+          std::fprintf(l_file, "f %d %s\n", static_cast<int>(l_index), path_list[l_index].c_str());
+      }
+      for(auto& l_event : event_list) {
+          switch(l_event.op) {
+              case 'c':
+              case 'r':
+                  std::fprintf(l_file, "%c %d %d %d\n", l_event.op, l_event.a, l_event.b, l_event.c);
+                  break;
+              case 's':
+              case 'g':
+                  std::fprintf(l_file, "%c %d %d\n", l_event.op, l_event.a, l_event.b);
+                  break;
+              default:
+                  std::fprintf(l_file, "%c %d\n", l_event.op, l_event.a);
+                  break;
+          }
+      }
+      return std::fclose(l_file) == 0;
+}
+
+bool  io_log_t::load(const char* path) noexcept
+{
+      FILE* l_file = std::fopen(path, "r");
+      if(l_file == nullptr) {
+          return false;
+      }
+      char  l_line[1024];
+      path_list.clear();
+      event_list.clear();
+      cache_count = 0;
+      while(std::fgets(l_line, sizeof(l_line), l_file) != nullptr) {
+          io_event_t l_event{0, 0, 0, 0};
+          char       l_name[1024];
+          if(l_line[0] == 'f') {
+              if(std::sscanf(l_line, "f %d %1023s", std::addressof(l_event.a), l_name) != 2) {
+                  std::fclose(l_file);
+                  return false;
+              }
+              if(l_event.a >= static_cast<int>(path_list.size())) {
+                  path_list.resize(l_event.a + 1);
+              }
+              path_list[l_event.a] = l_name;
+              continue;
+          }
+          if(std::sscanf(l_line, "%c %d %d %d", std::addressof(l_event.op), std::addressof(l_event.a), std::addressof(l_event.b), std::addressof(l_event.c)) < 2) {
+              continue;
+          }
+          if(l_event.op == 'c') {
+              cache_count++;
+          }
+          event_list.push_back(l_event);
+      }
+      std::fclose(l_file);
+      return true;
+}
+
+void  io_record_begin(io_log_t& log) noexcept
+{
+      s_recorder.trace = {
+          nullptr,
+          on_cache_make,
+          on_cache_free,
+          on_cache_seek,
+          on_cache_fetch,
+          on_cache_lock,
+          on_cache_unlock,
+          on_file_read
+      };
+      s_recorder.log = std::addressof(log);
+      s_recorder.cache_map.clear();
+      s_recorder.file_map.clear();
+      uld::trace::set_io_trace(std::addressof(s_recorder.trace));
+}
+
+void  io_record_end() noexcept
+{
+      uld::trace::set_io_trace(nullptr);
+      s_recorder.log = nullptr;
+}
+
+bool  io_replay(const io_log_t& log, int reserve_size) noexcept
+{
+      std::vector<uld::util::file_ptr> l_file_list;
+      std::vector<std::unique_ptr<uld::util::data_cache_t>> l_cache_list(log.cache_count);
+      std::vector<std::vector<int>>    l_lock_list(log.cache_count);
+      std::vector<std::uint8_t>        l_data;
+      bool  l_success = true;
+      for(auto& l_path : log.path_list) {
+          uld::util::file_ptr l_file_ptr = uld::util::file_ptr::make_file_cb();
+          if(l_file_ptr == false) {
+              return false;
+          }
+          if(f_open(l_file_ptr, l_path.c_str(), FA_READ | FA_OPEN_EXISTING) != FR_OK) {
+              return false;
+          }
+          l_file_list.push_back(std::move(l_file_ptr));
+      }
+      for(auto& l_event : log.event_list) {
+          if(l_event.op == 'r') {
+              unsigned int l_read_size;
+              if((l_event.a < 0) ||
+                  (l_event.a >= static_cast<int>(l_file_list.size()))) {
+                  l_success = false;
+                  continue;
+              }
+              if(static_cast<int>(l_data.size()) < l_event.c) {
+                  l_data.resize(l_event.c);
+              }
+              f_lseek(l_file_list[l_event.a], l_event.b);
+              f_read(l_file_list[l_event.a], l_data.data(), l_event.c, std::addressof(l_read_size));
+              continue;
+          }
+          if((l_event.a < 0) ||
+              (l_event.a >= log.cache_count)) {
+              l_success = false;
+              continue;
+          }
+          auto& l_cache = l_cache_list[l_event.a];
+          if(l_event.op == 'c') {
+              if((l_event.b < 0) ||
+                  (l_event.b >= static_cast<int>(l_file_list.size()))) {
+                  l_success = false;
+                  continue;
+              }
+              l_cache = std::make_unique<uld::util::data_cache_t>(l_file_list[l_event.b], reserve_size < 0 ? l_event.c : reserve_size);
+              continue;
+          }
+          if(l_cache == nullptr) {
+              l_success = false;
+              continue;
+          }
+          switch(l_event.op) {
+              case 'd':
+                  l_cache.reset();
+                  break;
+              case 's':
+                  l_cache->seek(l_event.b);
+                  break;
+              case 'g':
+                  if(static_cast<int>(l_data.size()) < l_event.b) {
+                      l_data.resize(l_event.b);
+                  }
+                  l_cache->raw_get(l_data.data(), l_event.b);
+                  break;
+              case 'a': {
+                  int l_save_offset;
+                  if(l_cache->acquire(l_save_offset)) {
+                      l_lock_list[l_event.a].push_back(l_save_offset);
+                  }
+                  break;
+              }
+              case 'l':
+                  if(l_lock_list[l_event.a].empty() == false) {
+                      l_cache->release(l_lock_list[l_event.a].back());
+                      l_lock_list[l_event.a].pop_back();
+                  }
+                  break;
+              default:
+                  l_success = false;
+                  break;
+          }
+      }
+      return l_success;
+}
+
+/*namespace bench*/ }
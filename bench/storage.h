@@ -0,0 +1,125 @@
+#ifndef uld_bench_storage_h
+#define uld_bench_storage_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <ff.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/* storage_model_t
+   latency model of the storage device behind FatFs; all the times are in microseconds
+   the file system is modelled the way FatFs reads: partial sectors go through the sector window of the file object, whole
+   sectors are transferred directly into the caller's buffer, files are laid out contiguously on the device
+*/
+struct storage_model_t
+{
+  const char*   name;
+  int           sector_size;
+  double        call_us;        // file system overhead of each f_read() or f_lseek() call
+  double        command_us;     // overhead of each device read command
+  double        seek_us;        // extra cost of a read command which does not continue where the previous one ended
+  double        sector_us;      // transfer time of a sector
+};
+
+/* storage_model_*
+   presets, roughly: an SD card over SPI, an SD card over a 4-bit SDIO bus and a QSPI NOR flash
+*/
+extern const storage_model_t storage_model_sd_spi;
+extern const storage_model_t storage_model_sd_sdio;
+extern const storage_model_t storage_model_qspi;
+
+/* storage_stats_t
+   simulated time and access counts, accumulated since the latest storage_reset()
+*/
+struct storage_stats_t
+{
+  double        time_us;
+  long          call_count;     // f_read() calls
+  long          lseek_count;    // f_lseek() calls
+  long          command_count;  // device read commands
+  long          seek_count;     // non-sequential device read commands
+  long          sector_count;   // sectors transferred
+  long          byte_count;     // bytes requested by the loader
+};
+
+/* storage_reset()
+   select the storage model and clear the stats
+*/
+void  storage_reset(const storage_model_t&) noexcept;
+const storage_stats_t& storage_get_stats() noexcept;
+
+/* storage_on_*()
+   accounting hooks, called by the FatFs stand-in
+*/
+void  storage_on_open(FIL*, const char*) noexcept;
+void  storage_on_read(FIL*, unsigned int) noexcept;
+void  storage_on_lseek(FIL*) noexcept;
+
+/* io_event_t
+   a single recorded file access:
+     'c' cache `a` made over file `b` with a reserve of `c` bytes
+     'd' cache `a` freed
+     's' cache `a` seeks at `b`
+     'g' cache `a` gets `b` bytes
+     'a' cache `a` locked
+     'l' cache `a` unlocked
+     'r' file `a` read directly `c` bytes at `b`
+*/
+struct io_event_t
+{
+  char          op;
+  int           a;
+  int           b;
+  int           c;
+};
+
+/* io_log_t
+   recorded file accesses of one or more loads: files are identified by their index in `path_list`, caches by the order
+   of their creation
+*/
+struct io_log_t
+{
+  std::vector<std::string> path_list;
+  std::vector<io_event_t>  event_list;
+  int           cache_count = 0;
+
+  bool  save(const char*) const noexcept;
+  bool  load(const char*) noexcept;
+};
+
+/* io_record_begin()
+   start recording the file accesses of the loader into `log`
+*/
+void  io_record_begin(io_log_t& log) noexcept;
+void  io_record_end() noexcept;
+
+/* io_replay()
+   re-issue the accesses recorded in `log` against fresh data caches; a `reserve_size` of -1 keeps the recorded reserve
+   sizes, any other value overrides them
+*/
+bool  io_replay(const io_log_t& log, int reserve_size = -1) noexcept;
+
+/*namespace bench*/ }
+#endif
@@ -21,6 +21,8 @@
 **/
 #include "bin.h"
 #include "raw.h"
+#include <stats.h>
+#include <trace.h>
 #include <elf.h>
 
 namespace uld {
@@ -44,8 +46,10 @@ namespace uld {
           unsigned int  l_abi_version;
           FRESULT       l_rc;
           unsigned int  l_read_size;
+          trace::on_file_read(static_cast<FIL*>(m_file_ptr), m_file_offset, EI_NIDENT);
           if(l_rc = f_read(m_file_ptr, l_head_data, EI_NIDENT, std::addressof(l_read_size));
               l_rc == FR_OK) {
+              stats::on_read(l_read_size);
               l_elf_class   = l_head_data[EI_CLASS];
               l_elf_fmt     = l_head_data[EI_DATA];
               l_elf_version = l_head_data[EI_VERSION];
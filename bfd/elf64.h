@@ -21,15 +21,16 @@
     CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
-#include "bin.h"
-#include <elf.h>
+#include "elfxx.h"
 
 namespace uld {
 
 /* elf64_bfd_t
 */
-class elf64_bfd_t: public bin_bfd_t
+class elf64_bfd_t: public elfxx_bfd_t<bin_64>
 {
+  public:
+  using   elfxx_bfd_t::elfxx_bfd_t;
 };
 
 /*namespace uld*/ }
@@ -19,8 +19,10 @@
     CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
-#include "elf32.h"
+#include "elfxx.h"
 #include "bin.h"
+#include <stats.h>
+#include <trace.h>
 #include <log.h>
 #include <elf.h>
 #include <limits>
@@ -28,9 +30,11 @@
 namespace uld {
 
 static void dbg_dump_shdr() noexcept;
-static void dbg_dump_shdr(Elf32_Shdr& shdr, int = -1, bool = true, bool = true) noexcept;
+template<typename Xt>
+static void dbg_dump_shdr(Xt& shdr, int = -1, bool = true, bool = true) noexcept;
 
-      elf32_bfd_t::elf32_bfd_t(bin_bfd_t& source) noexcept:
+template<unsigned int Class>
+      elfxx_bfd_t<Class>::elfxx_bfd_t(bin_bfd_t& source) noexcept:
       bin_bfd_t(source),
       m_str_cache(m_file_ptr),
       m_str_section(0),
@@ -41,7 +45,7 @@ static void dbg_dump_shdr(Elf32_Shdr& shdr, int = -1, bool = true, bool = true)
 {
       // read the ELF header
       if(source.is_elf()) {
-          Elf32_Ehdr   l_head_info;
+          ehdr_type   l_head_info;
           int          l_read_size = 0;
           int          l_read_offset = m_data_cache.seek(m_file_offset + EI_NIDENT);
           if(l_read_offset == m_file_offset + EI_NIDENT) {
@@ -79,7 +83,7 @@ static void dbg_dump_shdr(Elf32_Shdr& shdr, int = -1, bool = true, bool = true)
                       l_head_info.e_shstrndx
                   );
               }
-              if(l_read_size == sizeof(Elf32_Ehdr) - EI_NIDENT) {
+              if(l_read_size == sizeof(ehdr_type) - EI_NIDENT) {
                   e_type = l_head_info.e_type;
                   e_machine = l_head_info.e_machine;
                   e_version = l_head_info.e_version;
@@ -93,23 +97,30 @@ static void dbg_dump_shdr(Elf32_Shdr& shdr, int = -1, bool = true, bool = true)
                   e_shentsize = l_head_info.e_shentsize;
                   e_shnum = l_head_info.e_shnum;
                   e_shstrndx = l_head_info.e_shstrndx;
+                  if(e_shoff > static_cast<off_type>(std::numeric_limits<int>::max())) {
+                      // the data caches address the file with an int: the section headers of a larger file are out of
+                      // reach
+                      e_shnum = 0;
+                  }
               }
           }
       }
 }
 
-      elf32_bfd_t::~elf32_bfd_t() noexcept
+template<unsigned int Class>
+      elfxx_bfd_t<Class>::~elfxx_bfd_t() noexcept
 {
 }
 
 /* idc_str_load()
    find and load the details of the string section pointed to by the given index
 */
-bool  elf32_bfd_t::ids_str_load(int section) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::ids_str_load(int section) noexcept
 {
       if((section >= 0) &&
           (section <= std::numeric_limits<short int>::max())) {
-          Elf32_Shdr l_shdr_info;
+          shdr_type l_shdr_info;
           if(bool
               l_shdr_found = read_section_info(l_shdr_info, section);
               l_shdr_found == true) {
@@ -125,7 +136,8 @@ bool  elf32_bfd_t::ids_str_load(int section) noexcept
 /* idc_str_get
    get a pointer to a string in the string section specified by its index
 */
-bool  elf32_bfd_t::ids_str_get(int section, int offset, const char*& str_ptr, int& str_length) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::ids_str_get(int section, int offset, const char*& str_ptr, int& str_length) noexcept
 {
       if(offset >= 0) {
           bool l_load_success = true;
@@ -170,12 +182,13 @@ bool  elf32_bfd_t::ids_str_get(int section, int offset, const char*& str_ptr, in
       return false;
 }
 
-bool  elf32_bfd_t::read_section_info(Elf32_Shdr& shdr, int index) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_section_info(shdr_type& shdr, int index) noexcept
 {
       if((index >= 0) &&
           (index < e_shnum)) {
           int l_ent_size    = e_shentsize;
-          int l_file_offset = m_file_offset + e_shoff + index * l_ent_size;
+          int l_file_offset = m_file_offset + static_cast<int>(e_shoff) + index * l_ent_size;
           int l_seek_offset = m_shdr_cache.seek(l_file_offset);
           int l_read_size = 0;
           if(l_seek_offset == l_file_offset) {
@@ -207,13 +220,14 @@ bool  elf32_bfd_t::read_section_info(Elf32_Shdr& shdr, int index) noexcept
                       shdr.sh_entsize
                   );
               }
-              return l_read_size >= static_cast<int>(sizeof(Elf32_Shdr));
+              return l_read_size >= static_cast<int>(sizeof(shdr_type));
           }
       }
       return false;
 }
 
-bool  elf32_bfd_t::read_section_name(Elf32_Shdr& shdr, const char*& name_ptr, int& name_length) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_section_name(shdr_type& shdr, const char*& name_ptr, int& name_length) noexcept
 {
       name_ptr = nullptr;
       name_length = 0;
@@ -226,7 +240,8 @@ bool  elf32_bfd_t::read_section_name(Elf32_Shdr& shdr, const char*& name_ptr, in
 /* read_section_data()
    load full section data into the local data buffer and return a pointer to it
 */
-bool  elf32_bfd_t::read_section_data(Elf32_Shdr& shdr, std::uint8_t*& data, int size) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_section_data(shdr_type& shdr, std::uint8_t*& data, int size) noexcept
 {
       return read_section_at(shdr, 0, data, shdr.sh_size);
 }
@@ -234,7 +249,8 @@ bool  elf32_bfd_t::read_section_data(Elf32_Shdr& shdr, std::uint8_t*& data, int
 /* read_section_at()
    load section data at the specified offset and with the specified size into the local data buffer and return a pointer to it
 */
-bool  elf32_bfd_t::read_section_at(Elf32_Shdr& shdr, int spos, std::uint8_t*& data, int size) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_section_at(shdr_type& shdr, int spos, std::uint8_t*& data, int size) noexcept
 {
       return false;
 }
@@ -242,7 +258,8 @@ bool  elf32_bfd_t::read_section_at(Elf32_Shdr& shdr, int spos, std::uint8_t*& da
 /* copy_section_data()
    copy full section data into the buffer pointed to by `data`
 */
-bool  elf32_bfd_t::copy_section_data(Elf32_Shdr& shdr, std::uint8_t* data, int size) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::copy_section_data(shdr_type& shdr, std::uint8_t* data, int size) noexcept
 {
       return copy_section_at(shdr, 0, data, shdr.sh_size);
 }
@@ -250,19 +267,23 @@ bool  elf32_bfd_t::copy_section_data(Elf32_Shdr& shdr, std::uint8_t* data, int s
 /* copy_section_at()
    copy section data at the specified offset and with the specified size into the data buffer pointed to by `data`.
 */
-bool  elf32_bfd_t::copy_section_at(Elf32_Shdr& shdr, int spos, std::uint8_t* data, int size) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::copy_section_at(shdr_type& shdr, int spos, std::uint8_t* data, int size) noexcept
 {
       int l_read_offset = m_file_offset + shdr.sh_offset + spos;
       int l_tail_offset = l_read_offset + size;
+      trace::on_file_read(static_cast<FIL*>(m_file_ptr), l_read_offset, size);
       if(l_tail_offset > l_read_offset) {
           if(l_tail_offset <= static_cast<int>(shdr.sh_offset) + static_cast<int>(shdr.sh_size)) {
               unsigned int l_read_size;
+              stats::on_seek();
               if(FRESULT
                   l_rc = f_lseek(m_file_ptr, l_read_offset);
                   l_rc == FR_OK) {
                   if(FRESULT
                       l_rc = f_read(m_file_ptr, data, size, std::addressof(l_read_size));
                       l_rc == FR_OK) {
+                      stats::on_read(l_read_size);
                       l_read_offset += static_cast<int>(l_read_size);
                   }
               }
@@ -271,12 +292,14 @@ bool  elf32_bfd_t::copy_section_at(Elf32_Shdr& shdr, int spos, std::uint8_t* dat
       return l_read_offset >= l_tail_offset;
 }
 
-int   elf32_bfd_t::get_section_count() noexcept
+template<unsigned int Class>
+int   elfxx_bfd_t<Class>::get_section_count() noexcept
 {
       return e_shnum;
 }
 
-bool  elf32_bfd_t::read_symbol_info(Elf32_Sym& sym, Elf32_Shdr& shdr, int index) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_symbol_info(sym_type& sym, shdr_type& shdr, int index) noexcept
 {
       if(index >= 0) {
           if(shdr.sh_entsize > 0) {
@@ -287,26 +310,48 @@ bool  elf32_bfd_t::read_symbol_info(Elf32_Sym& sym, Elf32_Shdr& shdr, int index)
                   int l_read_size = 0;
                   if(l_seek_offset == l_file_offset) {
                       if(m_lsb_bit) {
-                          l_read_size = m_data_cache.lsb_get(
-                              sym.st_name,
-                              sym.st_value,
-                              sym.st_size,
-                              sym.st_info,
-                              sym.st_other,
-                              sym.st_shndx
-                          );
+                          if constexpr (Class == bin_32) {
+                              l_read_size = m_data_cache.lsb_get(
+                                  sym.st_name,
+                                  sym.st_value,
+                                  sym.st_size,
+                                  sym.st_info,
+                                  sym.st_other,
+                                  sym.st_shndx
+                              );
+                          } else {
+                              l_read_size = m_data_cache.lsb_get(
+                                  sym.st_name,
+                                  sym.st_info,
+                                  sym.st_other,
+                                  sym.st_shndx,
+                                  sym.st_value,
+                                  sym.st_size
+                              );
+                          }
                       } else
                       if(m_msb_bit) {
-                          l_read_size = m_data_cache.msb_get(
-                              sym.st_name,
-                              sym.st_value,
-                              sym.st_size,
-                              sym.st_info,
-                              sym.st_other,
-                              sym.st_shndx
-                          );
+                          if constexpr (Class == bin_32) {
+                              l_read_size = m_data_cache.msb_get(
+                                  sym.st_name,
+                                  sym.st_value,
+                                  sym.st_size,
+                                  sym.st_info,
+                                  sym.st_other,
+                                  sym.st_shndx
+                              );
+                          } else {
+                              l_read_size = m_data_cache.msb_get(
+                                  sym.st_name,
+                                  sym.st_info,
+                                  sym.st_other,
+                                  sym.st_shndx,
+                                  sym.st_value,
+                                  sym.st_size
+                              );
+                          }
                       }
-                      return l_read_size >= static_cast<int>(sizeof(Elf32_Sym));
+                      return l_read_size >= static_cast<int>(sizeof(sym_type));
                   }
               }
           }
@@ -314,14 +359,16 @@ bool  elf32_bfd_t::read_symbol_info(Elf32_Sym& sym, Elf32_Shdr& shdr, int index)
       return false;
 }
 
-bool  elf32_bfd_t::read_symbol_name(Elf32_Sym& sym, Elf32_Shdr& shdr, const char*& name_ptr, int& name_length) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_symbol_name(sym_type& sym, shdr_type& shdr, const char*& name_ptr, int& name_length) noexcept
 {
       name_ptr = nullptr;
       name_length = 0;
       return ids_str_get(shdr.sh_link, sym.st_name, name_ptr, name_length);
 }
 
-int   elf32_bfd_t::get_symbol_count(Elf32_Shdr& shdr) noexcept
+template<unsigned int Class>
+int   elfxx_bfd_t<Class>::get_symbol_count(shdr_type& shdr) noexcept
 {
       if(shdr.sh_type == SHT_SYMTAB) {
           if(shdr.sh_size > 0) {
@@ -340,7 +387,8 @@ int   elf32_bfd_t::get_symbol_count(Elf32_Shdr& shdr) noexcept
       return 0;
 }
 
-bool  elf32_bfd_t::read_rel_info(Elf32_Rel& rel, Elf32_Shdr& shdr, int index) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_rel_info(rel_type& rel, shdr_type& shdr, int index) noexcept
 {
       if(index >= 0) {
           if(shdr.sh_entsize > 0) {
@@ -362,7 +410,7 @@ bool  elf32_bfd_t::read_rel_info(Elf32_Rel& rel, Elf32_Shdr& shdr, int index) no
                               rel.r_info
                           );
                       }
-                      return l_read_size >= static_cast<int>(sizeof(Elf32_Rel));
+                      return l_read_size >= static_cast<int>(sizeof(rel_type));
                   }
               }
           }
@@ -370,7 +418,8 @@ bool  elf32_bfd_t::read_rel_info(Elf32_Rel& rel, Elf32_Shdr& shdr, int index) no
       return false;
 }
 
-int   elf32_bfd_t::get_rel_count(Elf32_Shdr& shdr) noexcept
+template<unsigned int Class>
+int   elfxx_bfd_t<Class>::get_rel_count(shdr_type& shdr) noexcept
 {
       if(shdr.sh_type == SHT_REL) {
           if(shdr.sh_size > 0) {
@@ -389,7 +438,8 @@ int   elf32_bfd_t::get_rel_count(Elf32_Shdr& shdr) noexcept
       return 0;
 }
 
-bool  elf32_bfd_t::read_rela_info(Elf32_Rela& rela, Elf32_Shdr& shdr, int index) noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::read_rela_info(rela_type& rela, shdr_type& shdr, int index) noexcept
 {
       if(index >= 0) {
           if(shdr.sh_entsize > 0) {
@@ -413,7 +463,7 @@ bool  elf32_bfd_t::read_rela_info(Elf32_Rela& rela, Elf32_Shdr& shdr, int index)
                               rela.r_addend
                           );
                       }
-                      return l_read_size >= static_cast<int>(sizeof(Elf32_Rela));
+                      return l_read_size >= static_cast<int>(sizeof(rela_type));
                   }
               }
           }
@@ -421,7 +471,8 @@ bool  elf32_bfd_t::read_rela_info(Elf32_Rela& rela, Elf32_Shdr& shdr, int index)
       return false;
 }
 
-int   elf32_bfd_t::get_rela_count(Elf32_Shdr& shdr) noexcept
+template<unsigned int Class>
+int   elfxx_bfd_t<Class>::get_rela_count(shdr_type& shdr) noexcept
 {
       if(shdr.sh_type == SHT_RELA) {
           if(shdr.sh_size > 0) {
@@ -440,27 +491,32 @@ int   elf32_bfd_t::get_rela_count(Elf32_Shdr& shdr) noexcept
       return 0;
 }
 
-unsigned int elf32_bfd_t::get_object_type() const noexcept
+template<unsigned int Class>
+unsigned int elfxx_bfd_t<Class>::get_object_type() const noexcept
 {
       return e_type;
 }
 
-bool  elf32_bfd_t::has_object_type(unsigned int object_type) const noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::has_object_type(unsigned int object_type) const noexcept
 {
       return e_type == object_type;
 }
 
-unsigned int elf32_bfd_t::get_machine_type() const noexcept
+template<unsigned int Class>
+unsigned int elfxx_bfd_t<Class>::get_machine_type() const noexcept
 {
       return e_machine;
 }
 
-bool  elf32_bfd_t::has_machine_type(unsigned int machine_type) const noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::has_machine_type(unsigned int machine_type) const noexcept
 {
       return e_machine == machine_type;
 }
 
-bool  elf32_bfd_t::is_valid() const noexcept
+template<unsigned int Class>
+bool  elfxx_bfd_t<Class>::is_valid() const noexcept
 {
       return m_elf_bit;
 }
@@ -471,7 +527,8 @@ void  dbg_dump_shdr() noexcept
 
 }
 
-void  dbg_dump_shdr(Elf32_Shdr& shdr, int index, bool show_header, bool show_data) noexcept
+template<typename Xt>
+void  dbg_dump_shdr(Xt& shdr, int index, bool show_header, bool show_data) noexcept
 {
       char l_index_cache[16];
       if(index >= 0) {
@@ -486,17 +543,20 @@ void  dbg_dump_shdr(Elf32_Shdr& shdr, int index, bool show_header, bool show_dat
               l_index_cache,
               shdr.sh_name,
               shdr.sh_type,
-              shdr.sh_flags,
-              shdr.sh_addr,
-              shdr.sh_offset,
-              shdr.sh_size,
+              static_cast<int>(shdr.sh_flags),
+              static_cast<int>(shdr.sh_addr),
+              static_cast<int>(shdr.sh_offset),
+              static_cast<int>(shdr.sh_size),
               shdr.sh_link,
               shdr.sh_info,
-              shdr.sh_addralign,
-              shdr.sh_entsize,
+              static_cast<int>(shdr.sh_addralign),
+              static_cast<int>(shdr.sh_entsize),
               shdr.sh_link
           );
       }
 }
 
+template class elfxx_bfd_t<bin_32>;
+template class elfxx_bfd_t<bin_64>;
+
 /*namespace uld*/ }
@@ -0,0 +1,182 @@
+#ifndef uld_bfd_elfxx_h
+#define uld_bfd_elfxx_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bin.h"
+#include <elf.h>
+
+namespace uld {
+
+/* elf_class_t
+   types and accessors of the ELF objects of a class, 32 or 64 bit (see `bin_32`, `bin_64`), for the decoder and the
+   factories to be written once for both
+*/
+template<unsigned int Class>
+struct elf_class_t;
+
+template<>
+struct elf_class_t<bin_32>
+{
+  using ehdr_type = Elf32_Ehdr;
+  using shdr_type = Elf32_Shdr;
+  using sym_type  = Elf32_Sym;
+  using rel_type  = Elf32_Rel;
+  using rela_type = Elf32_Rela;
+  using addr_type = Elf32_Addr;
+  using off_type  = Elf32_Off;
+
+  static  constexpr unsigned int get_rel_type(Elf32_Word info) noexcept {
+          return ELF32_R_TYPE(info);
+  }
+
+  static  constexpr unsigned int get_rel_symbol(Elf32_Word info) noexcept {
+          return ELF32_R_SYM(info);
+  }
+
+  static  constexpr unsigned int get_sym_type(unsigned char info) noexcept {
+          return ELF32_ST_TYPE(info);
+  }
+
+  static  constexpr unsigned int get_sym_bind(unsigned char info) noexcept {
+          return ELF32_ST_BIND(info);
+  }
+
+  static  constexpr unsigned int get_sym_visibility(unsigned char other) noexcept {
+          return ELF32_ST_VISIBILITY(other);
+  }
+};
+
+template<>
+struct elf_class_t<bin_64>
+{
+  using ehdr_type = Elf64_Ehdr;
+  using shdr_type = Elf64_Shdr;
+  using sym_type  = Elf64_Sym;
+  using rel_type  = Elf64_Rel;
+  using rela_type = Elf64_Rela;
+  using addr_type = Elf64_Addr;
+  using off_type  = Elf64_Off;
+
+  static  constexpr unsigned int get_rel_type(Elf64_Xword info) noexcept {
+          return ELF64_R_TYPE(info);
+  }
+
+  static  constexpr unsigned int get_rel_symbol(Elf64_Xword info) noexcept {
+          return ELF64_R_SYM(info);
+  }
+
+  static  constexpr unsigned int get_sym_type(unsigned char info) noexcept {
+          return ELF64_ST_TYPE(info);
+  }
+
+  static  constexpr unsigned int get_sym_bind(unsigned char info) noexcept {
+          return ELF64_ST_BIND(info);
+  }
+
+  static  constexpr unsigned int get_sym_visibility(unsigned char other) noexcept {
+          return ELF64_ST_VISIBILITY(other);
+  }
+};
+
+/* elfxx_bfd_t
+   decoder for the ELF objects of a class; the ELF32 and ELF64 decoders only differ by the layout of their headers and
+   tables, which `elf_class_t` gives
+*/
+template<unsigned int Class>
+class elfxx_bfd_t: public bin_bfd_t
+{
+  public:
+  using   class_type = elf_class_t<Class>;
+  using   ehdr_type = typename class_type::ehdr_type;
+  using   shdr_type = typename class_type::shdr_type;
+  using   sym_type  = typename class_type::sym_type;
+  using   rel_type  = typename class_type::rel_type;
+  using   rela_type = typename class_type::rela_type;
+  using   addr_type = typename class_type::addr_type;
+  using   off_type  = typename class_type::off_type;
+
+  private:
+  data_cache_t  m_str_cache;            // cache for the string table(s)
+  int           m_str_section;
+  int           m_str_offset;           // offset of the string table within the file
+  int           m_str_size;             // size of the string table
+  data_cache_t  m_shdr_cache;           // cache for the section header table
+  data_cache_t  m_data_cache;           // cache for general purpose section data
+
+  public:
+  unsigned short int e_type;            // object file type
+  unsigned short int e_machine;         // architecture
+  unsigned int       e_version;         // object file version
+
+  addr_type     e_entry;                // entry point virtual address
+  off_type      e_phoff;                // program header table file offset
+  off_type      e_shoff;                // section header table file offset
+  unsigned int  e_flags;                // processor-specific flags
+  int           e_ehsize;               // ELF header size in bytes
+  int           e_phentsize;            // program header table entry size
+  int           e_phnum;                // program header table entry count
+  int           e_shentsize;            // section header table entry size
+  int           e_shnum;                // section header table entry count
+  int           e_shstrndx;             // section header string table index
+
+  private:
+          bool  ids_str_load(int) noexcept;
+          bool  ids_str_get(int, int, const char*&, int&) noexcept;
+
+  public:
+          elfxx_bfd_t(bin_bfd_t&) noexcept;
+          elfxx_bfd_t(const elfxx_bfd_t&) noexcept = delete;
+          elfxx_bfd_t(elfxx_bfd_t&&) noexcept = delete;
+          ~elfxx_bfd_t() noexcept;
+
+          unsigned int get_object_type() const noexcept;
+          bool    has_object_type(unsigned int) const noexcept;
+          unsigned int get_machine_type() const noexcept;
+          bool    has_machine_type(unsigned int) const noexcept;
+
+          bool    read_section_info(shdr_type&, int) noexcept;
+          bool    read_section_name(shdr_type&, const char*&, int&) noexcept;
+          bool    read_section_data(shdr_type&, std::uint8_t*&, int) noexcept;
+          bool    read_section_at(shdr_type&, int, std::uint8_t*&, int) noexcept;
+          bool    copy_section_data(shdr_type&, std::uint8_t*, int) noexcept;
+          bool    copy_section_at(shdr_type&, int, std::uint8_t*, int) noexcept;
+          int     get_section_count() noexcept;
+          bool    read_symbol_info(sym_type&, shdr_type&, int) noexcept;
+          bool    read_symbol_name(sym_type&, shdr_type&, const char*&, int&) noexcept;
+          int     get_symbol_count(shdr_type&) noexcept;
+          bool    read_rel_info(rel_type&, shdr_type&, int) noexcept;
+          int     get_rel_count(shdr_type&) noexcept;
+          bool    read_rela_info(rela_type&, shdr_type&, int) noexcept;
+          int     get_rela_count(shdr_type&) noexcept;
+
+          bool    is_valid() const noexcept;
+    
+                  operator bool() const noexcept;
+          elfxx_bfd_t&  operator=(const elfxx_bfd_t&) = delete;
+          elfxx_bfd_t&  operator=(elfxx_bfd_t&&) = delete;
+};
+
+extern template class elfxx_bfd_t<bin_32>;
+extern template class elfxx_bfd_t<bin_64>;
+
+/*namespace uld*/ }
+#endif
@@ -20,6 +20,8 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "raw.h"
+#include <stats.h>
+#include <trace.h>
 #include <elf.h>
 #include <ar.h>
 #include <log.h>
@@ -41,10 +43,13 @@ namespace uld {
           // seek to the specified file position, if we are in an archive
           if(m_file_offset != 0) {
               l_rc = f_lseek(l_file_ptr, m_file_offset);
+              stats::on_seek();
           }
           // read the file magic
+          trace::on_file_read(static_cast<FIL*>(l_file_ptr), m_file_offset, SARMAG);
           if(l_rc = f_read(l_file_ptr, l_magic, SARMAG, std::addressof(l_read_size));
               l_rc == FR_OK) {
+              stats::on_read(l_read_size);
               if(l_magic[0] == ARMAG[0]) {
                   if(std::strncmp(l_magic, ARMAG, SARMAG) == 0) {
                       m_type = file_type_archive;
@@ -82,6 +87,7 @@ namespace uld {
       m_file_offset(source.m_file_offset)
 {
       FRESULT l_rc = f_lseek(m_file_ptr, m_file_offset);
+      stats::on_seek();
       if(l_rc != FR_OK) {
           printdbg(
               "File error: %s",
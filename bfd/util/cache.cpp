@@ -20,6 +20,8 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "cache.h"
+#include <stats.h>
+#include <trace.h>
 #include <util.h>
 #include <log.h>
 #include <cstring>
@@ -41,11 +43,13 @@ namespace util {
       m_data_size(0),
       m_lock_count(0)
 {
+      trace::on_cache_make(this, static_cast<FIL*>(m_file_ptr), reserve_size);
       reserve(reserve_size);
 }
 
       data_cache_t::~data_cache_t()
 {
+      trace::on_cache_free(this);
       if(m_data_ptr != nullptr) {
           free(m_data_ptr);
       }
@@ -56,6 +60,7 @@ namespace util {
 */
 int   data_cache_t::ids_fetch(std::size_t count) noexcept
 {
+      trace::on_cache_fetch(this, count);
       if(int
           l_load_size = static_cast<int>(count);
           l_load_size > 0) {
@@ -66,6 +71,7 @@ int   data_cache_t::ids_fetch(std::size_t count) noexcept
           // fetch the data, if we don't have all of it already
           if(l_over_size > 0) {
               int  l_keep_size = m_read_size - m_data_index;
+              stats::on_cache_miss();
               // optimize seeks and loads;
               // when in lock mode, we are allowed to resize the buffer but not change any file- or internal offsets
               // NOTE: could be smarter about this, but for now, when we overflow let's just keep only as much data as to
@@ -95,6 +101,7 @@ int   data_cache_t::ids_fetch(std::size_t count) noexcept
               }
               // go to the appropriate position within the file
               unsigned int l_read_size;
+              stats::on_seek();
               if(FRESULT
                   l_rc = f_lseek(m_file_ptr, m_read_offset + l_keep_size);
                   l_rc != FR_OK) {
@@ -110,9 +117,11 @@ int   data_cache_t::ids_fetch(std::size_t count) noexcept
                   l_rc != FR_OK) {
                   return -1;
               }
+              stats::on_read(l_read_size);
               m_read_size = l_keep_size + l_read_size;
               return l_read_size;
           }
+          stats::on_cache_hit();
       }
       return count;
 }
@@ -149,6 +158,7 @@ int   data_cache_t::seek(int position) noexcept
 {
       int l_file_offset = position;
       int l_diff_offset = l_file_offset - m_read_offset;
+      trace::on_cache_seek(this, position);
       // plainly refuse to seek if locked
       if(m_lock_count == 0) {
           // new file offset points inside our buffer: just advance the internal offset
@@ -160,6 +170,8 @@ int   data_cache_t::seek(int position) noexcept
           }
           // new file offset points outside the boundaries of our internally read data, reset the buffer
           FRESULT  l_rc = f_lseek(m_file_ptr, position);
+          stats::on_seek();
+          stats::on_cache_refill();
           if(l_rc == FR_OK) {
               m_read_offset = position;
               m_data_index  = 0;
@@ -179,6 +191,7 @@ bool  data_cache_t::acquire(int& save_offset) noexcept
       if(__builtin_expect(m_lock_count < ids_lock_max, true)) {
           save_offset = m_data_index;
           ++m_lock_count;
+          trace::on_cache_lock(this);
           return true;
       }
       printdbg(
@@ -202,6 +215,7 @@ char* data_cache_t::release(int& save_offset) noexcept
           return nullptr;
       }
       --m_lock_count;
+      trace::on_cache_unlock(this);
       return reinterpret_cast<char*>(m_data_ptr + save_offset);
 }
 
@@ -219,6 +233,7 @@ bool  data_cache_t::release(int& save_offset, char* return_ptr) noexcept
       }
       return_ptr = reinterpret_cast<char*>(m_data_ptr + save_offset);
       --m_lock_count;
+      trace::on_cache_unlock(this);
       return true;
 }
 
@@ -236,6 +251,7 @@ bool  data_cache_t::release(int& save_offset, std::uint8_t* return_ptr) noexcept
       }
       return_ptr = m_data_ptr + save_offset;
       --m_lock_count;
+      trace::on_cache_unlock(this);
       return true;
 }
 
@@ -36,6 +36,20 @@ constexpr Xt    b_se(Xt value, int bits) noexcept {
       return b_ret;
 }
 
+/* b_int32()
+   truncate a native address to a 32 bit target word; on 32 bit hosts this is an identity
+*/
+constexpr std::int32_t b_int32(std::uint8_t* address) noexcept {
+      return static_cast<std::int32_t>(reinterpret_cast<std::intptr_t>(address));
+}
+
+/* b_int64()
+   a native address as a 64 bit target word
+*/
+constexpr std::int64_t b_int64(std::uint8_t* address) noexcept {
+      return static_cast<std::int64_t>(reinterpret_cast<std::intptr_t>(address));
+}
+
 /* b_can_reach()
    check if a certain address is reachable relative to a base adress, within the specified number of bits
 */
@@ -0,0 +1,85 @@
+#ifndef uld_bits_x86_h
+#define uld_bits_x86_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "common.h"
+
+namespace uld {
+
+/* b_x86_get32()
+*/
+constexpr void  b_x86_get32(std::uint8_t* p, std::int32_t& value) noexcept
+{
+      value = p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+}
+
+/* b_x86_set32()
+*/
+constexpr void  b_x86_set32(std::uint8_t* p, std::int32_t value) noexcept
+{
+      p[0] = value & 0x000000ff;
+      p[1] =(value & 0x0000ff00) >> 8;
+      p[2] =(value & 0x00ff0000) >> 16;
+      p[3] =(value & 0xff000000) >> 24;
+}
+
+/* b_x86_get64()
+*/
+constexpr void  b_x86_get64(std::uint8_t* p, std::int64_t& value) noexcept
+{
+      std::uint64_t l_value = 0;
+      for(int i_byte = 7; i_byte >= 0; i_byte--) {
+          l_value = (l_value << 8) | p[i_byte];
+      }
+      value = static_cast<std::int64_t>(l_value);
+}
+
+/* b_x86_set64()
+*/
+constexpr void  b_x86_set64(std::uint8_t* p, std::int64_t value) noexcept
+{
+      std::uint64_t l_value = static_cast<std::uint64_t>(value);
+      for(int i_byte = 0; i_byte < 8; i_byte++) {
+          p[i_byte] = l_value & 0xff;
+          l_value >>= 8;
+      }
+}
+
+/* b_x86_fits32s()
+   check if a value survives being truncated to 32 bits and sign-extended back, as rip-relative displacements and the
+   operands of R_X86_64_32S are
+*/
+constexpr bool  b_x86_fits32s(std::int64_t value) noexcept
+{
+      return (value >= INT32_MIN) && (value <= INT32_MAX);
+}
+
+/* b_x86_fits32()
+   check if a value survives being truncated to 32 bits and zero-extended back, as the operands of R_X86_64_32 are
+*/
+constexpr bool  b_x86_fits32(std::int64_t value) noexcept
+{
+      return (value >= 0) && (value <= UINT32_MAX);
+}
+
+/*namespace uld*/ }
+#endif
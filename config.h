@@ -25,16 +25,47 @@
 
 namespace uld {
 
-/* page_size
-   granularity of the segment allocation routines;
-   a segment will be at least `page_size` bytes and will grow by the same amount when it's necessary
+/* page_size, page_size_max
+   default size of the first page of a pool; each new page is twice the size of the previous one, up to `page_size_max`,
+   unless the pool was asked to reserve more (see `pool::reserve()`)
 */
 constexpr int page_size = 1024;
+constexpr int page_size_max = 16384;
 
 /* section_name_max
    maximum section name length [[not yet used]]
 */
 constexpr int section_name_max = 32;
 
+/* load_stats_enable
+   collect load statistics (see `image::get_load_stats()`); turned on by building with ULD_LOAD_STATS defined, all the
+   collection code compiles away otherwise
+*/
+#ifdef ULD_LOAD_STATS
+constexpr bool load_stats_enable = true;
+#else
+constexpr bool load_stats_enable = false;
+#endif
+
+/* io_trace_enable
+   report the file accesses of the loader to an `io_trace_t` (see trace.h); turned on by building with ULD_IO_TRACE
+   defined, all the tracing code compiles away otherwise
+*/
+#ifdef ULD_IO_TRACE
+constexpr bool io_trace_enable = true;
+#else
+constexpr bool io_trace_enable = false;
+#endif
+
+/* profile_enable
+   build the sampling profiler in (see profile.h); turned on by building with ULD_PROFILE defined, the profiler neither
+   samples nor allocates otherwise, and its timer code compiles away
+*/
+#ifdef ULD_PROFILE
+constexpr bool profile_enable = true;
+#else
+constexpr bool profile_enable = false;
+#endif
+
 /*namespace uld*/ }
 #endif
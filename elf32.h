@@ -21,68 +21,41 @@
     CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
-#include <uld.h>
-#include "image/data.h"
-#include "image/string_table.h"
-#include "image/symbol_table.h"
-#include <elf.h>
-#include <vector>
+#include "elfxx.h"
 
 namespace uld {
 namespace elf32 {
 
-class factory
+class factory: public elfxx::factory<bin_32>
 {
-  image*  m_image;
-  target* m_target;
-
-  string_table_t          m_string_pool;  // local string cache
-  symbol_table_t          m_symbol_pool;  // local symbol cache
-
-  std::vector<section_t>  m_shdr_map;
-  std::vector<symbol_t*>  m_symbol_map;
-  std::vector<binding_t>  m_bind_list;
-
-  int     m_shdr_count;
-  bool    m_shdr_have_code;
-  bool    m_shdr_have_data;
-  bool    m_shdr_have_symtab;
-  bool    m_shdr_have_rel;
+  list_t<binding_t>       m_bind_list;
 
   private:
-          auto   uld_get_local_section(int) noexcept -> section_t*;
-          auto   uld_get_local_section(symbol_t*, int* = nullptr) noexcept -> section_t*;
-          auto   uld_get_local_symbol(int) noexcept -> symbol_t*;
+          using  elfxx::factory<bin_32>::uld_get_virtual_address;
           auto   uld_get_global_address(symbol_t*) noexcept -> std::uint8_t*;
           auto   uld_get_symbol_address(symbol_t*) noexcept -> std::uint8_t*;
           auto   uld_get_symbol_address(symbol_t*, std::int32_t) noexcept -> std::uint8_t*;
-          auto   uld_get_virtual_address(symbol_t*) noexcept -> std::uint8_t*;
           auto   uld_get_virtual_address(symbol_t*, std::int32_t) noexcept -> std::uint8_t*;
           auto   uld_get_base_address(symbol_t*) noexcept -> std::uint8_t*;
+          auto   uld_get_branch_address(symbol_t*, std::uint8_t*, int) noexcept -> std::uint8_t*;
 
-          auto   uld_get_section_data(elf32_bfd_t&, Elf32_Shdr&, int, std::int32_t, std::int32_t) noexcept -> std::uint8_t*;
-          auto   uld_get_section_data(elf32_bfd_t&, int, std::int32_t, std::int32_t) noexcept -> std::uint8_t*;
-          bool   uld_load_section(elf32_bfd_t&, Elf32_Shdr&, int) noexcept;
-          bool   uld_load_section(elf32_bfd_t&, Elf32_Shdr&, int, std::int32_t, std::int32_t) noexcept;
-          bool   uld_load_symbol(elf32_bfd_t&, Elf32_Shdr&, Elf32_Sym&, int) noexcept;
-          bool   uld_resolve_rel(elf32_bfd_t&, Elf32_Shdr&, Elf32_Rel&, std::int32_t = 0) noexcept;
-          bool   uld_resolve_rela(elf32_bfd_t&, Elf32_Shdr&, Elf32_Rela&) noexcept;
-          bool   uld_import(elf32_bfd_t&) noexcept;
-          bool   uld_resolve(elf32_bfd_t&) noexcept;
-          bool   uld_export() noexcept;
+          bool   uld_load_section(bfd_type&, Elf32_Shdr&, int) noexcept;
+          bool   uld_load_section(bfd_type&, Elf32_Shdr&, int, std::int32_t, std::int32_t) noexcept;
+          bool   uld_resolve_rel(bfd_type&, Elf32_Shdr&, Elf32_Rel&, std::int32_t = 0) noexcept;
+          bool   uld_resolve_rela(bfd_type&, Elf32_Shdr&, Elf32_Rela&) noexcept;
           bool   uld_revert() noexcept;
-          bool   uld_error(int, const char*, const char*, int, ...) noexcept;
           void   uld_clear() noexcept;
 
+  virtual void   uld_bind_symbol(int, int, std::int32_t, std::int32_t) noexcept override;
+  virtual bool   uld_resolve(bfd_type&) noexcept override;
+  virtual bool   uld_apply_rel(int, std::uint8_t*, symbol_t*) noexcept override;
+
   public:
-          factory(image*) noexcept;
+          factory(image*, string_table_t*, symbol_table_t*, symbol_table_t*, symbol_index_t*, allocator_t* = nullptr) noexcept;
           factory(const factory&) noexcept = delete;
           factory(factory&&) noexcept = delete;
           ~factory();
 
-          bool     prefetch(elf32_bfd_t&) noexcept;
-          bool     collect(elf32_bfd_t&) noexcept;
-
           factory& operator=(const factory&) noexcept = delete;
           factory& operator=(factory&&) noexcept = delete;
 };
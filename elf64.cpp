@@ -20,8 +20,403 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "elf64.h"
+#include "target.h"
+#include "image.h"
+#include "error.h"
+#include "stats.h"
+#include <log.h>
+#include "bits/x86.h"
+#include "image/hash.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdarg>
+#include <elf.h>
+#include <dbg.h>
+
+static constexpr int stub_size = 16;              // size of a GOT slot, along with the jump through it
+static constexpr int stub_align = 3;              // alignment of the GOT slots, as a power of 2
+static constexpr int stub_jump_offset = 8;        // offset of the jump within a GOT slot
+
+// jmp *-14(%rip), to the address the GOT slot begins with, padded with int3
+static constexpr std::uint8_t stub_jump_code[] = {0xff, 0x25, 0xf2, 0xff, 0xff, 0xff, 0xcc, 0xcc};
 
 namespace uld {
 namespace elf64 {
+
+      factory::factory(
+          image*          image_ptr,
+          string_table_t* string_pool,
+          symbol_table_t* symbol_pool,
+          symbol_table_t* export_pool,
+          symbol_index_t* symbol_index,
+          allocator_t*    allocator
+      ) noexcept:
+      elfxx::factory<bin_64>(image_ptr, string_pool, symbol_pool, export_pool, symbol_index, allocator),
+      m_stub_list(m_shdr_map.get_allocator()),
+      m_stub_segment(nullptr)
+{
+}
+
+      factory::~factory()
+{
+}
+
+/* uld_is_stub_less()
+   order of the GOT slots, by symbol
+*/
+bool  factory::uld_is_stub_less(const stub_t& lhs, const symbol_t* rhs) noexcept
+{
+      return lhs.symbol < rhs;
+}
+
+/* uld_get_stub()
+   GOT slot of a symbol, made upon first use within the code segment of the image: the address of the symbol, followed
+   by a jump through it, which the calls a rel32 can't take to the symbol are sent to instead
+*/
+auto  factory::uld_get_stub(symbol_t* symbol_ptr) noexcept -> std::uint8_t*
+{
+      auto i_stub = std::lower_bound(m_stub_list.begin(), m_stub_list.end(), symbol_ptr, uld_is_stub_less);
+      if((i_stub != m_stub_list.end()) &&
+          (i_stub->symbol == symbol_ptr)) {
+          return i_stub->code;
+      }
+      if(m_stub_segment == nullptr) {
+          m_stub_segment = m_image->get_segment_by_section(
+              m_target->get_segment_name(target::smt::text),
+              section_t::type_progbits,
+              section_t::data_alloc | section_t::data_execute
+          );
+          if(m_stub_segment == nullptr) {
+              uld_error(
+                  e_fault,
+                  "Unable to make a GOT slot for symbol `%s`: no code segment found.",
+                  __FILE__,
+                  __LINE__,
+                  symbol_ptr != nullptr ? symbol_ptr->name : ""
+              );
+              return nullptr;
+          }
+      }
+      int           l_pad_size = 0;
+      std::uint8_t* l_stub_ptr = m_stub_segment->raw_get(stub_size, stub_align, l_pad_size);
+      if(l_stub_ptr == nullptr) {
+          uld_error(
+              e_memory,
+              "Unable to make a GOT slot for symbol `%s`: memory allocation error.",
+              __FILE__,
+              __LINE__,
+              symbol_ptr != nullptr ? symbol_ptr->name : ""
+          );
+          return nullptr;
+      }
+      b_x86_set64(l_stub_ptr, b_int64(uld_get_virtual_address(symbol_ptr)));
+      std::memcpy(l_stub_ptr + stub_jump_offset, stub_jump_code, sizeof(stub_jump_code));
+      m_stub_list.insert(i_stub, stub_t{symbol_ptr, l_stub_ptr});
+      return l_stub_ptr;
+}
+
+/* uld_resolve_rela()
+   relocate the section data at `data_ptr` as told by a RELA entry; the addend goes into the relocated field, as it would
+   with a REL entry, such that the relocation reads the same whether applied right away or deferred to a fixup
+*/
+bool  factory::uld_resolve_rela(bfd_type& bi, Elf64_Rela& rela_info, std::uint8_t* data_ptr, std::int64_t data_size) noexcept
+{
+      int  l_rel_sym = ELF64_R_SYM(rela_info.r_info);
+      int  l_rel_type = ELF64_R_TYPE(rela_info.r_info);
+      int  l_rel_size = 4;
+      if(l_rel_type == R_X86_64_NONE) {
+          return true;
+      }
+      if((l_rel_type == R_X86_64_64) ||
+          (l_rel_type == R_X86_64_PC64)) {
+          l_rel_size = 8;
+      }
+      if(rela_info.r_offset + l_rel_size > static_cast<std::uint64_t>(data_size)) {
+          uld_error(
+              e_access,
+              "Unable to perform relocation: offset %lx is out of the section.",
+              __FILE__,
+              __LINE__,
+              static_cast<unsigned long int>(rela_info.r_offset)
+          );
+          return false;
+      }
+      if((l_rel_size == 4) &&
+          (b_x86_fits32s(rela_info.r_addend) == false)) {
+          uld_error(
+              e_norel,
+              "Unable to perform relocation %d: addend %ld does not fit in its field.",
+              __FILE__,
+              __LINE__,
+              l_rel_type,
+              static_cast<long int>(rela_info.r_addend)
+          );
+          return false;
+      }
+      // load and check the symbol being invoked in the relocation
+      symbol_t*  l_src_sym = uld_get_local_symbol(l_rel_sym);
+      if(l_rel_sym > 0) {
+          if(l_src_sym == nullptr) {
+              uld_error(
+                  e_nosym,
+                  "Unable to perform relocation: source symbol index `%d` unavailable.",
+                  __FILE__,
+                  __LINE__,
+                  l_rel_sym
+              );
+              return false;
+          }
+      }
+      // a section referenced by its symbol only may not have been loaded yet
+      int  l_src_index;
+      if(section_t*
+          l_src_section = uld_get_local_section(l_src_sym, std::addressof(l_src_index));
+          l_src_section != nullptr) {
+          if((l_src_section->support != nullptr) &&
+              (l_src_section->offset_last == l_src_section->offset_base)) {
+              if(uld_get_section_data(bi, l_src_index, 0, 0) == nullptr) {
+                  return false;
+              }
+          }
+      }
+      // address where the relocation applies
+      std::uint8_t*  l_rel_ptr = data_ptr + rela_info.r_offset;
+      if(l_rel_size == 8) {
+          b_x86_set64(l_rel_ptr, rela_info.r_addend);
+      } else
+          b_x86_set32(l_rel_ptr, rela_info.r_addend);
+      // relocations against symbols that are not yet defined within the image are deferred until a later load defines
+      // them
+      if(uld_is_pending(l_src_sym)) {
+          fixup_t& l_fixup_info = m_fixup_list.emplace_back();
+          l_fixup_info.symbol = l_src_sym;
+          l_fixup_info.address = l_rel_ptr;
+          l_fixup_info.type = l_rel_type;
+          return true;
+      }
+      return uld_apply_rel(l_rel_type, l_rel_ptr, l_src_sym);
+}
+
+/* uld_apply_rel()
+   apply a relocation of the given type at `address`, against the symbol pointed to by `symbol_ptr`
+*/
+bool  factory::uld_apply_rel(int type, std::uint8_t* address, symbol_t* symbol_ptr) noexcept
+{
+      // relocation variables, as named on the "System V Application Binary Interface, AMD64 Architecture Processor
+      // Supplement", for ease of implementation
+      std::int64_t   s;     // symbol address
+      std::int64_t   l;     // address of the PLT entry of the symbol 's': the symbol itself if within reach
+      std::int64_t   g;     // address of the GOT entry of the symbol 's'
+      std::int64_t   a;     // addend
+      std::int32_t   a32;
+      // address where the relocation applies
+      std::uint8_t*  p = address;
+      const char*    l_sym_name = symbol_ptr != nullptr ? symbol_ptr->name : "";
+      if constexpr (os::is_lsb) {
+          switch(type) {
+            case R_X86_64_NONE:
+                break;
+            case R_X86_64_64:
+                b_x86_get64(p, a);
+                s = b_int64(uld_get_virtual_address(symbol_ptr));
+                b_x86_set64(p, s + a);
+                break;
+            case R_X86_64_PC64:
+                b_x86_get64(p, a);
+                s = b_int64(uld_get_virtual_address(symbol_ptr));
+                b_x86_set64(p, s + a - b_int64(p));
+                break;
+            case R_X86_64_PC32:
+                b_x86_get32(p, a32);
+                a = a32;
+                s = b_int64(uld_get_virtual_address(symbol_ptr));
+                if(b_x86_fits32s(s + a - b_int64(p)) == false) {
+                    uld_error(
+                        e_noreach,
+                        "Address %lx for the relocation R_X86_64_PC32:%p is not reachable.",
+                        __FILE__,
+                        __LINE__,
+                        static_cast<unsigned long int>(s + a),
+                        p
+                    );
+                    return false;
+                }
+                b_x86_set32(p, s + a - b_int64(p));
+                break;
+            case R_X86_64_PLT32:
+                // calls out of reach go through the jump of the GOT slot of the symbol
+                b_x86_get32(p, a32);
+                a = a32;
+                l = b_int64(uld_get_virtual_address(symbol_ptr));
+                if(b_x86_fits32s(l + a - b_int64(p)) == false) {
+                    std::uint8_t* l_stub_ptr = uld_get_stub(symbol_ptr);
+                    if(l_stub_ptr == nullptr) {
+                        return false;
+                    }
+                    l = b_int64(l_stub_ptr + stub_jump_offset);
+                    if(b_x86_fits32s(l + a - b_int64(p)) == false) {
+                        uld_error(
+                            e_noreach,
+                            "Address %lx for the relocation R_X86_64_PLT32:%p is not reachable.",
+                            __FILE__,
+                            __LINE__,
+                            static_cast<unsigned long int>(l + a),
+                            p
+                        );
+                        return false;
+                    }
+                }
+                b_x86_set32(p, l + a - b_int64(p));
+                break;
+            case R_X86_64_GOTPCRELX:
+            case R_X86_64_REX_GOTPCRELX:
+                // `mov foo@GOTPCREL(%rip), %reg` loads the address the GOT slot holds: with the symbol within reach,
+                // `lea foo(%rip), %reg` gets the same without a slot
+                b_x86_get32(p, a32);
+                a = a32;
+                s = b_int64(uld_get_virtual_address(symbol_ptr));
+                if((p[-2] == 0x8b) &&
+                    (s != 0) &&
+                    (b_x86_fits32s(s + a - b_int64(p)))) {
+                    p[-2] = 0x8d;
+                    b_x86_set32(p, s + a - b_int64(p));
+                    break;
+                }
+                [[fallthrough]];
+            case R_X86_64_GOTPCREL:
+                b_x86_get32(p, a32);
+                a = a32;
+                if(std::uint8_t*
+                    l_stub_ptr = uld_get_stub(symbol_ptr);
+                    l_stub_ptr != nullptr) {
+                    g = b_int64(l_stub_ptr);
+                } else
+                    return false;
+                if(b_x86_fits32s(g + a - b_int64(p)) == false) {
+                    uld_error(
+                        e_noreach,
+                        "GOT slot %lx for the relocation R_X86_64_GOTPCREL:%p is not reachable.",
+                        __FILE__,
+                        __LINE__,
+                        static_cast<unsigned long int>(g),
+                        p
+                    );
+                    return false;
+                }
+                b_x86_set32(p, g + a - b_int64(p));
+                break;
+            case R_X86_64_32:
+                b_x86_get32(p, a32);
+                a = a32;
+                s = b_int64(uld_get_virtual_address(symbol_ptr));
+                if(b_x86_fits32(s + a) == false) {
+                    uld_error(
+                        e_noreach,
+                        "Address %lx for the relocation R_X86_64_32:%p is not reachable.",
+                        __FILE__,
+                        __LINE__,
+                        static_cast<unsigned long int>(s + a),
+                        p
+                    );
+                    return false;
+                }
+                b_x86_set32(p, s + a);
+                break;
+            case R_X86_64_32S:
+                b_x86_get32(p, a32);
+                a = a32;
+                s = b_int64(uld_get_virtual_address(symbol_ptr));
+                if(b_x86_fits32s(s + a) == false) {
+                    uld_error(
+                        e_noreach,
+                        "Address %lx for the relocation R_X86_64_32S:%p is not reachable.",
+                        __FILE__,
+                        __LINE__,
+                        static_cast<unsigned long int>(s + a),
+                        p
+                    );
+                    return false;
+                }
+                b_x86_set32(p, s + a);
+                break;
+            default:
+                uld_error(
+                    e_norel,
+                    "Unknown relocation type `%d` against symbol `%s`.",
+                    __FILE__,
+                    __LINE__,
+                    type,
+                    l_sym_name
+                );
+                return false;
+          };
+      } else
+      if constexpr (os::is_msb) {
+          uld_error(
+              e_invalid_host,
+              "Unable to perform relocations on a BIG ENDIAN host: not implemented.",
+              __FILE__,
+              __LINE__
+          );
+          return false;
+      }
+      stats::on_rel(type);
+      return true;
+}
+
+/* uld_resolve()
+   apply the relocation tables detected at the 'prefetch' step, each to the section its `sh_info` points to; the tables of
+   the sections the image doesn't load (i.e. the debug info) are skipped
+*/
+bool  factory::uld_resolve(bfd_type& bi) noexcept
+{
+      for(Elf64_Shdr& l_shdr_info : m_rel_list) {
+          // x86-64 objects carry no REL tables
+          if(l_shdr_info.sh_type != SHT_RELA) {
+              continue;
+          }
+          int         l_data_index = l_shdr_info.sh_info;
+          section_t*  l_data_section = uld_get_local_section(l_data_index);
+          Elf64_Shdr  l_data_info;
+          if((l_data_section == nullptr) ||
+              (l_data_section->support == nullptr)) {
+              continue;
+          }
+          if(bi.read_section_info(l_data_info, l_data_index) == false) {
+              uld_error(
+                  e_access,
+                  "Read error: Failed to fetch section header %d.",
+                  __FILE__,
+                  __LINE__,
+                  l_data_index
+              );
+              return false;
+          }
+          // a section holding no symbols may not have been loaded yet
+          std::uint8_t* l_data_ptr = uld_get_section_data(bi, l_data_info, l_data_index, 0, 0);
+          if(l_data_ptr == nullptr) {
+              return false;
+          }
+          int l_rela_count = bi.get_rela_count(l_shdr_info);
+          for(int l_rela_index = 0; l_rela_index < l_rela_count; l_rela_index++) {
+              Elf64_Rela l_rela_info;
+              if(bi.read_rela_info(l_rela_info, l_shdr_info, l_rela_index) == false) {
+                  uld_error(
+                      e_access,
+                      "Read error: Failed to fetch relocation %d.",
+                      __FILE__,
+                      __LINE__,
+                      l_rela_index
+                  );
+                  return false;
+              }
+              if(uld_resolve_rela(bi, l_rela_info, l_data_ptr, l_data_info.sh_size) == false) {
+                  return false;
+              }
+          }
+      }
+      return true;
+}
+
 /*namespace elf64*/ }
 /*namespace uld*/ }
@@ -21,12 +21,49 @@
     CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
-#include <uld.h>
-#include "image/data.h"
-#include <elf.h>
+#include "elfxx.h"
 
 namespace uld {
 namespace elf64 {
+
+/* factory
+   loader for x86-64 relocatable objects, for the images of a 64 bit host to load native code; the sections go wherever
+   the segment and region rules of the image send them, so that code only runs if those are executable (see
+   `map_allocator_t`)
+*/
+class factory: public elfxx::factory<bin_64>
+{
+  /* stub_t
+     GOT slot of a symbol, holding its address, followed by a jump through it, for the calls to reach a symbol a rel32
+     can't; the loader has no GOT of its own, it makes one such entry per symbol referenced through one
+  */
+  struct stub_t
+  {
+    symbol_t*     symbol;
+    std::uint8_t* code;
+  };
+
+  list_t<stub_t>          m_stub_list;    // GOT slots made so far, by symbol, see `uld_get_stub()`
+  segment*                m_stub_segment; // code segment of the image, where the GOT slots go
+
+  private:
+  static  bool   uld_is_stub_less(const stub_t&, const symbol_t*) noexcept;
+          auto   uld_get_stub(symbol_t*) noexcept -> std::uint8_t*;
+          bool   uld_resolve_rela(bfd_type&, Elf64_Rela&, std::uint8_t*, std::int64_t) noexcept;
+
+  virtual bool   uld_resolve(bfd_type&) noexcept override;
+  virtual bool   uld_apply_rel(int, std::uint8_t*, symbol_t*) noexcept override;
+
+  public:
+          factory(image*, string_table_t*, symbol_table_t*, symbol_table_t*, symbol_index_t*, allocator_t* = nullptr) noexcept;
+          factory(const factory&) noexcept = delete;
+          factory(factory&&) noexcept = delete;
+          ~factory();
+
+          factory& operator=(const factory&) noexcept = delete;
+          factory& operator=(factory&&) noexcept = delete;
+};
+
 /*namespace elf64*/ }
 /*namespace uld*/ }
 #endif
@@ -0,0 +1,1458 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "elfxx.h"
+#include "target.h"
+#include "image.h"
+#include "error.h"
+#include "stats.h"
+#include <log.h>
+#include "image/hash.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdarg>
+#include <elf.h>
+#include <dbg.h>
+
+static constexpr int place_rule_base = 0x01000000;  // ranks of the sections the segment rules place, behind the hot ones
+static constexpr int section_align_max = 12;      // largest section alignment supported, as a power of 2
+
+namespace uld {
+namespace elfxx {
+
+template<unsigned int Class>
+      factory<Class>::factory(
+          image*          image_ptr,
+          string_table_t* string_pool,
+          symbol_table_t* symbol_pool,
+          symbol_table_t* export_pool,
+          symbol_index_t* symbol_index,
+          allocator_t*    allocator
+      ) noexcept:
+      m_image(image_ptr),
+      m_target(image_ptr->get_target()),
+      m_string_pool(string_pool),
+      m_symbol_pool(symbol_pool),
+      m_export_pool(export_pool),
+      m_symbol_index(symbol_index),
+      m_shdr_map(allocator != nullptr ? allocator : get_heap_allocator()),
+      m_symtab_list(m_shdr_map.get_allocator()),
+      m_rel_list(m_shdr_map.get_allocator()),
+      m_symbol_map(m_shdr_map.get_allocator()),
+      m_fixup_list(m_shdr_map.get_allocator()),
+      m_place_list(m_shdr_map.get_allocator()),
+      m_shdr_count(0),
+      m_shdr_have_code(false),
+      m_shdr_have_data(false),
+      m_shdr_have_symtab(false),
+      m_shdr_have_rel(false)
+{
+}
+
+template<unsigned int Class>
+      factory<Class>::~factory()
+{
+}
+
+template<unsigned int Class>
+auto  factory<Class>::uld_get_local_section(int index) noexcept -> section_t*
+{
+      if(index > 0) {
+          if(index < static_cast<int>(m_shdr_map.size())) {
+              return std::addressof(m_shdr_map[index]);
+          }
+      }
+      return nullptr;
+}
+
+template<unsigned int Class>
+auto  factory<Class>::uld_get_local_section(symbol_t* symbol_ptr, int* index) noexcept -> section_t*
+{
+      if(symbol_ptr != nullptr) {
+          int  l_shdr_count = m_shdr_map.size();
+          if(l_shdr_count > 0) {
+              section_t*  l_shdr_base = std::addressof(m_shdr_map[0]);
+              section_t*  l_shdr_last = l_shdr_base + l_shdr_count - 1;
+              if((symbol_ptr >= l_shdr_base) &&
+                  (symbol_ptr <= l_shdr_last)) {
+                  section_t*  l_shdr_ptr = static_cast<section_t*>(symbol_ptr);
+                  if(index != nullptr) {
+                      *index = l_shdr_ptr - l_shdr_base;
+                  }
+                  return l_shdr_ptr;
+              }
+          }
+      }
+      if(index != nullptr) {
+          *index = 0;
+      }
+      return nullptr;
+}
+
+template<unsigned int Class>
+auto  factory<Class>::uld_get_local_symbol(int index) noexcept -> symbol_t*
+{
+      if(index > 0) {
+          if(index < static_cast<int>(m_symbol_map.size())) {
+              return m_symbol_map[index];
+          }
+      }
+      return nullptr;
+}
+
+template<unsigned int Class>
+auto  factory<Class>::uld_get_virtual_address(symbol_t* symbol_ptr) noexcept -> std::uint8_t*
+{
+      if(symbol_ptr != nullptr) {
+          // if symbol is a section we can't necessarily trust its 'ra' member: it's just the rollback address
+          if((symbol_ptr->type & symbol_t::type_section) == symbol_t::type_section) {
+              if(section_t*
+                  l_section_ptr = uld_get_local_section(symbol_ptr);
+                  l_section_ptr != nullptr) {
+                  if(l_section_ptr->offset_last == l_section_ptr->offset_base) {
+                      // this section has not been loaded yet
+                      uld_error(
+                          e_nosym,
+                          "Data for section `%s` is not available at runtime.",
+                          __FILE__,
+                          __LINE__,
+                          symbol_ptr->name
+                      );
+                      return nullptr;
+                  }
+                  return l_section_ptr->support->get_table_ptr(l_section_ptr->offset_base);
+              }
+              return nullptr;
+          }
+          return symbol_ptr->ra;
+      }
+      return nullptr;
+}
+
+/* uld_is_pending()
+   check if relocations against the given symbol need to be deferred (strong references, not yet defined in the image)
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_is_pending(symbol_t* symbol_ptr) noexcept
+{
+      if(symbol_ptr != nullptr) {
+          if((symbol_ptr->type & symbol_t::type_section) != symbol_t::type_section) {
+              if(symbol_ptr->ra == nullptr) {
+                  return (symbol_ptr->flags & symbol_t::bind_weak) == 0;
+              }
+          }
+      }
+      return false;
+}
+
+template<unsigned int Class>
+auto  factory<Class>::uld_get_section_data(bfd_type& bi, shdr_type& shdr_info, int shdr_index, std::int32_t data_offset, std::int32_t data_size) noexcept -> std::uint8_t*
+{
+      section_t* l_section_ptr = uld_get_local_section(shdr_index);
+      if(l_section_ptr != nullptr) {
+          segment*  l_segment_ptr = l_section_ptr->support;
+          if(l_segment_ptr == nullptr) {
+              uld_error(
+                  e_fault,
+                  "Unable to load data from section `%s`: no adequate segment found.",
+                  __FILE__,
+                  __LINE__,
+                  l_section_ptr->name
+              );
+              return nullptr;
+          }
+          std::int32_t l_offset_base = l_section_ptr->offset_base;
+          std::int32_t l_offset_last = l_section_ptr->offset_last;
+          std::int32_t l_extend_last;
+          int          l_align = -1;
+          if(l_offset_last == l_offset_base) {
+              // first access to this section: place the whole of it at the current end of the segment, since other
+              // sections mapped to the same segment (or of other objects in the same batch) may have grown it since
+              // prefetch(), at its own alignment rather than that of the segment
+              l_align = uld_get_section_align(shdr_info);
+              if(l_align < 0) {
+                  uld_error(
+                      e_fault,
+                      "Unable to load data from section `%s`: unsupported alignment of %u bytes.",
+                      __FILE__,
+                      __LINE__,
+                      l_section_ptr->name,
+                      static_cast<unsigned int>(shdr_info.sh_addralign)
+                  );
+                  return nullptr;
+              }
+              l_offset_base = l_segment_ptr->get_table_offset();
+              l_offset_last = l_offset_base;
+              l_section_ptr->offset_base = l_offset_base;
+              l_section_ptr->offset_last = l_offset_last;
+              if(static_cast<std::int32_t>(shdr_info.sh_size) > data_offset + data_size) {
+                  data_size = shdr_info.sh_size - data_offset;
+              }
+          }
+          l_extend_last = l_offset_base + data_offset + data_size;
+          if(l_extend_last > l_offset_last) {
+              std::int32_t  l_copy_pos;
+              std::int32_t  l_copy_size;
+              std::uint8_t* l_copy_ptr;
+              if(l_offset_base + data_offset < l_offset_last) {
+                  // we don't want this to happen because the segment allocation may cross pages and yield a non-contiguous
+                  // region
+                  uld_error(
+                      e_access,
+                      "Unable to load data from section `%s`: overlapping an existing data chunk [%.4x..%.4x].",
+                      __FILE__,
+                      __LINE__,
+                      l_section_ptr->name,
+                      data_offset,
+                      l_extend_last
+                  );
+                  return nullptr;
+              }
+              l_copy_pos  = l_offset_last - l_offset_base;
+              l_copy_size = l_extend_last - l_offset_last;
+              if(l_align >= 0) {
+                  int l_pad_size = 0;
+                  l_copy_ptr = l_segment_ptr->raw_get(l_copy_size, l_align, l_pad_size);
+                  if(l_copy_ptr != nullptr) {
+                      // the block may have been padded or have started a new page: the section begins at the block
+                      l_offset_base = l_segment_ptr->get_table_offset(l_copy_ptr);
+                      l_section_ptr->offset_base = l_offset_base;
+                      stats::on_align(l_pad_size, get_round_value(l_copy_size, 1 << l_segment_ptr->get_align()) - l_copy_size);
+                  }
+              } else
+                  l_copy_ptr = l_segment_ptr->raw_get(l_copy_size);
+              if(l_copy_ptr == nullptr) {
+                  uld_error(
+                      e_memory,
+                      "Unable to load data from section `%s`: memory allocation error.",
+                      __FILE__,
+                      __LINE__,
+                      l_section_ptr->name
+                  );
+                  return nullptr;
+              }
+              if(shdr_info.sh_type == SHT_NOBITS) {
+                  std::memset(l_copy_ptr, 0, l_copy_size);
+              } else
+              if(shdr_info.sh_type != SHT_NULL) {
+                  if(bool
+                      l_fetch_data_success = bi.copy_section_at(shdr_info, l_copy_pos, l_copy_ptr, l_copy_size);
+                      l_fetch_data_success == false) {
+                      uld_error(
+                          e_access,
+                          "Unable to load data from section `%s`: data acquisition error.",
+                          __FILE__,
+                          __LINE__,
+                          l_section_ptr->name
+                      );
+                      return nullptr;
+                  }
+              }
+              l_section_ptr->offset_last = l_section_ptr->support->get_table_offset();
+          }
+          return l_section_ptr->support->get_table_ptr(l_offset_base + data_offset);
+      }
+      return nullptr;
+}
+
+template<unsigned int Class>
+auto  factory<Class>::uld_get_section_data(bfd_type& bi, int shdr_index, std::int32_t data_offset, std::int32_t data_size) noexcept -> std::uint8_t*
+{
+      int  l_section_index = shdr_index;
+      auto l_section_ptr = uld_get_local_section(l_section_index);
+      if(l_section_ptr != nullptr) {
+          shdr_type  l_section_info;
+          if(bool
+              l_fetch_shdr_success = bi.read_section_info(l_section_info, l_section_index);
+              l_fetch_shdr_success == true) {
+              return uld_get_section_data(bi, l_section_info, l_section_index, data_offset, data_size);
+          }
+      }
+      return nullptr;
+}
+
+/* uld_is_hidden()
+   tell if a definition is to stay within its batch: hidden and internal ones do, as long as the image honors visibility
+   (see `image::load_strip_hidden`)
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_is_hidden(sym_type& sym_info) noexcept
+{
+      if(m_image->get_load_options() & image::load_strip_hidden) {
+          unsigned int l_sym_visibility = class_type::get_sym_visibility(sym_info.st_other);
+          if((l_sym_visibility == STV_HIDDEN) ||
+              (l_sym_visibility == STV_INTERNAL)) {
+              return true;
+          }
+      }
+      return false;
+}
+
+template<unsigned int Class>
+bool  factory<Class>::uld_load_symbol(bfd_type& bi, shdr_type& shdr_info, sym_type& sym_info, int sym_index) noexcept
+{
+      const char*  l_sym_name;
+      int          l_sym_name_length;
+      unsigned int l_sym_type = class_type::get_sym_type(sym_info.st_info);
+      unsigned int l_sym_bind = class_type::get_sym_bind(sym_info.st_info);
+      if(bool
+          l_fetch_name_success = bi.read_symbol_name(sym_info, shdr_info, l_sym_name, l_sym_name_length);
+          l_fetch_name_success == false) {
+          uld_error(
+              e_access,
+              "Read error: Failed to fetch symbol name.",
+              __FILE__,
+              __LINE__
+          );
+          return false;
+      }
+      m_symbol_map[sym_index] = nullptr;
+      if(l_sym_type == STT_NOTYPE) {
+          if(sym_info.st_shndx == SHN_UNDEF) {
+              // found an undefined symbol: reference it through the batch index, it will be bound at link time
+              if(sym_info.st_name != 0) {
+                  std::uint32_t l_sym_hash = get_name_hash(l_sym_name, l_sym_name_length);
+                  auto          l_slot_ptr = m_symbol_index->make_slot(l_sym_name, l_sym_hash);
+                  if(l_slot_ptr == nullptr) {
+                      uld_error(
+                          e_memory,
+                          "Failed to import symbol `%s`: out of memory.",
+                          __FILE__,
+                          __LINE__,
+                          l_sym_name
+                      );
+                      return false;
+                  }
+                  if(l_slot_ptr->symbol == nullptr) {
+                      // first reference to this name within the batch: create a placeholder for it
+                      l_slot_ptr->symbol = m_symbol_pool->make_symbol(
+                          l_sym_name,
+                          l_sym_name_length,
+                          l_sym_type,
+                          l_sym_bind
+                      );
+                      if(l_slot_ptr->symbol == nullptr) {
+                          uld_error(
+                              e_nodef,
+                              "Failed to import symbol `%s`: out of memory.",
+                              __FILE__,
+                              __LINE__,
+                              l_sym_name
+                          );
+                          return false;
+                      }
+                  } else
+                  if(l_slot_ptr->symbol->ra == nullptr) {
+                      // already referenced, but not defined: a strong reference makes the placeholder strong
+                      if(l_sym_bind == STB_GLOBAL) {
+                          l_slot_ptr->symbol->flags &= ~symbol_t::bind_bits;
+                          l_slot_ptr->symbol->flags |= symbol_t::bind_global;
+                      }
+                  }
+                  l_slot_ptr->symbol->flags |= symbol_t::bit_import;
+                  m_symbol_map[sym_index] = l_slot_ptr->symbol;
+              }
+          } else
+          if(sym_info.st_shndx < m_shdr_count) {
+              // found a local data chunk (i.e. a function-static buffer): store into the section it indicates
+              std::int32_t  l_sym_size = sym_info.st_size;
+              if(l_sym_size) {
+                  symbol_t* l_sym_ptr = m_symbol_pool->make_symbol(
+                      l_sym_name,
+                      l_sym_name_length,
+                      l_sym_type,
+                      l_sym_bind
+                  );
+                  if(l_sym_ptr == nullptr) {
+                      uld_error(
+                          e_nodef,
+                          "Failed to define symbol `%s`: out of memory.",
+                          __FILE__,
+                          __LINE__,
+                          l_sym_name
+                      );
+                      return false;
+                  }
+                  int           l_sym_shndx = sym_info.st_shndx;
+                  std::int32_t  l_sym_offset = sym_info.st_value;
+                  std::uint8_t* l_sym_data  = uld_get_section_data(bi, l_sym_shndx, l_sym_offset, l_sym_size);
+                  if(l_sym_data == nullptr) {
+                      uld_error(
+                          e_nodef,
+                          "Failed to define symbol `%s`.",
+                          __FILE__,
+                          __LINE__,
+                          l_sym_name
+                      );
+                      return false;
+                  }
+                  l_sym_ptr->ea = l_sym_data;
+                  l_sym_ptr->ra = l_sym_data;
+                  l_sym_ptr->size = l_sym_size;
+                  if constexpr (is_debug) {
+                      printf(
+                          "(i) Stored symbol `%s` at effective address %p\n",
+                          l_sym_ptr->name,
+                          l_sym_ptr->ea
+                      );
+                      dbg_dump_hex(l_sym_ptr->ea, l_sym_ptr->size, true);
+                  }
+                  m_symbol_map[sym_index] = l_sym_ptr;
+              }
+          } else
+              uld_error(
+                  e_fault,
+                  "Unable to map symbol `%s` to section index %.4x: invalid segment.",
+                  __FILE__,
+                  __LINE__,
+                  l_sym_name,
+                  sym_info.st_shndx
+              );
+      } else
+      if(l_sym_type == STT_SECTION) {
+          // have a section symbol: bind to one of ours or drop
+          // NOTE: relevant sections are loaded ahead of the symbols, see `uld_preload()`
+          if(sym_info.st_shndx > SHN_UNDEF) {
+              if(sym_info.st_shndx < m_shdr_count) {
+                  m_symbol_map[sym_index] = uld_get_local_section(sym_info.st_shndx);
+              }
+          }
+      } else
+      if((l_sym_type == STT_FUNC) ||
+          (l_sym_type == STT_OBJECT)) {
+          // global definitions go straight into the export pool, which the image adopts as a whole once the batch is
+          // committed; hidden ones, if the image is asked to honor their visibility, stay with the batch
+          symbol_table_t* l_sym_pool = m_symbol_pool;
+          bool            l_sym_hidden = uld_is_hidden(sym_info);
+          if((l_sym_bind == STB_GLOBAL) &&
+              (l_sym_hidden == false)) {
+              l_sym_pool = m_export_pool;
+          }
+          symbol_t* l_sym_ptr = l_sym_pool->make_symbol(
+              l_sym_name,
+              l_sym_name_length,
+              l_sym_type,
+              l_sym_bind
+          );
+          if(l_sym_ptr == nullptr) {
+              uld_error(
+                  e_nodef,
+                  "Failed to define symbol `%s`: out of memory.",
+                  __FILE__,
+                  __LINE__,
+                  l_sym_name
+              );
+              return false;
+          }
+          if((l_sym_bind == STB_WEAK) ||
+              (l_sym_bind == STB_GLOBAL)) {
+              l_sym_ptr->flags |= symbol_t::bit_export;
+              if(l_sym_hidden) {
+                  l_sym_ptr->flags |= symbol_t::bit_hidden;
+              }
+          }
+          // load symbol data
+          if(sym_info.st_shndx == SHN_ABS) {
+              uld_error(
+                  e_fault,
+                  "Unable to map symbol `%s` to an ABS segment.",
+                  __FILE__,
+                  __LINE__,
+                  l_sym_name
+              );
+              return false;
+          } else
+          if(sym_info.st_shndx == SHN_COMMON) {
+              uld_error(
+                  e_fault,
+                  "Unable to map symbol `%s` to a COMMON segment.",
+                  __FILE__,
+                  __LINE__,
+                  l_sym_name
+              );
+              return false;
+          } else
+          if(sym_info.st_shndx < m_shdr_count) {
+              int           l_sym_shndx        = sym_info.st_shndx;
+              std::int32_t  l_sym_value        = sym_info.st_value;
+              auto          l_sym_offset_mask  = m_target->get_vle_mask();
+              std::int32_t  l_sym_offset       = l_sym_value & l_sym_offset_mask;
+              auto          l_vle_bit          = m_target->get_vle_bit();
+              std::int32_t  l_sym_size         = sym_info.st_size;
+              std::uint8_t* l_sym_data         = uld_get_section_data(bi, l_sym_shndx, l_sym_offset, l_sym_size);
+              if(l_sym_data == nullptr) {
+                  uld_error(
+                      e_nodef,
+                      "Failed to define symbol `%s`.",
+                      __FILE__,
+                      __LINE__,
+                      l_sym_name
+                  );
+                  return false;
+              }
+              l_sym_ptr->ea = l_sym_data;
+              l_sym_ptr->ra = l_sym_data;
+              l_sym_ptr->size = l_sym_size;
+              // VLEs (like thumb) add a +1 to the effective function address; set the virtual address to that
+              // for function symbols
+              if(l_sym_type == STT_FUNC) {
+                  l_sym_ptr->ra += l_vle_bit;
+              }
+              if constexpr (is_debug) {
+                  printf(
+                      "(i) Stored symbol `%s` at effective address %p\n",
+                      l_sym_ptr->name,
+                      l_sym_ptr->ea
+                  );
+                  dbg_dump_hex(l_sym_ptr->ea, l_sym_ptr->size, true);
+              }
+              // let the backend track the definition, for it to detect the relocations against its contents
+              uld_bind_symbol(sym_index, l_sym_shndx, l_sym_offset, l_sym_size);
+              m_symbol_map[sym_index] = l_sym_ptr;
+              // publish the definition into the batch index, for the other objects to link against
+              if(l_sym_ptr->flags & symbol_t::bit_export) {
+                  return uld_index_symbol(l_sym_ptr, l_sym_name_length);
+              }
+          } else
+              uld_error(
+                  e_fault,
+                  "Unable to map symbol `%s` to section index %.4x: invalid segment.",
+                  __FILE__,
+                  __LINE__,
+                  l_sym_name,
+                  sym_info.st_shndx
+              );
+      }
+      return true;
+}
+
+/* uld_index_symbol()
+   place a definition into the batch index; a strong definition takes over a weak one, two strong ones collide; the one
+   taking over a slot inherits the references made to it so far
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_index_symbol(symbol_t* symbol_ptr, int name_length) noexcept
+{
+      std::uint32_t l_sym_hash = get_name_hash(symbol_ptr->name, name_length);
+      auto          l_slot_ptr = m_symbol_index->make_slot(symbol_ptr->name, l_sym_hash);
+      if(l_slot_ptr == nullptr) {
+          uld_error(
+              e_memory,
+              "Failed to index symbol `%s`: out of memory.",
+              __FILE__,
+              __LINE__,
+              symbol_ptr->name
+          );
+          return false;
+      }
+      if(l_slot_ptr->symbol == nullptr) {
+          // new name
+          l_slot_ptr->symbol = symbol_ptr;
+      } else
+      if(l_slot_ptr->symbol->ra == nullptr) {
+          // name so far only referenced
+          symbol_ptr->flags |= l_slot_ptr->symbol->flags & symbol_t::bit_import;
+          l_slot_ptr->symbol = symbol_ptr;
+      } else
+      if((l_slot_ptr->symbol->flags & symbol_t::bind_bits) == symbol_t::bind_weak) {
+          if((symbol_ptr->flags & symbol_t::bind_bits) != symbol_t::bind_weak) {
+              l_slot_ptr->symbol->flags &= ~symbol_t::bit_export;
+              symbol_ptr->flags |= l_slot_ptr->symbol->flags & symbol_t::bit_import;
+              l_slot_ptr->symbol = symbol_ptr;
+          } else
+              symbol_ptr->flags &= ~symbol_t::bit_export;
+      } else
+      if((symbol_ptr->flags & symbol_t::bind_bits) == symbol_t::bind_weak) {
+          symbol_ptr->flags &= ~symbol_t::bit_export;
+      } else {
+          uld_error(
+              e_redef,
+              "Redefinition of symbol `%s`.",
+              __FILE__,
+              __LINE__,
+              symbol_ptr->name
+          );
+          return false;
+      }
+      return true;
+}
+
+template<unsigned int Class>
+bool  factory<Class>::uld_error(int error, const char* message, const char* file, int line, ...) noexcept
+{
+#ifdef NDEBUG
+      printf("-!- Error %d: ", error);
+#else
+      printf("-!- Error %d %s:%d: ", error, file, line);
+#endif
+      va_list va;
+      va_start(va, line);
+      vprintf(message, va);
+      va_end(va);
+      puts("\n");
+      return error == 0;
+}
+
+/* uld_plan_segment()
+   get the plan entry of the given segment, add one if there's none yet
+*/
+template<unsigned int Class>
+auto  factory<Class>::uld_plan_segment(load_plan_t& plan, segment* segment_ptr) noexcept -> load_plan_t::segment_plan_t*
+{
+      for(auto& l_segment_plan : plan.segment_list) {
+          if(l_segment_plan.name == segment_ptr->get_name()) {
+              return std::addressof(l_segment_plan);
+          }
+      }
+      auto& l_segment_plan = plan.segment_list.emplace_back();
+      l_segment_plan.name = segment_ptr->get_name();
+      l_segment_plan.type = segment_ptr->get_type();
+      l_segment_plan.flags = segment_ptr->get_flags();
+      l_segment_plan.align = segment_ptr->get_align();
+      l_segment_plan.section_count = 0;
+      l_segment_plan.data_size = 0;
+      return std::addressof(l_segment_plan);
+}
+
+/* uld_plan_read()
+   account the contents of a section into the planned storage reads, once
+*/
+template<unsigned int Class>
+void  factory<Class>::uld_plan_read(bfd_type& bi, load_plan_t& plan, std::vector<bool>& read_list, int shdr_index) noexcept
+{
+      shdr_type l_shdr_info;
+      if((shdr_index > 0) &&
+          (shdr_index < static_cast<int>(read_list.size()))) {
+          if(read_list[shdr_index] == false) {
+              if(bi.read_section_info(l_shdr_info, shdr_index)) {
+                  if(l_shdr_info.sh_type != SHT_NOBITS) {
+                      plan.read_size += l_shdr_info.sh_size;
+                  }
+              }
+              read_list[shdr_index] = true;
+          }
+      }
+}
+
+/* plan()
+   estimate what loading the object would take, from the section headers, symbol tables and relocation tables only: nothing
+   is allocated into the image and the factory is left untouched, so that it can be used with no pools
+*/
+template<unsigned int Class>
+bool  factory<Class>::plan(bfd_type& bi, load_plan_t& plan) noexcept
+{
+      int  l_shdr_count = bi.get_section_count();
+      std::vector<bool> l_read_list(l_shdr_count > 0 ? l_shdr_count : 0, false);
+      plan.segment_list.clear();
+      plan.data_size = 0;
+      plan.symbol_count = 0;
+      plan.export_count = 0;
+      plan.import_count = 0;
+      plan.unresolved_count = 0;
+      plan.conflict_count = 0;
+      plan.symbol_size = 0;
+      plan.rel_count = 0;
+      std::memset(plan.rel_type_count, 0, sizeof(plan.rel_type_count));
+      plan.read_size = bi.e_ehsize + l_shdr_count * bi.e_shentsize;
+      uld_plan_read(bi, plan, l_read_list, bi.e_shstrndx);
+      for(int l_shdr_index = 0; l_shdr_index < l_shdr_count; l_shdr_index++) {
+          shdr_type  l_shdr_info;
+          if(bi.read_section_info(l_shdr_info, l_shdr_index) == false) {
+              return uld_error(
+                  e_access,
+                  "Read error: Failed to fetch section header %d.",
+                  __FILE__,
+                  __LINE__,
+                  l_shdr_index
+              );
+          }
+          if((l_shdr_info.sh_type == SHT_PROGBITS) ||
+              (l_shdr_info.sh_type == SHT_NOBITS)) {
+              // allocated sections: account them into the segment they would be mapped to
+              if((l_shdr_info.sh_flags & SHF_ALLOC) &&
+                  (l_shdr_info.sh_size > 0)) {
+                  segment* l_segment_ptr = uld_get_section_segment(bi, l_shdr_info);
+                  if(l_segment_ptr != nullptr) {
+                      auto l_segment_plan = uld_plan_segment(plan, l_segment_ptr);
+                      int  l_data_size = l_shdr_info.sh_size + uld_get_section_pad_max(l_shdr_info);
+                      l_segment_plan->section_count++;
+                      l_segment_plan->data_size += l_data_size;
+                      plan.data_size += l_data_size;
+                  }
+                  uld_plan_read(bi, plan, l_read_list, l_shdr_index);
+              }
+          } else
+          if(l_shdr_info.sh_type == SHT_SYMTAB) {
+              if(l_shdr_info.sh_entsize == 0) {
+                  continue;
+              }
+              int l_sym_count = bi.get_symbol_count(l_shdr_info);
+              uld_plan_read(bi, plan, l_read_list, l_shdr_index);
+              uld_plan_read(bi, plan, l_read_list, l_shdr_info.sh_link);
+              for(int l_sym_index = 0; l_sym_index < l_sym_count; l_sym_index++) {
+                  sym_type    l_sym_info;
+                  const char*  l_sym_name;
+                  int          l_sym_name_length;
+                  if((bi.read_symbol_info(l_sym_info, l_shdr_info, l_sym_index) == false) ||
+                      (bi.read_symbol_name(l_sym_info, l_shdr_info, l_sym_name, l_sym_name_length) == false)) {
+                      return uld_error(
+                          e_access,
+                          "Read error: Failed to fetch symbol %d.",
+                          __FILE__,
+                          __LINE__,
+                          l_sym_index
+                      );
+                  }
+                  unsigned int l_sym_type = class_type::get_sym_type(l_sym_info.st_info);
+                  unsigned int l_sym_bind = class_type::get_sym_bind(l_sym_info.st_info);
+                  int          l_sym_size = sizeof(symbol_t) + get_round_value(l_sym_name_length + 1, 8);
+                  if(l_sym_type == STT_NOTYPE) {
+                      if((l_sym_info.st_shndx == SHN_UNDEF) &&
+                          (l_sym_info.st_name != 0)) {
+                          symbol_t* l_image_ptr = m_image->find_image_symbol(l_sym_name);
+                          plan.import_count++;
+                          if((l_image_ptr == nullptr) ||
+                              (l_image_ptr->ra == nullptr)) {
+                              if(m_image->find_export(l_sym_name) != nullptr) {
+                                  // the load takes the symbol over from the export table
+                                  if(l_image_ptr == nullptr) {
+                                      plan.symbol_size += l_sym_size;
+                                  }
+                              } else
+                              if(l_sym_bind != STB_WEAK) {
+                                  plan.unresolved_count++;
+                                  // the load leaves a placeholder in the image for the missing symbol
+                                  if(l_image_ptr == nullptr) {
+                                      plan.symbol_size += l_sym_size;
+                                  }
+                              }
+                          }
+                      }
+                  } else
+                  if((l_sym_type == STT_FUNC) ||
+                      (l_sym_type == STT_OBJECT)) {
+                      plan.symbol_count++;
+                      if((l_sym_bind == STB_GLOBAL) &&
+                          (l_sym_info.st_shndx != SHN_UNDEF) &&
+                          (l_sym_info.st_shndx < l_shdr_count) &&
+                          (uld_is_hidden(l_sym_info) == false)) {
+                          symbol_t*       l_image_ptr = m_image->find_image_symbol(l_sym_name);
+                          const export_t* l_export_ptr = m_image->find_export(l_sym_name);
+                          plan.export_count++;
+                          if(l_image_ptr == nullptr) {
+                              plan.symbol_size += l_sym_size;
+                          }
+                          if((l_image_ptr != nullptr) &&
+                              (l_image_ptr->ra != nullptr)) {
+                              if((l_image_ptr->flags & symbol_t::bind_bits) != symbol_t::bind_weak) {
+                                  plan.conflict_count++;
+                              }
+                          } else
+                          if((l_export_ptr != nullptr) &&
+                              ((l_export_ptr->flags & symbol_t::bind_bits) != symbol_t::bind_weak)) {
+                              plan.conflict_count++;
+                          }
+                      }
+                  }
+              }
+          } else
+          if((l_shdr_info.sh_type == SHT_REL) ||
+              (l_shdr_info.sh_type == SHT_RELA)) {
+              if(l_shdr_info.sh_entsize == 0) {
+                  continue;
+              }
+              int l_rel_count = l_shdr_info.sh_type == SHT_REL ? bi.get_rel_count(l_shdr_info) : bi.get_rela_count(l_shdr_info);
+              uld_plan_read(bi, plan, l_read_list, l_shdr_index);
+              for(int l_rel_index = 0; l_rel_index < l_rel_count; l_rel_index++) {
+                  int  l_rel_type;
+                  if(l_shdr_info.sh_type == SHT_REL) {
+                      rel_type  l_rel_info;
+                      if(bi.read_rel_info(l_rel_info, l_shdr_info, l_rel_index) == false) {
+                          return uld_error(
+                              e_access,
+                              "Read error: Failed to fetch relocation %d.",
+                              __FILE__,
+                              __LINE__,
+                              l_rel_index
+                          );
+                      }
+                      l_rel_type = class_type::get_rel_type(l_rel_info.r_info);
+                  } else {
+                      rela_type l_rela_info;
+                      if(bi.read_rela_info(l_rela_info, l_shdr_info, l_rel_index) == false) {
+                          return uld_error(
+                              e_access,
+                              "Read error: Failed to fetch relocation %d.",
+                              __FILE__,
+                              __LINE__,
+                              l_rel_index
+                          );
+                      }
+                      l_rel_type = class_type::get_rel_type(l_rela_info.r_info);
+                  }
+                  plan.rel_count++;
+                  if(l_rel_type < load_plan_t::rel_type_max) {
+                      plan.rel_type_count[l_rel_type]++;
+                  }
+              }
+          }
+      }
+      return true;
+}
+
+/* uld_get_section_align()
+   alignment of a section, as a power of 2; -1 if not one or larger than supported
+*/
+template<unsigned int Class>
+int   factory<Class>::uld_get_section_align(const shdr_type& shdr_info) noexcept
+{
+      if(shdr_info.sh_addralign <= 1) {
+          return 0;
+      }
+      if(shdr_info.sh_addralign & (shdr_info.sh_addralign - 1)) {
+          return -1;
+      }
+      if(int
+          l_align = __builtin_ctzll(shdr_info.sh_addralign);
+          l_align <= section_align_max) {
+          return l_align;
+      }
+      return -1;
+}
+
+/* uld_get_section_pad_max()
+   most bytes aligning a section may skip ahead of it
+*/
+template<unsigned int Class>
+int   factory<Class>::uld_get_section_pad_max(const shdr_type& shdr_info) noexcept
+{
+      int l_align = uld_get_section_align(shdr_info);
+      if(l_align > 0) {
+          return (1 << l_align) - 1;
+      }
+      return 0;
+}
+
+/* uld_get_section_segment()
+   the segment of the image an allocated section goes to, see `image::get_segment_by_section()`
+*/
+template<unsigned int Class>
+auto  factory<Class>::uld_get_section_segment(bfd_type& bi, shdr_type& shdr_info) noexcept -> segment*
+{
+      const char* l_shdr_name = nullptr;
+      int         l_shdr_name_length;
+      if(bi.read_section_name(shdr_info, l_shdr_name, l_shdr_name_length) == false) {
+          l_shdr_name = nullptr;
+      }
+      return m_image->get_segment_by_section(
+          l_shdr_name,
+          shdr_info.sh_type == SHT_NOBITS ? section_t::type_nobits : section_t::type_progbits,
+          section_t::data_bits_from_shdr(shdr_info.sh_flags)
+      );
+}
+
+/* uld_reserve()
+   add up the allocated sections of the object by the segment they map to and have each segment reserve as much, so that
+   the data of an object lands in a single page of its segment, rather than in a run of `page_size` ones
+*/
+template<unsigned int Class>
+void  factory<Class>::uld_reserve(bfd_type& bi, int shdr_count) noexcept
+{
+      program_table_t* l_program_ptr = m_image->get_program_table();
+      block_list_t<int> l_reserve_list(m_shdr_map.get_allocator().get_allocator());
+      for(int l_shdr_index = 1; l_shdr_index < shdr_count; l_shdr_index++) {
+          shdr_type  l_shdr_info;
+          if(bi.read_section_info(l_shdr_info, l_shdr_index) == false) {
+              continue;
+          }
+          if((l_shdr_info.sh_type == SHT_PROGBITS) ||
+              (l_shdr_info.sh_type == SHT_NOBITS)) {
+              if((l_shdr_info.sh_flags & SHF_ALLOC) &&
+                  (l_shdr_info.sh_size > 0)) {
+                  // the segment may be one a region rule makes on the spot
+                  segment* l_segment_ptr = uld_get_section_segment(bi, l_shdr_info);
+                  int      l_segment_count = l_program_ptr->get_segment_count();
+                  if(l_reserve_list.resize(l_segment_count, 0) == false) {
+                      continue;
+                  }
+                  for(int i_segment = 0; i_segment < l_segment_count; i_segment++) {
+                      if(l_program_ptr->get_segment_by_index(i_segment) == l_segment_ptr) {
+                          l_reserve_list[i_segment] += l_shdr_info.sh_size + uld_get_section_pad_max(l_shdr_info);
+                          break;
+                      }
+                  }
+              }
+          }
+      }
+      for(int i_segment = 0; i_segment < static_cast<int>(l_reserve_list.size()); i_segment++) {
+          if(l_reserve_list[i_segment] > 0) {
+              l_program_ptr->get_segment_by_index(i_segment)->reserve(l_reserve_list[i_segment]);
+          }
+      }
+}
+
+/* prefetch()
+   gather information about the curren object file, set up internal section map
+*/
+template<unsigned int Class>
+bool  factory<Class>::prefetch(bfd_type& bi) noexcept
+{
+      bool l_have_code = false;
+      bool l_have_data = false;
+      bool l_have_symtab = false;
+      bool l_have_rel = false;
+      int  l_shdr_count = bi.get_section_count();
+      if(l_shdr_count > 0) {
+          // reserve enough entries in the section map
+          m_shdr_map.resize(l_shdr_count);
+          // and enough room in the segments
+          uld_reserve(bi, l_shdr_count);
+      }
+      // run a scan of the section table and map to the existing image sections
+      for(int l_shdr_index = 0; l_shdr_index < l_shdr_count; l_shdr_index++) {
+          shdr_type  l_shdr_info;
+          const char* l_shdr_name;
+          int         l_shdr_name_length;
+          if(bool
+              l_fetch_shdr_success = bi.read_section_info(l_shdr_info, l_shdr_index);
+              l_fetch_shdr_success == true) {
+              m_shdr_map[l_shdr_index].name = nullptr;
+              m_shdr_map[l_shdr_index].type = section_t::type_bits_from_shdr(l_shdr_info.sh_type) | symbol_t::type_section;
+              m_shdr_map[l_shdr_index].flags = section_t::data_bits_from_shdr(l_shdr_info.sh_type);
+              m_shdr_map[l_shdr_index].ea = nullptr;
+              m_shdr_map[l_shdr_index].ra = nullptr;
+              m_shdr_map[l_shdr_index].offset_base = 0;
+              m_shdr_map[l_shdr_index].offset_last = 0;
+              m_shdr_map[l_shdr_index].support = nullptr;
+              if(bool
+                  l_fetch_name_success = bi.read_section_name(l_shdr_info, l_shdr_name, l_shdr_name_length);
+                  l_fetch_name_success == true) {
+                  segment*  l_segment_ptr;
+                  int       l_rule_index;
+                  switch(l_shdr_info.sh_type) {
+                      case SHT_NULL:
+                          // only the first section should be a NULL
+                          if(l_shdr_index > 0) {
+                              printdbg(
+                                  "Found NULL section at index %d.",
+                                  __FILE__,
+                                  __LINE__,
+                                  l_shdr_index
+                              );
+                          }
+                          break;
+                      case SHT_NOBITS:
+                          if(l_shdr_info.sh_flags & SHF_ALLOC) {
+                              l_have_data |= l_shdr_info.sh_size > 0;
+                              l_segment_ptr = m_image->get_segment_by_section(
+                                  l_shdr_name,
+                                  section_t::type_nobits,
+                                  section_t::data_bits_from_shdr(l_shdr_info.sh_flags),
+                                  std::addressof(l_rule_index)
+                              );
+                              if(l_segment_ptr == nullptr) {
+                                  uld_error(
+                                      e_memory,
+                                      "Failed to map section `%s` to a segment.",
+                                      __FILE__,
+                                      __LINE__,
+                                      l_shdr_name
+                                  );
+                                  return false;
+                              }
+                              m_shdr_map[l_shdr_index].name = l_segment_ptr->get_name();
+                              // m_shdr_map[l_shdr_index].ea = l_segment_ptr->get_next_ptr();
+                              // m_shdr_map[l_shdr_index].ra = l_segment_ptr->get_next_ptr();
+                              // store the base offsets of the segments, in order to be able to roll back upon failure
+                              m_shdr_map[l_shdr_index].offset_base = l_segment_ptr->get_table_offset();
+                              m_shdr_map[l_shdr_index].offset_last = m_shdr_map[l_shdr_index].offset_base;
+                              // remember the segment this section is supposed to be allocated to
+                              m_shdr_map[l_shdr_index].support = l_segment_ptr;
+                              // sections a segment rule maps are laid out in the order of their rules, see place()
+                              if((l_rule_index >= 0) &&
+                                  (l_shdr_info.sh_size > 0)) {
+                                  m_place_list.push_back(placing_t{place_rule_base + l_rule_index, l_shdr_index, uld_get_section_align(l_shdr_info)});
+                              }
+                          }
+                          break;
+                      case SHT_PROGBITS:
+                          if(l_shdr_info.sh_flags & SHF_ALLOC) {
+                              if(l_shdr_info.sh_flags & SHF_EXECINSTR) {
+                                  l_have_code |= l_shdr_info.sh_size > 0;
+                              } else
+                                  l_have_data |= l_shdr_info.sh_size > 0;
+                              l_segment_ptr = m_image->get_segment_by_section(
+                                  l_shdr_name,
+                                  section_t::type_progbits,
+                                  section_t::data_bits_from_shdr(l_shdr_info.sh_flags),
+                                  std::addressof(l_rule_index)
+                              );
+                              if(l_segment_ptr == nullptr) {
+                                  uld_error(
+                                      e_memory,
+                                      "Failed to map section `%s` to a segment.",
+                                      __FILE__,
+                                      __LINE__,
+                                      l_shdr_name
+                                  );
+                                  return false;
+                              }
+                              m_shdr_map[l_shdr_index].name = l_segment_ptr->get_name();
+                              // m_shdr_map[l_shdr_index].ea = l_segment_ptr->get_next_ptr();
+                              // m_shdr_map[l_shdr_index].ra = l_segment_ptr->get_next_ptr();
+                              // store the base offsets of the segments, in order to be able to roll beck upon failure
+                              m_shdr_map[l_shdr_index].offset_base = l_segment_ptr->get_table_offset();
+                              m_shdr_map[l_shdr_index].offset_last = m_shdr_map[l_shdr_index].offset_base;
+                              // remember the segment this section is supposed to be allocated to, if any
+                              m_shdr_map[l_shdr_index].support = l_segment_ptr;
+                              // sections a segment rule maps are laid out in the order of their rules, see place()
+                              if((l_rule_index >= 0) &&
+                                  (l_shdr_info.sh_size > 0)) {
+                                  m_place_list.push_back(placing_t{place_rule_base + l_rule_index, l_shdr_index, uld_get_section_align(l_shdr_info)});
+                              }
+                          }
+                          break;
+                      case SHT_SYMTAB:
+                          // check if the symbol table is valid and keep its header at hand for the import step
+                          if(l_shdr_info.sh_size > 0) {
+                              if(l_shdr_info.sh_entsize > 0) {
+                                  m_symtab_list.push_back(l_shdr_info);
+                                  l_have_symtab = true;
+                              }
+                          }
+                          break;
+                      case SHT_REL:
+                      case SHT_RELA:
+                          // check if the relocation table is valid and keep its header at hand for the resolve step
+                          if(l_shdr_info.sh_size > 0) {
+                              if(l_shdr_info.sh_entsize > 0) {
+                                  m_rel_list.push_back(l_shdr_info);
+                                  l_have_rel = true;
+                              }
+                          }
+                          break;
+                      default:
+                          break;
+                  }
+              }
+          }
+      }
+      m_shdr_count = l_shdr_count;
+      m_shdr_have_code = l_have_code;
+      m_shdr_have_data = l_have_data;
+      m_shdr_have_symtab = l_have_symtab;
+      m_shdr_have_rel = l_have_rel;
+      // rank the code sections holding hot functions, for the image to place them ahead of the others
+      if(m_image->get_placement() != nullptr) {
+          if(l_have_code && l_have_symtab) {
+              if(uld_rank(bi) == false) {
+                  return false;
+              }
+          }
+      }
+      std::stable_sort(m_place_list.begin(), m_place_list.end(), uld_is_placed_before);
+      return true;
+}
+
+/* uld_is_placed_before()
+   order of placement: by rank, then by decreasing alignment, for the sections of a rank to pad each other the least
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_is_placed_before(const placing_t& lhs, const placing_t& rhs) noexcept
+{
+      if(lhs.rank != rhs.rank) {
+          return lhs.rank < rhs.rank;
+      }
+      return lhs.align > rhs.align;
+}
+
+/* uld_rank()
+   list the code sections holding functions the placement profile of the image lists, each with the rank of the hottest
+   of them, which comes before those of the sections the segment rules place; the ranking works at section granularity,
+   such that only objects built with `-ffunction-sections` get their functions placed one by one
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_rank(bfd_type& bi) noexcept
+{
+      placement_t*  l_placement = m_image->get_placement();
+      block_list_t<int> l_rank_list(m_shdr_map.get_allocator().get_allocator());
+      if(l_rank_list.resize(m_shdr_count, -1) == false) {
+          return false;
+      }
+      for(shdr_type& l_shdr_info : m_symtab_list) {
+          int l_sym_count = bi.get_symbol_count(l_shdr_info);
+          for(int l_sym_index = 0; l_sym_index < l_sym_count; l_sym_index++) {
+              sym_type   l_sym_info;
+              const char* l_sym_name;
+              int         l_sym_name_length;
+              if(bi.read_symbol_info(l_sym_info, l_shdr_info, l_sym_index) == false) {
+                  return false;
+              }
+              if((class_type::get_sym_type(l_sym_info.st_info) != STT_FUNC) ||
+                  (l_sym_info.st_shndx == SHN_UNDEF) ||
+                  (l_sym_info.st_shndx >= m_shdr_count)) {
+                  continue;
+              }
+              if(bi.read_symbol_name(l_sym_info, l_shdr_info, l_sym_name, l_sym_name_length) == false) {
+                  return false;
+              }
+              int  l_rank = l_placement->find_rank(l_sym_name, get_name_hash(l_sym_name, l_sym_name_length));
+              if(l_rank >= 0) {
+                  int& l_section_rank = l_rank_list[l_sym_info.st_shndx];
+                  if((l_section_rank < 0) ||
+                      (l_rank < l_section_rank)) {
+                      l_section_rank = l_rank;
+                  }
+              }
+          }
+      }
+      for(int l_shdr_index = 1; l_shdr_index < m_shdr_count; l_shdr_index++) {
+          shdr_type l_shdr_info;
+          if(l_rank_list[l_shdr_index] < 0) {
+              continue;
+          }
+          if(bi.read_section_info(l_shdr_info, l_shdr_index) == false) {
+              return false;
+          }
+          if((l_shdr_info.sh_type == SHT_PROGBITS) &&
+              (l_shdr_info.sh_flags & SHF_ALLOC) &&
+              (l_shdr_info.sh_flags & SHF_EXECINSTR) &&
+              (l_shdr_info.sh_size > 0)) {
+              // a hot section a segment rule maps goes ahead of the other sections of the rule
+              bool l_place_found = false;
+              for(placing_t& l_place : m_place_list) {
+                  if(l_place.source_index == l_shdr_index) {
+                      l_place.rank = l_rank_list[l_shdr_index];
+                      l_place_found = true;
+                      break;
+                  }
+              }
+              if(l_place_found == false) {
+                  m_place_list.push_back(placing_t{l_rank_list[l_shdr_index], l_shdr_index, uld_get_section_align(l_shdr_info)});
+              }
+          }
+      }
+      return true;
+}
+
+/* get_place_count()
+   number of hot code sections of the object, see `place()`
+*/
+template<unsigned int Class>
+int   factory<Class>::get_place_count() const noexcept
+{
+      return m_place_list.size();
+}
+
+/* get_place_rank()
+   rank of the `index`th hottest code section of the object
+*/
+template<unsigned int Class>
+int   factory<Class>::get_place_rank(int index) const noexcept
+{
+      return m_place_list[index].rank;
+}
+
+/* place()
+   load the `index`th hottest code section of the object at the current end of its segment, ahead of the symbols it holds
+*/
+template<unsigned int Class>
+bool  factory<Class>::place(bfd_type& bi, int index) noexcept
+{
+      int  l_shdr_index = m_place_list[index].source_index;
+      if(std::uint8_t*
+          l_shdr_data = uld_get_section_data(bi, l_shdr_index, 0, 0);
+          l_shdr_data == nullptr) {
+          return false;
+      }
+      return true;
+}
+
+/* uld_preload()
+   load PROGBITS/ALLOC non-executable sections ahead of time, as they are very likely referenced in relocations, along
+   with the NOBITS ones, by decreasing alignment, for the small ones to fill in behind the large ones rather than pad
+   between them; those the image placed already (see `place()`) keep their place
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_preload(bfd_type& bi) noexcept
+{
+      list_t<placing_t> l_load_list(m_shdr_map.get_allocator());
+      for(int l_shdr_index = 1; l_shdr_index < m_shdr_count; l_shdr_index++) {
+          section_t&  l_section = m_shdr_map[l_shdr_index];
+          shdr_type  l_shdr_info;
+          if((l_section.support == nullptr) ||
+              (l_section.offset_last != l_section.offset_base)) {
+              continue;
+          }
+          if(bi.read_section_info(l_shdr_info, l_shdr_index) == false) {
+              return false;
+          }
+          if(((l_shdr_info.sh_type != SHT_PROGBITS) && (l_shdr_info.sh_type != SHT_NOBITS)) ||
+              (l_shdr_info.sh_flags & SHF_EXECINSTR) ||
+              (l_shdr_info.sh_size == 0)) {
+              continue;
+          }
+          l_load_list.push_back(placing_t{0, l_shdr_index, uld_get_section_align(l_shdr_info)});
+      }
+      std::stable_sort(l_load_list.begin(), l_load_list.end(), uld_is_placed_before);
+      for(placing_t& l_load : l_load_list) {
+          int         l_shdr_index = l_load.source_index;
+          shdr_type  l_shdr_info;
+          if(bi.read_section_info(l_shdr_info, l_shdr_index) == false) {
+              return false;
+          }
+          std::int32_t  l_shdr_size = l_shdr_info.sh_size;
+          std::uint8_t* l_shdr_data = uld_get_section_data(bi, l_shdr_info, l_shdr_index, 0, l_shdr_size);
+          if(l_shdr_data == nullptr) {
+              uld_error(
+                  e_fault,
+                  "Failed to load section %d.",
+                  __FILE__,
+                  __LINE__,
+                  l_shdr_index
+              );
+              return false;
+          }
+          if constexpr (is_debug) {
+              printf(
+                  "(i) Stored section %d at effective address %p.\n",
+                  l_shdr_index,
+                  l_shdr_data
+              );
+              dbg_dump_hex(l_shdr_data, l_shdr_size, true);
+          }
+      }
+      return true;
+}
+
+/* uld_import()
+   import symbols and sections from the object file
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_import(bfd_type& bi) noexcept
+{
+      // load the data sections placement left out before the symbols
+      if(m_shdr_have_data) {
+          if(uld_preload(bi) == false) {
+              return false;
+          }
+      }
+      // no symbol table - nothing to collect
+      if(m_shdr_have_symtab == false) {
+          return true;
+      }
+      // collect all symbols in the symbol tables detected at the 'prefetch' step
+      int  l_shdr_count = m_symtab_list.size();
+      int  l_shdr_success = 0;
+      for(shdr_type& l_shdr_info : m_symtab_list) {
+          int l_sym_base = m_symbol_map.size();
+          int l_sym_count = bi.get_symbol_count(l_shdr_info);
+          int l_sym_success = 0;
+          // reserve space for every symbol in the symbol index array (relocations need it), and as much room in the
+          // batch pools: the names are bound by the size of the linked string table, and the globals, which go to the
+          // export pool, follow the locals (`sh_info` being the index of the first global)
+          if(l_sym_count > 0) {
+              shdr_type l_str_info;
+              int        l_global_count = 0;
+              m_symbol_map.resize(l_sym_base + l_sym_count);
+              if(static_cast<int>(l_shdr_info.sh_info) < l_sym_count) {
+                  l_global_count = l_sym_count - l_shdr_info.sh_info;
+              }
+              m_symbol_pool->reserve(l_sym_count - l_global_count);
+              m_export_pool->reserve(l_global_count);
+              if(bi.read_section_info(l_str_info, l_shdr_info.sh_link)) {
+                  int l_global_size = static_cast<std::int64_t>(l_str_info.sh_size) * l_global_count / l_sym_count;
+                  m_string_pool->reserve(l_str_info.sh_size - l_global_size, l_sym_count - l_global_count);
+                  m_export_pool->get_string_table()->reserve(l_global_size, l_global_count);
+              }
+          }
+          // run through the symbol table and collect the relevant ones
+          for(int l_sym_index = 0; l_sym_index < l_sym_count; l_sym_index++) {
+              sym_type  l_sym_info;
+              bool       l_load_sym_success;
+              if(bool
+                  l_fetch_sym_success = bi.read_symbol_info(l_sym_info, l_shdr_info, l_sym_index);
+                  l_fetch_sym_success == true) {
+                  l_load_sym_success = uld_load_symbol(bi, l_shdr_info, l_sym_info, l_sym_base + l_sym_index);
+                  if(l_load_sym_success == false) {
+                      break;
+                  };
+                  ++l_sym_success;
+              }
+          }
+          if(l_sym_success != l_sym_count) {
+              break;
+          }
+          ++l_shdr_success;
+      }
+      return l_shdr_success == l_shdr_count;
+}
+
+/* uld_export()
+   link loaded globals into the image; the definitions already live in the export pool, which the image adopts, pages and
+   all, once the batch is committed (see image::uld_adopt()) - all that's left to do here is to clear their export flag
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_export() noexcept
+{
+      for(symbol_t* l_map_ptr : m_symbol_map) {
+          if(l_map_ptr) {
+              if(l_map_ptr->flags & symbol_t::bind_global) {
+                  if(l_map_ptr->flags & symbol_t::bit_export) {
+                      // the same definition may be mapped by more than one object of the batch: only export it once
+                      l_map_ptr->flags ^= symbol_t::bit_export;
+                  }
+              }
+          }
+      }
+      // hand the relocations against still undefined symbols over to the image
+      for(fixup_t& l_fixup_info : m_fixup_list) {
+          if(fixup_t*
+              l_fixup_ptr = m_image->get_fixup_table()->make_fixup(l_fixup_info.symbol, l_fixup_info.address, l_fixup_info.type);
+              l_fixup_ptr == nullptr) {
+              uld_error(
+                  e_memory,
+                  "Failed to defer relocation against symbol `%s`: out of memory.",
+                  __FILE__,
+                  __LINE__,
+                  l_fixup_info.symbol->name
+              );
+              return false;
+          }
+      }
+      return true;
+}
+
+/* uld_fixup()
+   apply the deferred relocations whose symbols have become defined; each fixup is dropped as soon as it's applied, while
+   those that fail are reported, one by one, and kept in the table as failed; false if any did
+*/
+template<unsigned int Class>
+bool  factory<Class>::uld_fixup() noexcept
+{
+      fixup_table_t* l_fixup_table = m_image->get_fixup_table();
+      int            l_fixup_error = 0;
+      if(l_fixup_table->get_fixup_count() > 0) {
+          auto i_fixup = l_fixup_table->begin();
+          while(i_fixup) {
+              fixup_t*  l_fixup_ptr = i_fixup;
+              symbol_t* l_sym_ptr   = l_fixup_ptr->symbol;
+              if((l_sym_ptr != nullptr) &&
+                  (l_fixup_ptr->error == 0)) {
+                  if(l_sym_ptr->ra != nullptr) {
+                      if(bool
+                          l_apply_success = uld_apply_rel(l_fixup_ptr->type, l_fixup_ptr->address, l_sym_ptr);
+                          l_apply_success == false) {
+                          uld_error(
+                              e_norel,
+                              "Deferred relocation %d at %p against `%s` could not be applied, and is left in the fixup table.",
+                              __FILE__,
+                              __LINE__,
+                              l_fixup_ptr->type,
+                              l_fixup_ptr->address,
+                              l_sym_ptr->name
+                          );
+                          l_fixup_table->fail_fixup(l_fixup_ptr, e_norel);
+                          l_fixup_error++;
+                      } else
+                          l_fixup_table->free_fixup(l_fixup_ptr);
+                  }
+              }
+              i_fixup++;
+          }
+      }
+      return l_fixup_error == 0;
+}
+
+/* import()
+   load the symbols of the object file, publishing its globals into the batch index
+*/
+template<unsigned int Class>
+bool  factory<Class>::import(bfd_type& bi) noexcept
+{
+      return uld_import(bi);
+}
+
+/* link()
+   rebind the undefined symbols of the object to whatever the batch index holds for them, once the image has bound the
+   index (see image::uld_bind())
+*/
+template<unsigned int Class>
+bool  factory<Class>::link() noexcept
+{
+      for(symbol_t*& l_map_ptr : m_symbol_map) {
+          if(l_map_ptr != nullptr) {
+              if((l_map_ptr->type & symbol_t::type_section) != symbol_t::type_section) {
+                  if(l_map_ptr->ra == nullptr) {
+                      if(symbol_t*
+                          l_sym_ptr = m_symbol_index->find_symbol(l_map_ptr->name);
+                          l_sym_ptr != nullptr) {
+                          l_map_ptr = l_sym_ptr;
+                      }
+                  }
+              }
+          }
+      }
+      return true;
+}
+
+/* resolve()
+   apply the relocations of the object file
+*/
+template<unsigned int Class>
+bool  factory<Class>::resolve(bfd_type& bi) noexcept
+{
+      return uld_resolve(bi);
+}
+
+/* commit()
+   export the globals of the object into the image, along with the relocations still waiting for a definition
+*/
+template<unsigned int Class>
+bool  factory<Class>::commit() noexcept
+{
+      return uld_export();
+}
+
+/* fixup()
+   apply the image-wide deferred relocations which have become resolvable; false if any of them failed, which leaves them
+   in the fixup table (see `fixup_table_t::get_error_count()`)
+*/
+template<unsigned int Class>
+bool  factory<Class>::fixup() noexcept
+{
+      return uld_fixup();
+}
+
+/* uld_bind_symbol()
+   hook for the backends to keep track of the definitions of the object as they're loaded, given by their section and
+   their extent within it; none by default
+*/
+template<unsigned int Class>
+void  factory<Class>::uld_bind_symbol(int, int, std::int32_t, std::int32_t) noexcept
+{
+}
+
+template class factory<bin_32>;
+template class factory<bin_64>;
+
+/*namespace elfxx*/ }
+/*namespace uld*/ }
@@ -0,0 +1,132 @@
+#ifndef uld_elfxx_util_h
+#define uld_elfxx_util_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "image/data.h"
+#include "image/string_table.h"
+#include "image/symbol_table.h"
+#include "image/symbol_index.h"
+#include "bfd/elfxx.h"
+#include "plan.h"
+#include <elf.h>
+#include <vector>
+
+namespace uld {
+namespace elfxx {
+
+/* factory
+   loader logic the ELF32 and ELF64 factories share, written once over the class of the objects (see `elf_class_t`);
+   the backends derive from it and supply the relocations, through `uld_resolve()` and `uld_apply_rel()`
+*/
+template<unsigned int Class>
+class factory
+{
+  protected:
+  using   class_type = elf_class_t<Class>;
+  using   bfd_type   = elfxx_bfd_t<Class>;
+  using   shdr_type  = typename class_type::shdr_type;
+  using   sym_type   = typename class_type::sym_type;
+  using   rel_type   = typename class_type::rel_type;
+  using   rela_type  = typename class_type::rela_type;
+
+  template<typename Xt>
+  using   list_t = std::vector<Xt, std_allocator_t<Xt>>;
+
+  image*  m_image;
+  target* m_target;
+
+  string_table_t*         m_string_pool;  // string cache, shared by all the objects in a batch
+  symbol_table_t*         m_symbol_pool;  // symbol cache, shared by all the objects in a batch
+  symbol_table_t*         m_export_pool;  // global definitions of the batch, drawn from the image pools for it to adopt
+  symbol_index_t*         m_symbol_index; // batch-wide index of the global names, definitions and references alike
+
+  list_t<section_t>       m_shdr_map;     // the maps below take their memory from the batch scratch allocator, if any
+  list_t<shdr_type>       m_symtab_list;  // symbol table headers, gathered at prefetch
+  list_t<shdr_type>       m_rel_list;     // relocation table headers, gathered at prefetch
+  list_t<symbol_t*>       m_symbol_map;
+  list_t<fixup_t>         m_fixup_list;   // relocations deferred until their symbol is defined
+  list_t<placing_t>       m_place_list;   // hot code sections, by rank, if the image has a placement profile
+
+  int     m_shdr_count;
+  bool    m_shdr_have_code;
+  bool    m_shdr_have_data;
+  bool    m_shdr_have_symtab;
+  bool    m_shdr_have_rel;
+
+  protected:
+          auto   uld_get_local_section(int) noexcept -> section_t*;
+          auto   uld_get_local_section(symbol_t*, int* = nullptr) noexcept -> section_t*;
+          auto   uld_get_local_symbol(int) noexcept -> symbol_t*;
+          auto   uld_get_virtual_address(symbol_t*) noexcept -> std::uint8_t*;
+          bool   uld_is_pending(symbol_t*) noexcept;
+
+          auto   uld_get_section_data(bfd_type&, shdr_type&, int, std::int32_t, std::int32_t) noexcept -> std::uint8_t*;
+          auto   uld_get_section_data(bfd_type&, int, std::int32_t, std::int32_t) noexcept -> std::uint8_t*;
+          bool   uld_is_hidden(sym_type&) noexcept;
+          bool   uld_load_symbol(bfd_type&, shdr_type&, sym_type&, int) noexcept;
+          bool   uld_index_symbol(symbol_t*, int) noexcept;
+  static  int    uld_get_section_align(const shdr_type&) noexcept;
+  static  int    uld_get_section_pad_max(const shdr_type&) noexcept;
+          auto   uld_get_section_segment(bfd_type&, shdr_type&) noexcept -> segment*;
+          void   uld_reserve(bfd_type&, int) noexcept;
+  static  bool   uld_is_placed_before(const placing_t&, const placing_t&) noexcept;
+          bool   uld_rank(bfd_type&) noexcept;
+          bool   uld_preload(bfd_type&) noexcept;
+          bool   uld_import(bfd_type&) noexcept;
+          bool   uld_export() noexcept;
+          bool   uld_fixup() noexcept;
+          auto   uld_plan_segment(load_plan_t&, segment*) noexcept -> load_plan_t::segment_plan_t*;
+          void   uld_plan_read(bfd_type&, load_plan_t&, std::vector<bool>&, int) noexcept;
+          bool   uld_error(int, const char*, const char*, int, ...) noexcept;
+
+  virtual void   uld_bind_symbol(int, int, std::int32_t, std::int32_t) noexcept;
+  virtual bool   uld_resolve(bfd_type&) noexcept = 0;
+  virtual bool   uld_apply_rel(int, std::uint8_t*, symbol_t*) noexcept = 0;
+
+  public:
+          factory(image*, string_table_t*, symbol_table_t*, symbol_table_t*, symbol_index_t*, allocator_t* = nullptr) noexcept;
+          factory(const factory&) noexcept = delete;
+          factory(factory&&) noexcept = delete;
+  virtual ~factory();
+
+          bool     plan(bfd_type&, load_plan_t&) noexcept;
+          bool     prefetch(bfd_type&) noexcept;
+          int      get_place_count() const noexcept;
+          int      get_place_rank(int) const noexcept;
+          bool     place(bfd_type&, int) noexcept;
+          bool     import(bfd_type&) noexcept;
+          bool     link() noexcept;
+          bool     resolve(bfd_type&) noexcept;
+          bool     commit() noexcept;
+          bool     fixup() noexcept;
+
+          factory& operator=(const factory&) noexcept = delete;
+          factory& operator=(factory&&) noexcept = delete;
+};
+
+extern template class factory<bin_32>;
+extern template class factory<bin_64>;
+
+/*namespace elfxx*/ }
+/*namespace uld*/ }
+#endif
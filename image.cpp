@@ -29,22 +29,45 @@
 #include "bfd/elf64.h"
 #include <error.h>
 #include <cstdarg>
+#include <cstring>
+#include <vector>
 
       constexpr unsigned int s_state_clean = 0u;
       constexpr unsigned int s_state_set   = 1u;
       constexpr unsigned int s_state_error = 1u;
+      constexpr unsigned int s_state_stale = 2u;    // the address index holds the range of a redefined symbol
 
       constexpr unsigned int nop = 0;
       constexpr unsigned int op_collect = 1;
 
+      // initial size of the pages of the batch export pools: these end up in the image, slack included, and a batch often
+      // only has a handful of globals to export; larger batches grow the pools from there
+      constexpr int export_reserve_min = 256;
+
 namespace uld {
 
-      image::image(target* target) noexcept:
+      image::image(target* target, allocator_t* allocator, allocator_t* scratch, image* parent) noexcept:
       m_target(target),
-      m_string_table(),
-      m_symbol_table(std::addressof(m_string_table)),
-      m_program(m_target, std::addressof(m_string_table), std::addressof(m_symbol_table)),
-      m_state(s_state_clean)
+      m_parent(parent),
+      m_allocator(allocator != nullptr ? allocator : get_heap_allocator()),
+      m_scratch(scratch != nullptr ? scratch : get_heap_allocator()),
+      m_string_table(m_allocator, true),
+      m_symbol_table(std::addressof(m_string_table), m_allocator),
+      m_symbol_index(m_allocator),
+      m_symbol_filter(m_allocator),
+      m_frozen_table(m_allocator),
+      m_export_table(get_default_export_table()),
+      m_miss_cache(m_allocator),
+      m_address_index(m_allocator),
+      m_program(m_target, std::addressof(m_string_table), std::addressof(m_symbol_table), m_allocator),
+      m_fixup_table(m_allocator),
+      m_probe_table(m_allocator),
+      m_placement(nullptr),
+      m_state(s_state_clean),
+      m_load_options(load_default),
+      m_generation(0),
+      m_heap_peak(0),
+      m_load_stats()
 {
       uld_set();
 }
@@ -70,7 +93,7 @@ void  image::uld_set()
               int  l_got_table_size = l_got_entry_size * 2;
               bool l_lsb_bit = m_target->is_lsb();
               if(symbol_t*
-                  l_got_symbol = m_symbol_table.make_symbol(l_got_entry_name, symbol_t::type_object, symbol_t::bind_weak);
+                  l_got_symbol = uld_make_symbol(l_got_entry_name, symbol_t::type_object, symbol_t::bind_weak);
                   l_got_symbol != nullptr) {
                   std::uint8_t*  l_got_address = m_target->get_address_base();
                   std::uint8_t*  l_got_ptr     = l_rodata_segment->raw_get(l_got_table_size);
@@ -98,46 +121,33 @@ void  image::uld_set()
       }
 }
 
-bool  image::uld_load_elf32(bin_bfd_t& source, unsigned int operation) noexcept
+/* uld_open_object()
+   open an ELF object and check it can be loaded into this image: that it's relocatable and of the class and machine type
+   of the target
+*/
+template<typename Bt>
+auto  image::uld_open_object(raw_bfd_t& source) noexcept -> std::unique_ptr<Bt>
 {
-      if(operation != nop) {
-          elf32_bfd_t     l_elf32_file(source);
-          elf32::factory  l_elf32_factory(this);
-          unsigned int    l_target_machine_type = m_target->get_machine_type();
-          unsigned int    l_object_machine_type = l_elf32_file.get_machine_type();
-          if(l_target_machine_type == l_object_machine_type) {
-              l_elf32_factory.prefetch(l_elf32_file);
-              while(operation) {
-                  if(operation & op_collect) {
-                      if(unsigned int
-                          l_object_binary_type = l_elf32_file.get_object_type();
-                          l_object_binary_type == ET_REL) {
-                          if(l_elf32_factory.collect(l_elf32_file)) {
-                              operation ^= op_collect;
-                          } else
-                              break;
-                      } else
-                          return uld_error(1, "Refusing to load a non-relocatable ELF object.");
+      bin_bfd_t l_bin_file(source);
+      if(l_bin_file.has_class(m_target->get_class())) {
+          std::unique_ptr<Bt> l_elf_file(new(std::nothrow) Bt(l_bin_file));
+          if(l_elf_file) {
+              unsigned int l_target_machine_type = m_target->get_machine_type();
+              unsigned int l_object_machine_type = l_elf_file->get_machine_type();
+              if(l_target_machine_type == l_object_machine_type) {
+                  if(unsigned int
+                      l_object_binary_type = l_elf_file->get_object_type();
+                      l_object_binary_type == ET_REL) {
+                      return l_elf_file;
                   } else
-                      return uld_error(1, "Invalid target operation '%d' for architecture '%d'.", operation, l_object_machine_type);
-              }
-          } else
-              return uld_error(1, "Invalid target: '%d'.", l_object_machine_type);
-      }
-      return operation == nop;
-}
-
-bool  image::uld_load_object(raw_bfd_t& source, unsigned int operation) noexcept
-{
-      if(operation != nop) {
-          bin_bfd_t l_bin_file(source);
-          if(l_bin_file.has_class(bin_32) &&
-              m_target->has_class(bin_32)) {
-              return uld_load_elf32(l_bin_file, operation);
+                      uld_error(1, "Refusing to load a non-relocatable ELF object.");
+              } else
+                  uld_error(1, "Invalid target: '%d'.", l_object_machine_type);
           } else
-              return uld_error(1, "Invalid or unsupported object.");
-      }
-      return true;
+              uld_error(2, "Out of memory.");
+      } else
+          uld_error(1, "Invalid or unsupported object.");
+      return nullptr;
 }
 
 bool  image::uld_load_library(raw_bfd_t& source, unsigned int operation) noexcept
@@ -162,55 +172,1009 @@ bool  image::uld_error(int error, const char* message, ...) noexcept
       return error == 0;
 }
 
+/* uld_bind()
+   bind the batch index against the image, once all the objects in a batch have been imported; there is exactly one image
+   lookup per name, after which every slot holds the symbol the batch should link against:
+   - definitions take over the image placeholders left behind by the previous loads, and the weak definitions of the
+     image, unless weak themselves; only the scope of the image itself is looked up, those of the parent and the export
+     table being shadowed rather than redefined;
+   - references are rebound to the definitions of the image or of the scopes past it, or to new image placeholders if
+     none of them has any.
+*/
+bool  image::uld_bind(symbol_index_t& index) noexcept
+{
+      int  l_bind_error = 0;
+      for(symbol_index_t::slot_t& l_slot : index) {
+          symbol_t* l_local_ptr = l_slot.symbol;
+          if(l_local_ptr == nullptr) {
+              continue;
+          }
+          if(l_local_ptr->flags & symbol_t::bit_hidden) {
+              // hidden definitions are only there for the other objects of the batch to link against
+              continue;
+          }
+          if(l_local_ptr->ra != nullptr) {
+              // definition
+              symbol_t* l_image_ptr = uld_find_local(l_local_ptr->name, get_name_hash(l_local_ptr->name), symbol_t::bind_any);
+              if(l_image_ptr == nullptr) {
+                  continue;
+              }
+              if(l_image_ptr->ra == nullptr) {
+                  // the image has been waiting for this symbol: define the placeholder in place, the deferred relocations
+                  // point to it
+                  l_image_ptr->type = l_local_ptr->type;
+                  l_image_ptr->flags = (l_image_ptr->flags & ~symbol_t::bind_bits) | (l_local_ptr->flags & symbol_t::bind_bits);
+                  l_image_ptr->ea = l_local_ptr->ea;
+                  l_image_ptr->ra = l_local_ptr->ra;
+                  l_image_ptr->size = l_local_ptr->size;
+                  l_local_ptr->flags &= ~symbol_t::bit_export;
+                  l_slot.symbol = l_image_ptr;
+              } else
+              if((l_local_ptr->flags & symbol_t::bind_bits) == symbol_t::bind_weak) {
+                  // a weak definition yields to the one already in the image
+                  l_local_ptr->flags &= ~symbol_t::bit_export;
+                  l_slot.symbol = l_image_ptr;
+              } else
+              if((l_image_ptr->flags & symbol_t::bind_bits) == symbol_t::bind_weak) {
+                  // a strong definition overrides the weak one of the image: redefine the image symbol in place, as for a
+                  // placeholder, for the index and the frozen table to find the new definition under the same slot; the
+                  // address index has the former range dropped after the load
+                  if(l_image_ptr->flags & symbol_t::bit_address) {
+                      m_state |= s_state_stale;
+                  }
+                  l_image_ptr->type = l_local_ptr->type;
+                  l_image_ptr->flags = (l_image_ptr->flags & ~symbol_t::bind_bits) | (l_local_ptr->flags & symbol_t::bind_bits);
+                  l_image_ptr->ea = l_local_ptr->ea;
+                  l_image_ptr->ra = l_local_ptr->ra;
+                  l_image_ptr->size = l_local_ptr->size;
+                  l_local_ptr->flags &= ~symbol_t::bit_export;
+                  l_slot.symbol = l_image_ptr;
+                  m_generation++;
+              } else {
+                  uld_error(16, "Redefinition of symbol `%s`.", l_local_ptr->name);
+                  l_bind_error++;
+              }
+          } else {
+              // reference
+              symbol_t* l_image_ptr = find_symbol(l_local_ptr->name);
+              if(l_image_ptr != nullptr) {
+                  l_slot.symbol = l_image_ptr;
+              } else
+              if((l_local_ptr->flags & symbol_t::bind_bits) != symbol_t::bind_weak) {
+                  // strong reference to a symbol nobody defined yet: leave a placeholder in the image for a later load to
+                  // define; weak references stay local and resolve to null
+                  if(symbol_t*
+                      l_sym_ptr = uld_make_symbol(l_local_ptr->name, l_local_ptr->type, symbol_t::bind_global);
+                      l_sym_ptr != nullptr) {
+                      l_slot.symbol = l_sym_ptr;
+                  } else {
+                      uld_error(2, "Failed to reference symbol `%s`: out of memory.", l_local_ptr->name);
+                      l_bind_error++;
+                  }
+              }
+          }
+      }
+      return l_bind_error == 0;
+}
+
+/* uld_adopt()
+   take the pages of the batch export pool (and of its string table) over into the image tables: the definitions of the
+   batch join the image without being copied. The ones that did not make it into the image, having yielded to another
+   definition or been merged into an image placeholder by uld_bind(), have their names cleared for the lookups to skip
+   them; the others are renamed to the copies the image string table holds, if any, for name equality to remain pointer
+   equality. With `load_strip_unused`, the definitions no other object of the batch referenced are cleared as well, and
+   the remaining ones copied over rather than adopted (see uld_compact()).
+*/
+bool  image::uld_adopt(symbol_table_t& export_pool, symbol_index_t& index) noexcept
+{
+      string_table_t* l_string_pool = export_pool.get_string_table();
+      bool            l_strip_unused = m_load_options & load_strip_unused;
+      if(export_pool.begin().is_defined() == false) {
+          return true;
+      }
+      for(symbol_t& l_symbol : export_pool) {
+          if(l_symbol.name != nullptr) {
+              if(index.find_symbol(l_symbol.name) != std::addressof(l_symbol)) {
+                  l_symbol.name = nullptr;
+              } else
+              if(l_strip_unused) {
+                  if((l_symbol.flags & symbol_t::bit_import) == 0) {
+                      l_symbol.name = nullptr;
+                  }
+              }
+          }
+          l_symbol.flags &= ~symbol_t::bit_import;
+      }
+      if(l_strip_unused) {
+          return uld_compact(export_pool);
+      }
+      if(m_string_table.adopt(*l_string_pool) == false) {
+          return uld_error(2, "Failed to adopt the names of the batch: out of memory.");
+      }
+      for(symbol_t& l_symbol : export_pool) {
+          if(l_symbol.name != nullptr) {
+              l_symbol.name = m_string_table.find_string(l_symbol.name);
+              if(uld_index(std::addressof(l_symbol)) == false) {
+                  uld_reindex();
+                  return uld_error(2, "Failed to index the symbols of the batch: out of memory.");
+              }
+          }
+      }
+      if(m_symbol_table.adopt(export_pool) == false) {
+          uld_reindex();
+          return uld_error(2, "Failed to adopt the symbols of the batch.");
+      }
+      return true;
+}
+
+/* uld_compact()
+   `load_strip_unused` counterpart to the adoption of the export pool: the definitions still named are copied into the image tables,
+   filling the room left on their current pages first, and the export pool keeps its pages - dead slots and the names only
+   they used included - which go back to the allocator along with it at the end of the load
+*/
+bool  image::uld_compact(symbol_table_t& export_pool) noexcept
+{
+      int  l_symbol_count = 0;
+      int  l_string_count = 0;
+      int  l_string_size = 0;
+      for(symbol_t& l_symbol : export_pool) {
+          if(l_symbol.name != nullptr) {
+              if(m_string_table.find_string(l_symbol.name) == nullptr) {
+                  l_string_size += std::strlen(l_symbol.name) + 1;
+                  l_string_count++;
+              }
+              l_symbol_count++;
+          }
+      }
+      if(l_symbol_count == 0) {
+          return true;
+      }
+      m_symbol_table.reserve(l_symbol_count);
+      m_symbol_index.reserve(m_symbol_index.get_symbol_count() + l_symbol_count);
+      m_string_table.reserve(l_string_size, l_string_count);
+      for(symbol_t& l_symbol : export_pool) {
+          if(l_symbol.name != nullptr) {
+              symbol_t* l_copy_ptr = uld_make_symbol(l_symbol.name, l_symbol.type, l_symbol.flags);
+              if(l_copy_ptr == nullptr) {
+                  return uld_error(2, "Failed to export symbol `%s`: out of memory.", l_symbol.name);
+              }
+              l_copy_ptr->size = l_symbol.size;
+              l_copy_ptr->ea = l_symbol.ea;
+              l_copy_ptr->ra = l_symbol.ra;
+          }
+      }
+      return true;
+}
+
 bool  image::load(const char* file_name) noexcept
 {
-      raw_bfd_t l_raw_file(file_name);
-      if(l_raw_file) {
-          if(l_raw_file.has_type(file_type_archive)) {
-              return uld_load_library(l_raw_file, op_collect);
+      return load_all(std::addressof(file_name), 1);
+}
+
+/* uld_place()
+   load the hot code sections of a batch of prefetched objects, hottest first, then those the segment rules map, in the
+   order of their rules, all the objects together, such that the symbol import, which loads the other sections, leaves
+   them behind
+*/
+template<typename Bt, typename Ft>
+bool  image::uld_place(std::vector<std::unique_ptr<Bt>>& file_list, std::vector<std::unique_ptr<Ft>>& factory_list) noexcept
+{
+      int              l_file_count = factory_list.size();
+      std::vector<int> l_next_list(l_file_count, 0);
+      while(true) {
+          int  l_file_next = -1;
+          int  l_rank_next = 0;
+          for(int l_file_index = 0; l_file_index < l_file_count; l_file_index++) {
+              Ft*  l_factory_ptr = factory_list[l_file_index].get();
+              int  l_place_index = l_next_list[l_file_index];
+              if(l_place_index < l_factory_ptr->get_place_count()) {
+                  int l_rank = l_factory_ptr->get_place_rank(l_place_index);
+                  if((l_file_next < 0) ||
+                      (l_rank < l_rank_next)) {
+                      l_file_next = l_file_index;
+                      l_rank_next = l_rank;
+                  }
+              }
+          }
+          if(l_file_next < 0) {
+              break;
+          }
+          if(factory_list[l_file_next]->place(*file_list[l_file_next], l_next_list[l_file_next]) == false) {
+              return false;
+          }
+          l_next_list[l_file_next]++;
+      }
+      return true;
+}
+
+/* load_all()
+   load a batch of object files as a single link: all the objects are prefetched and imported first, then the undefined
+   references are bound once, against the combined definitions of the batch and those in the image, and only then are the
+   objects relocated and committed to the image
+*/
+template<typename Bt, typename Ft>
+bool  image::uld_load_all(const char** file_list, int file_count) noexcept
+{
+      scratch_allocator_t l_scratch(m_scratch);
+      string_table_t  l_string_pool(std::addressof(l_scratch), true);
+      symbol_table_t  l_symbol_pool(std::addressof(l_string_pool), std::addressof(l_scratch));
+      symbol_index_t  l_symbol_index(std::addressof(l_scratch));
+      string_table_t  l_export_string_pool(m_allocator, true, export_reserve_min);
+      symbol_table_t  l_export_symbol_pool(std::addressof(l_export_string_pool), m_allocator);
+      l_export_symbol_pool.reserve(export_reserve_min / sizeof(symbol_t));
+      std::vector<std::unique_ptr<Bt>> l_file_list;
+      std::vector<std::unique_ptr<Ft>> l_factory_list;
+      int             l_load_count = 0;
+      const char*     l_fail_name = nullptr;
+      const char*     l_fail_step = nullptr;
+      std::uint32_t   l_time_base;
+      if(file_count <= 0) {
+          return true;
+      }
+      l_file_list.reserve(file_count);
+      l_factory_list.reserve(file_count);
+      if(m_placement != nullptr) {
+          if(m_placement->update() == false) {
+              return uld_error(2, "Out of memory.");
+          }
+      }
+      // open and prefetch all the objects
+      l_time_base = stats::get_time();
+      for(int l_file_index = 0; l_file_index < file_count; l_file_index++) {
+          const char* l_file_name = file_list[l_file_index];
+          raw_bfd_t   l_raw_file(l_file_name);
+          if(l_raw_file) {
+              if(l_raw_file.has_type(file_type_archive)) {
+                  return uld_load_library(l_raw_file, op_collect);
+              } else
+              if(l_raw_file.has_type(file_type_elf) == false) {
+                  return uld_error(1, "File `%s` does not have a valid format.", l_file_name);
+              }
           } else
-          if(l_raw_file.has_type(file_type_elf)) {
-              return uld_load_object(l_raw_file, op_collect);
+              return uld_error(1, "File `%s` cannot be accessed.", l_file_name);
+          // the temporaries of an object take about as much memory as the object itself: size the scratch chunks such
+          // that the batch only needs a couple of them
+          l_scratch.reserve(f_size(static_cast<FIL*>(l_raw_file.get_file_ptr())));
+          std::unique_ptr<Bt> l_elf_file = uld_open_object<Bt>(l_raw_file);
+          if(l_elf_file == nullptr) {
+              return uld_error(1, "File `%s` cannot be loaded.", l_file_name);
+          }
+          std::unique_ptr<Ft> l_elf_factory(
+              new(std::nothrow) Ft(
+                  this,
+                  std::addressof(l_string_pool),
+                  std::addressof(l_symbol_pool),
+                  std::addressof(l_export_symbol_pool),
+                  std::addressof(l_symbol_index),
+                  std::addressof(l_scratch)
+              )
+          );
+          if(l_elf_factory == nullptr) {
+              return uld_error(2, "Out of memory.");
+          }
+          if(l_elf_factory->prefetch(*l_elf_file) == false) {
+              return uld_error(1, "File `%s` cannot be loaded: prefetch failed.", l_file_name);
+          }
+          l_file_list.push_back(std::move(l_elf_file));
+          l_factory_list.push_back(std::move(l_elf_factory));
+      }
+      // lay the hot code of the batch, and the sections the segment rules map, out ahead of the rest
+      if(uld_place(l_file_list, l_factory_list) == false) {
+          return uld_error(1, "Failed to place the sections of the batch.");
+      }
+      stats::on_phase(load_stats_t::phase_prefetch, l_time_base);
+      // import the symbol tables of all the objects into the batch index
+      l_time_base = stats::get_time();
+      for(int l_file_index = 0; l_file_index < file_count; l_file_index++) {
+          if(l_factory_list[l_file_index]->import(*l_file_list[l_file_index]) == false) {
+              l_fail_name = file_list[l_file_index];
+              l_fail_step = "import";
+              break;
+          }
+      }
+      stats::on_phase(load_stats_t::phase_import, l_time_base);
+      // bind the index against the image, then link, relocate and commit each object in turn
+      if(l_fail_step == nullptr) {
+          l_time_base = stats::get_time();
+          if(uld_bind(l_symbol_index) == false) {
+              l_fail_step = "bind";
+          }
+          stats::on_phase(load_stats_t::phase_bind, l_time_base);
+      }
+      if(l_fail_step == nullptr) {
+          l_time_base = stats::get_time();
+          for(int l_file_index = 0; l_file_index < file_count; l_file_index++) {
+              l_factory_list[l_file_index]->link();
+              if(l_factory_list[l_file_index]->resolve(*l_file_list[l_file_index]) == false) {
+                  l_fail_name = file_list[l_file_index];
+                  l_fail_step = "resolve";
+                  break;
+              }
+          }
+          stats::on_phase(load_stats_t::phase_resolve, l_time_base);
+      }
+      if(l_fail_step == nullptr) {
+          l_time_base = stats::get_time();
+          for(int l_file_index = 0; l_file_index < file_count; l_file_index++) {
+              if(l_factory_list[l_file_index]->commit() == false) {
+                  l_fail_name = file_list[l_file_index];
+                  l_fail_step = "commit";
+                  break;
+              }
+              ++l_load_count;
+          }
+          if(l_fail_step == nullptr) {
+              if(uld_adopt(l_export_symbol_pool, l_symbol_index) == false) {
+                  l_fail_step = "commit";
+              }
+          }
+          stats::on_phase(load_stats_t::phase_export, l_time_base);
+      }
+      // apply the image-wide deferred relocations the batch, or the outer scopes since the previous load, may have made
+      // resolvable; the batch is committed by now, so the ones that fail are reported and kept, but don't fail the load
+      if(l_fail_step == nullptr) {
+          if(m_fixup_table.get_fixup_count() > 0) {
+              uld_resolve_pending();
+              l_time_base = stats::get_time();
+              l_factory_list[0]->fixup();
+              stats::on_phase(load_stats_t::phase_fixup, l_time_base);
+          }
+      }
+      if(l_fail_step != nullptr) {
+          if(l_fail_name != nullptr) {
+              return uld_error(1, "Failed to load `%s` at the %s step (%d of %d objects loaded).", l_fail_name, l_fail_step, l_load_count, file_count);
+          }
+          return uld_error(1, "Failed to load objects at the %s step (%d of %d objects loaded).", l_fail_step, l_load_count, file_count);
+      }
+      if constexpr (is_debug) {
+          printf(
+              "(i) Loaded %d objects, %d names linked, %d relocations pending.\n",
+              l_load_count,
+              l_symbol_index.get_symbol_count(),
+              m_fixup_table.get_fixup_count()
+          );
+      }
+      return true;
+}
+
+/* uld_load_all()
+   load a batch with the decoder and factory of the class of the target: ELF32 objects for the 32 bit targets, ELF64
+   x86-64 objects for the 64 bit ones
+*/
+bool  image::uld_load_all(const char** file_list, int file_count) noexcept
+{
+      if(m_target->has_class(bin_32)) {
+          return uld_load_all<elf32_bfd_t, elf32::factory>(file_list, file_count);
+      } else
+      if(m_target->has_class(bin_64)) {
+          return uld_load_all<elf64_bfd_t, elf64::factory>(file_list, file_count);
+      }
+      return uld_error(1, "Invalid or unsupported target class.");
+}
+
+bool  image::load_all(const char** file_list, int file_count) noexcept
+{
+      bool l_load_success;
+      if constexpr (load_stats_enable) {
+          if(m_load_stats == nullptr) {
+              m_load_stats.reset(new(std::nothrow) load_stats_t);
+          }
+          if(m_load_stats != nullptr) {
+              std::memset(m_load_stats.get(), 0, sizeof(load_stats_t));
+          }
+          stats::begin(m_load_stats.get());
+      }
+      stats::reset_heap_peak();
+      l_load_success = uld_load_all(file_list, file_count);
+      if(m_state & s_state_stale) {
+          if(uld_index_addresses(true) == false) {
+              l_load_success = false;
           } else
+              m_state &= ~s_state_stale;
+      } else
+      if(uld_index_addresses(false) == false) {
+          l_load_success = false;
+      }
+      m_generation++;
+      m_heap_peak = stats::s_heap_peak;
+      stats::end();
+      return l_load_success;
+}
+
+/* plan()
+   estimate what loading the given object would take, without loading it: only the headers and the symbol and relocation
+   tables are read, and no memory is allocated into the image
+*/
+bool  image::plan(const char* file_name, load_plan_t& plan) noexcept
+{
+      raw_bfd_t   l_raw_file(file_name);
+      if(l_raw_file) {
+          if(l_raw_file.has_type(file_type_elf) == false) {
               return uld_error(1, "File `%s` does not have a valid format.", file_name);
+          }
       } else
           return uld_error(1, "File `%s` cannot be accessed.", file_name);
+      if(m_target->has_class(bin_64)) {
+          std::unique_ptr<elf64_bfd_t> l_elf64_file = uld_open_object<elf64_bfd_t>(l_raw_file);
+          if(l_elf64_file == nullptr) {
+              return uld_error(1, "File `%s` cannot be loaded.", file_name);
+          }
+          elf64::factory l_elf64_factory(this, nullptr, nullptr, nullptr, nullptr);
+          return l_elf64_factory.plan(*l_elf64_file, plan);
+      }
+      std::unique_ptr<elf32_bfd_t> l_elf32_file = uld_open_object<elf32_bfd_t>(l_raw_file);
+      if(l_elf32_file == nullptr) {
+          return uld_error(1, "File `%s` cannot be loaded.", file_name);
+      }
+      elf32::factory l_elf32_factory(this, nullptr, nullptr, nullptr, nullptr);
+      return l_elf32_factory.plan(*l_elf32_file, plan);
 }
 
-symbol_t* image::find_symbol(const char* name, unsigned int bind_flags) noexcept
+unsigned int image::get_load_options() const noexcept
 {
-      return m_symbol_table.find_symbol(name, bind_flags);
+      return m_load_options;
 }
 
-symbol_t* image::make_symbol(const char* name, unsigned int type, unsigned int flags) noexcept
+/* set_load_options()
+   select how the following loads export their definitions (see `load_*`): `load_strip_unused` drops the definitions of a
+   batch which no other object of that batch references - those the host is to look up after the load must then be
+   declared beforehand, through `make_symbol()`, for their placeholders to be defined by the batch; `load_strip_hidden`
+   keeps the hidden and internal ones within their batch. With the former, the few definitions the image keeps are copied
+   into its tables, instead of it adopting the pages they were loaded into.
+*/
+void  image::set_load_options(unsigned int options) noexcept
 {
-      return m_symbol_table.make_symbol(name, type, flags);
+      m_load_options = options;
 }
 
-symbol_t* image::make_symbol(const char* name, unsigned int type, unsigned int flags, void* bind_address, void* virtual_address) noexcept
+image*  image::get_parent() noexcept
 {
-      symbol_t* l_symbol = m_symbol_table.make_symbol(name, type, flags);
-      if(l_symbol != nullptr) {
-          if(bind_address != nullptr) {
-              auto    l_am = m_target->get_address_mask();
-              ssize_t l_ea = reinterpret_cast<ssize_t>(bind_address);
-              ssize_t l_ra = l_ea;
-              if(type == symbol_t::type_function) {
-                  ssize_t l_aa =(1 << m_target->get_address_align()) - 1;
-                  if(virtual_address != nullptr) {
-                      l_ra = reinterpret_cast<ssize_t>(virtual_address);
+      return m_parent;
+}
+
+/* set_parent()
+   set the image the lookups of this one fall back to, after its own scope and before the export table, or nullptr for
+   none: the loads of the image link against the definitions of the parent (and of its own parents) in place, without
+   copying them, such that the parent has to outlive the image. The placeholders of the parent are never bound to.
+*/
+bool  image::set_parent(image* parent) noexcept
+{
+      for(image* i_parent = parent; i_parent != nullptr; i_parent = i_parent->m_parent) {
+          if(i_parent == this) {
+              return uld_error(1, "Cannot make an image a parent of its own.");
+          }
+      }
+      m_parent = parent;
+      m_miss_cache.clear();
+      m_generation++;
+      return true;
+}
+
+int   image::get_miss_cache_size() const noexcept
+{
+      return m_miss_cache.get_size();
+}
+
+/* set_miss_cache_size()
+   enable the negative lookup cache (see `miss_cache_t`), with room for `count` names, or disable it with 0; mostly of use
+   to images with a parent, whose lookups of missing names go through every scope of the chain
+*/
+bool  image::set_miss_cache_size(int count) noexcept
+{
+      if(m_miss_cache.resize(count) == false) {
+          return uld_error(2, "Failed to set up the miss cache: out of memory.");
+      }
+      return true;
+}
+
+/* freeze()
+   pack all the defined symbols of the image into the frozen table, where a lookup is a single probe, and give the pages of
+   the symbol table back: from then on, the symbol table only holds the symbols still waiting for a definition and those
+   the loads to come add, until the next freeze(). The pending fixups are carried over, but any symbol pointer obtained
+   before is no longer valid, which goes for the images this one is the parent of, too.
+*/
+bool  image::freeze() noexcept
+{
+      scratch_allocator_t l_scratch(m_scratch);
+      block_list_t<symbol_t> l_symbol_list(std::addressof(l_scratch));
+      frozen_table_t  l_frozen_table(m_allocator);
+      symbol_table_t  l_symbol_table(std::addressof(m_string_table), m_allocator);
+      symbol_index_t  l_symbol_index(std::addressof(l_scratch));
+      int             l_pending_count = 0;
+      // gather the defined symbols, the ones already frozen first, and count the placeholders
+      for(symbol_t& l_symbol : m_frozen_table) {
+          if(l_symbol.name != nullptr) {
+              if(l_symbol_list.push_back(l_symbol) == false) {
+                  return uld_error(2, "Failed to freeze the symbol table: out of memory.");
+              }
+          }
+      }
+      for(symbol_t& l_symbol : m_symbol_table) {
+          if(l_symbol.name != nullptr) {
+              if(l_symbol.ra != nullptr) {
+                  if(l_symbol_list.push_back(l_symbol) == false) {
+                      return uld_error(2, "Failed to freeze the symbol table: out of memory.");
+                  }
+              } else
+                  l_pending_count++;
+          }
+      }
+      if(l_frozen_table.assign(l_symbol_list.data(), l_symbol_list.size(), std::addressof(l_scratch)) == false) {
+          return uld_error(2, "Failed to freeze the symbol table: out of memory.");
+      }
+      // copy the placeholders into pages sized to fit, and index them, then the frozen symbols, for the pending fixups to
+      // find their new copies by name
+      if(l_pending_count > 0) {
+          l_symbol_table.reserve(l_pending_count);
+          for(symbol_t& l_symbol : m_symbol_table) {
+              if((l_symbol.name != nullptr) &&
+                  (l_symbol.ra == nullptr)) {
+                  symbol_t* l_copy_ptr = l_symbol_table.make_symbol(l_symbol.name, l_symbol.type, l_symbol.flags);
+                  if(l_copy_ptr == nullptr) {
+                      return uld_error(2, "Failed to freeze the symbol table: out of memory.");
+                  }
+                  l_copy_ptr->size = l_symbol.size;
+                  l_copy_ptr->ea = l_symbol.ea;
+              }
+          }
+      }
+      if(m_fixup_table.get_fixup_count() > 0) {
+          for(symbol_t& l_symbol : l_symbol_table) {
+              symbol_index_t::slot_t* l_slot_ptr = l_symbol_index.make_slot(l_symbol.name, get_name_hash(l_symbol.name));
+              if(l_slot_ptr == nullptr) {
+                  return uld_error(2, "Failed to freeze the symbol table: out of memory.");
+              }
+              l_slot_ptr->symbol = std::addressof(l_symbol);
+          }
+          for(symbol_t& l_symbol : l_frozen_table) {
+              if(l_symbol.name != nullptr) {
+                  symbol_index_t::slot_t* l_slot_ptr = l_symbol_index.make_slot(l_symbol.name, get_name_hash(l_symbol.name));
+                  if(l_slot_ptr == nullptr) {
+                      return uld_error(2, "Failed to freeze the symbol table: out of memory.");
+                  }
+                  if(l_slot_ptr->symbol == nullptr) {
+                      l_slot_ptr->symbol = std::addressof(l_symbol);
                   }
-                  if(l_ea & l_aa) {
-                      l_ea = l_ea & l_am;
+              }
+          }
+          for(fixup_t& l_fixup : m_fixup_table) {
+              if(l_fixup.symbol != nullptr) {
+                  if(l_symbol_index.find_symbol(l_fixup.symbol->name) == nullptr) {
+                      return uld_error(2, "Failed to freeze the symbol table: fixup against a lost symbol `%s`.", l_fixup.symbol->name);
                   }
               }
-              l_symbol->ea = reinterpret_cast<std::uint8_t*>(l_ea);
-              l_symbol->ra = reinterpret_cast<std::uint8_t*>(l_ra);
           }
+          for(fixup_t& l_fixup : m_fixup_table) {
+              if(l_fixup.symbol != nullptr) {
+                  l_fixup.symbol = l_symbol_index.find_symbol(l_fixup.symbol->name);
+              }
+          }
+      }
+      // the symbols are about to move: have the address lookups find nothing until they are indexed again, which they are
+      // from here on whether the rest succeeds or not
+      m_address_index.clear();
+      m_frozen_table.swap(l_frozen_table);
+      m_symbol_table.release();
+      m_generation++;
+      if(m_symbol_table.adopt(l_symbol_table) == false) {
+          uld_index_addresses(true);
+          return false;
+      }
+      if(uld_reindex() == false) {
+          uld_index_addresses(true);
+          return false;
+      }
+      return uld_index_addresses(true);
+}
+
+/* uld_set_address()
+   set the addresses of a symbol defined by the host: `bind_address` is what the loaded code should branch to or read
+   from (for thumb functions, with bit 0 set), `virtual_address`, if given, the address to report for the symbol
+*/
+void  image::uld_set_address(symbol_t* symbol, void* bind_address, void* virtual_address) noexcept
+{
+      if(bind_address != nullptr) {
+          auto    l_am = m_target->get_address_mask();
+          ssize_t l_ea = reinterpret_cast<ssize_t>(bind_address);
+          ssize_t l_ra = l_ea;
+          if(symbol->type == symbol_t::type_function) {
+              ssize_t l_aa =(1 << m_target->get_address_align()) - 1;
+              if(virtual_address != nullptr) {
+                  l_ra = reinterpret_cast<ssize_t>(virtual_address);
+              }
+              if(l_ea & l_aa) {
+                  l_ea = l_ea & l_am;
+              }
+          }
+          symbol->ea = reinterpret_cast<std::uint8_t*>(l_ea);
+          symbol->ra = reinterpret_cast<std::uint8_t*>(l_ra);
+      }
+}
+
+/* uld_find_export()
+   look a symbol the image tables don't define up in the export table: a hit is given a symbol in the symbol table, or
+   defines the `placeholder` the tables hold for it, if any, for the loads to link against; exports that are never
+   referenced cost no memory
+*/
+auto  image::uld_find_export(const char* name, std::uint32_t hash, unsigned int bind_flags, symbol_t* placeholder) noexcept -> symbol_t*
+{
+      if(const export_t*
+          l_export_ptr = m_export_table->find_export(name, hash, bind_flags);
+          l_export_ptr != nullptr) {
+          symbol_t* l_symbol_ptr = placeholder;
+          if(l_symbol_ptr == nullptr) {
+              l_symbol_ptr = uld_make_symbol(name, l_export_ptr->type, l_export_ptr->flags);
+              if(l_symbol_ptr == nullptr) {
+                  uld_error(2, "Failed to import symbol `%s`: out of memory.", name);
+                  return nullptr;
+              }
+          } else {
+              l_symbol_ptr->type = l_export_ptr->type;
+              l_symbol_ptr->flags = (l_symbol_ptr->flags & ~symbol_t::bind_bits) | l_export_ptr->flags;
+              m_generation++;
+          }
+          uld_set_address(l_symbol_ptr, const_cast<void*>(l_export_ptr->address), nullptr);
+          return l_symbol_ptr;
+      }
+      return placeholder;
+}
+
+/* uld_make_symbol()
+   add a symbol to the symbol table and its index; names are expected to be new to the table
+*/
+auto  image::uld_make_symbol(const char* name, unsigned int type, unsigned int flags) noexcept -> symbol_t*
+{
+      symbol_t* l_symbol_ptr = m_symbol_table.make_symbol(name, type, flags);
+      if(l_symbol_ptr != nullptr) {
+          if(uld_index(l_symbol_ptr) == false) {
+              l_symbol_ptr->name = nullptr;
+              return nullptr;
+          }
+      }
+      return l_symbol_ptr;
+}
+
+/* uld_index()
+   enter a symbol of the symbol table into its index and filter, unless the index already holds one of the same name;
+   the filter is rebuilt twice as large when full
+*/
+bool  image::uld_index(symbol_t* symbol) noexcept
+{
+      if((symbol->name != nullptr) &&
+          (symbol->name[0] != 0)) {
+          std::uint32_t           l_hash = get_name_hash(symbol->name);
+          symbol_index_t::slot_t* l_slot_ptr = m_symbol_index.make_slot(symbol->name, l_hash);
+          if(l_slot_ptr == nullptr) {
+              return false;
+          }
+          if(l_slot_ptr->symbol == nullptr) {
+              l_slot_ptr->symbol = symbol;
+              if(m_symbol_filter.is_full()) {
+                  if(uld_refilter(m_symbol_filter.get_name_count() * 2) == false) {
+                      return false;
+                  }
+              } else
+                  m_symbol_filter.put_hash(l_hash);
+          }
+          m_generation++;
+      }
+      return true;
+}
+
+/* uld_reindex()
+   rebuild the index of the symbol table from scratch, into slots sized to fit
+*/
+bool  image::uld_reindex() noexcept
+{
+      symbol_index_t l_symbol_index(m_allocator);
+      int            l_symbol_count = 0;
+      for(symbol_t& l_symbol : m_symbol_table) {
+          if(l_symbol.name != nullptr) {
+              l_symbol_count++;
+          }
+      }
+      m_symbol_index.swap(l_symbol_index);
+      m_generation++;
+      if(uld_refilter(m_frozen_table.get_symbol_count() + l_symbol_count) == false) {
+          return uld_error(2, "Failed to index the symbol table: out of memory.");
+      }
+      if(l_symbol_count > 0) {
+          if(m_symbol_index.reserve(l_symbol_count) == false) {
+              return uld_error(2, "Failed to index the symbol table: out of memory.");
+          }
+          for(symbol_t& l_symbol : m_symbol_table) {
+              if(uld_index(std::addressof(l_symbol)) == false) {
+                  return uld_error(2, "Failed to index the symbol table: out of memory.");
+              }
+          }
+      }
+      return true;
+}
+
+/* uld_refilter()
+   rebuild the filter of the image for `count` names, or the ones it holds if more, and put them back in: those of the
+   frozen table, and those the symbol index holds
+*/
+bool  image::uld_refilter(int count) noexcept
+{
+      int  l_name_count = m_frozen_table.get_symbol_count() + m_symbol_index.get_symbol_count();
+      if(m_symbol_filter.reserve(count > l_name_count ? count : l_name_count) == false) {
+          return false;
+      }
+      for(symbol_t& l_symbol : m_frozen_table) {
+          if(l_symbol.name != nullptr) {
+              m_symbol_filter.put_hash(get_name_hash(l_symbol.name));
+          }
+      }
+      for(symbol_index_t::slot_t& l_slot : m_symbol_index) {
+          if(l_slot.symbol != nullptr) {
+              m_symbol_filter.put_hash(l_slot.hash);
+          }
+      }
+      return true;
+}
+
+/* uld_index_addresses()
+   enter the functions and objects of the image tables the address index doesn't hold yet into it, or, if `rebuild`, all
+   of them in place of what it holds
+*/
+bool  image::uld_index_addresses(bool rebuild) noexcept
+{
+      scratch_allocator_t l_scratch(m_scratch);
+      block_list_t<symbol_t*> l_symbol_list(std::addressof(l_scratch));
+      for(symbol_t& l_symbol : m_frozen_table) {
+          if(l_symbol.name != nullptr) {
+              if(rebuild || ((l_symbol.flags & symbol_t::bit_address) == 0)) {
+                  if(((l_symbol.type == symbol_t::type_function) || (l_symbol.type == symbol_t::type_object)) &&
+                      (l_symbol.ra != nullptr) &&
+                      (l_symbol.size > 0)) {
+                      if(l_symbol_list.push_back(std::addressof(l_symbol)) == false) {
+                          return uld_error(2, "Failed to index the symbol addresses: out of memory.");
+                      }
+                      l_symbol.flags |= symbol_t::bit_address;
+                  }
+              }
+          }
+      }
+      for(symbol_t& l_symbol : m_symbol_table) {
+          if(l_symbol.name != nullptr) {
+              if(rebuild || ((l_symbol.flags & symbol_t::bit_address) == 0)) {
+                  if(((l_symbol.type == symbol_t::type_function) || (l_symbol.type == symbol_t::type_object)) &&
+                      (l_symbol.ra != nullptr) &&
+                      (l_symbol.size > 0)) {
+                      if(l_symbol_list.push_back(std::addressof(l_symbol)) == false) {
+                          return uld_error(2, "Failed to index the symbol addresses: out of memory.");
+                      }
+                      l_symbol.flags |= symbol_t::bit_address;
+                  }
+              }
+          }
+      }
+      if(rebuild) {
+          if(m_address_index.assign(l_symbol_list.data(), l_symbol_list.size(), std::addressof(l_scratch)) == false) {
+              return uld_error(2, "Failed to index the symbol addresses: out of memory.");
+          }
+      } else
+      if(l_symbol_list.size() > 0) {
+          if(m_address_index.insert(l_symbol_list.data(), l_symbol_list.size(), std::addressof(l_scratch)) == false) {
+              return uld_error(2, "Failed to index the symbol addresses: out of memory.");
+          }
+      }
+      return true;
+}
+
+/* uld_find_local()
+   look a symbol up in the scope of the image itself: the frozen table, then the index of the symbol table, unless the
+   filter rules the name out of both
+*/
+auto  image::uld_find_local(const char* name, std::uint32_t hash, unsigned int bind_flags) noexcept -> symbol_t*
+{
+      if(m_symbol_filter.has_hash(hash) == false) {
+          stats::on_lookup(0);
+          return nullptr;
+      }
+      if(symbol_t*
+          l_symbol_ptr = m_frozen_table.find_symbol(name, hash, bind_flags);
+          l_symbol_ptr != nullptr) {
+          return l_symbol_ptr;
+      }
+      if(m_symbol_index.get_symbol_count() == 0) {
+          return nullptr;
+      }
+      if(symbol_index_t::slot_t*
+          l_slot_ptr = m_symbol_index.get_slot(name, hash);
+          l_slot_ptr != nullptr) {
+          unsigned int l_flags = bind_flags & symbol_t::bind_any;
+          if((l_flags == symbol_t::bind_any) ||
+              ((l_flags & l_slot_ptr->symbol->flags) == l_flags)) {
+              return l_slot_ptr->symbol;
+          }
+      }
+      return nullptr;
+}
+
+/* uld_find_outer()
+   look a symbol the image doesn't define up in the scopes past its own: the parent first, the whole of its chain
+   included, then the export table, unless it's the one of the parent, which has seen to it already. A definition found
+   there defines the `placeholder` the image holds for the name, if any, for the pending fixups against it to be applied
+*/
+auto  image::uld_find_outer(const char* name, std::uint32_t hash, unsigned int bind_flags, symbol_t* placeholder) noexcept -> symbol_t*
+{
+      if(m_parent != nullptr) {
+          if(symbol_t*
+              l_parent_ptr = m_parent->find_symbol(name, bind_flags);
+              (l_parent_ptr != nullptr) &&
+              (l_parent_ptr->ra != nullptr)) {
+              if(placeholder == nullptr) {
+                  return l_parent_ptr;
+              }
+              placeholder->type = l_parent_ptr->type;
+              placeholder->flags = (placeholder->flags & ~symbol_t::bind_bits) | (l_parent_ptr->flags & symbol_t::bind_bits);
+              placeholder->size = l_parent_ptr->size;
+              placeholder->ea = l_parent_ptr->ea;
+              placeholder->ra = l_parent_ptr->ra;
+              m_generation++;
+              return placeholder;
+          }
+          if(m_export_table == m_parent->get_export_table()) {
+              return placeholder;
+          }
+      }
+      if(m_export_table != nullptr) {
+          return uld_find_export(name, hash, bind_flags, placeholder);
+      }
+      return placeholder;
+}
+
+/* uld_resolve_pending()
+   look the placeholders the pending fixups refer to up in the outer scopes, for those the parent (or the export table)
+   came to define since they were left behind to be defined in place
+*/
+void  image::uld_resolve_pending() noexcept
+{
+      if((m_parent != nullptr) ||
+          (m_export_table != nullptr)) {
+          for(fixup_t& l_fixup : m_fixup_table) {
+              symbol_t* l_symbol_ptr = l_fixup.symbol;
+              if((l_symbol_ptr != nullptr) &&
+                  (l_symbol_ptr->ra == nullptr)) {
+                  uld_find_outer(l_symbol_ptr->name, get_name_hash(l_symbol_ptr->name), symbol_t::bind_any, l_symbol_ptr);
+              }
+          }
+      }
+}
+
+/* uld_get_generation()
+   generation of the chain of scopes of the image: changes whenever the symbols of any of them do
+*/
+auto  image::uld_get_generation() const noexcept -> std::uint32_t
+{
+      std::uint32_t l_generation = m_generation;
+      for(const image* i_parent = m_parent; i_parent != nullptr; i_parent = i_parent->m_parent) {
+          l_generation += i_parent->m_generation;
+      }
+      return l_generation;
+}
+
+/* find_symbol()
+   look a symbol up in the scope of the image - the frozen table first, then the symbol table - and, if it doesn't define
+   it, in the scopes of its parent, then in the export table; with the miss cache enabled, names known to be missing
+   from all of them return right away
+*/
+symbol_t* image::find_symbol(const char* name, unsigned int bind_flags) noexcept
+{
+      std::uint32_t l_generation = 0;
+      std::uint32_t l_hash;
+      if((name == nullptr) ||
+          (name[0] == 0)) {
+          return nullptr;
+      }
+      l_hash = get_name_hash(name);
+      if(m_miss_cache.get_size() > 0) {
+          l_generation = uld_get_generation();
+          if(m_miss_cache.has_name(name, l_hash, l_generation)) {
+              return nullptr;
+          }
+      }
+      symbol_t* l_symbol_ptr = uld_find_local(name, l_hash, bind_flags);
+      if((l_symbol_ptr == nullptr) ||
+          (l_symbol_ptr->ra == nullptr)) {
+          l_symbol_ptr = uld_find_outer(name, l_hash, bind_flags, l_symbol_ptr);
+          if((l_symbol_ptr == nullptr) &&
+              ((bind_flags & symbol_t::bind_any) == symbol_t::bind_any)) {
+              m_miss_cache.put_name(name, l_hash, l_generation);
+          }
+      }
+      return l_symbol_ptr;
+}
+
+/* find_image_symbol()
+   look a symbol up in the scopes of the image and its parents only, leaving the export table out, and allocating
+   nothing
+*/
+symbol_t* image::find_image_symbol(const char* name, unsigned int bind_flags) noexcept
+{
+      if((name == nullptr) ||
+          (name[0] == 0)) {
+          return nullptr;
+      }
+      symbol_t* l_symbol_ptr = uld_find_local(name, get_name_hash(name), bind_flags);
+      if((l_symbol_ptr == nullptr) ||
+          (l_symbol_ptr->ra == nullptr)) {
+          if(m_parent != nullptr) {
+              if(symbol_t*
+                  l_parent_ptr = m_parent->find_image_symbol(name, bind_flags);
+                  (l_parent_ptr != nullptr) &&
+                  (l_parent_ptr->ra != nullptr)) {
+                  return l_parent_ptr;
+              }
+          }
+      }
+      return l_symbol_ptr;
+}
+
+/* find_export()
+   look a symbol up in the export table
+*/
+auto  image::find_export(const char* name, unsigned int bind_flags) const noexcept -> const export_t*
+{
+      if(m_export_table != nullptr) {
+          return m_export_table->find_export(name, bind_flags);
+      }
+      return nullptr;
+}
+
+/* find_symbol_by_address()
+   the function or object of the image whose range holds `address`, or nullptr; only the scope of the image itself is
+   searched. Neither allocates nor takes locks, and may be called from interrupt context, e.g. to tell which module a
+   fault or a profiler sample falls into, save while freeze() runs, which leaves it finding nothing.
+*/
+symbol_t* image::find_symbol_by_address(const void* address) const noexcept
+{
+      return m_address_index.find_symbol(address);
+}
+
+symbol_t* image::make_symbol(const char* name, unsigned int type, unsigned int flags) noexcept
+{
+      return uld_make_symbol(name, type, flags);
+}
+
+symbol_t* image::make_symbol(const char* name, unsigned int type, unsigned int flags, void* bind_address, void* virtual_address) noexcept
+{
+      symbol_t* l_symbol = uld_make_symbol(name, type, flags);
+      if(l_symbol != nullptr) {
+          uld_set_address(l_symbol, bind_address, virtual_address);
       }
       return l_symbol;
 }
 
+/* make_probe()
+   have the calls the later loads make to the function `name` go through a counting trampoline, for the probe to keep
+   the count of the calls and the time spent in them, callees included (see image/probe_table.h); only thumb calls
+   (R_ARM_THM_CALL) are redirected, and only on thumb targets, calls to the function made through a pointer or already
+   relocated bypassing the probe. Only global and weak functions are probed, never the local (`static`) ones, and the
+   probe binds to the first function it redirects calls to: those to another function of the same name, i.e. one which
+   redefines it later, aren't redirected
+*/
+probe_t*  image::make_probe(const char* name) noexcept
+{
+      if(m_target->is_vle() == false) {
+          uld_error(1, "Failed to probe `%s`: probes are only supported on thumb targets.", name);
+          return nullptr;
+      }
+      if(const char*
+          l_name = m_string_table.make_string(name);
+          l_name != nullptr) {
+          if(probe_t*
+              l_probe_ptr = m_probe_table.make_probe(l_name);
+              l_probe_ptr != nullptr) {
+              return l_probe_ptr;
+          }
+      }
+      uld_error(2, "Failed to probe `%s`: out of memory.", name);
+      return nullptr;
+}
+
 segment*  image::get_segment_by_name(const char* name) noexcept
 {
       return m_program.get_segment_by_name(name);
@@ -221,6 +1185,14 @@ segment*  image::get_segment_by_attributes(unsigned int type, unsigned int flags
       return m_program.get_segment_by_attributes(type, flags);
 }
 
+/* get_segment_by_section()
+   the segment a section of the given name, type and flags goes to, see `program_table_t::add_segment_rule()`
+*/
+segment*  image::get_segment_by_section(const char* name, unsigned int type, unsigned int flags, int* rule_index) noexcept
+{
+      return m_program.get_segment_by_section(name, type, flags, rule_index);
+}
+
 int   image::get_segment_count() const noexcept
 {
       return m_program.get_segment_count();
@@ -241,9 +1213,111 @@ auto  image::get_symbol_table() noexcept -> symbol_table_t*
       return std::addressof(m_symbol_table);
 }
 
+auto  image::get_frozen_table() noexcept -> frozen_table_t*
+{
+      return std::addressof(m_frozen_table);
+}
+
+/* get_symbol_filter()
+   the filter over the names of the frozen and symbol tables, which most lookups of a name the image doesn't hold stop at
+*/
+auto  image::get_symbol_filter() const noexcept -> const bloom_filter_t*
+{
+      return std::addressof(m_symbol_filter);
+}
+
+/* get_address_index()
+   the index of the ranges of the functions and objects of the image, see find_symbol_by_address()
+*/
+auto  image::get_address_index() const noexcept -> const address_index_t*
+{
+      return std::addressof(m_address_index);
+}
+
+/* get_export_table()
+   the export table the image falls back to, by default the one linked into the firmware (see
+   get_default_export_table())
+*/
+auto  image::get_export_table() const noexcept -> const export_table_t*
+{
+      return m_export_table;
+}
+
+/* set_export_table()
+   replace the export table the image falls back to, or do without one if nullptr; symbols already taken from the
+   previous table remain
+*/
+void  image::set_export_table(const export_table_t* export_table) noexcept
+{
+      m_export_table = export_table;
+      m_miss_cache.clear();
+      m_generation++;
+}
+
 auto  image::get_program_table() noexcept -> program_table_t*
 {
       return std::addressof(m_program);
 }
 
+auto  image::get_fixup_table() noexcept -> fixup_table_t*
+{
+      return std::addressof(m_fixup_table);
+}
+
+auto  image::get_probe_table() noexcept -> probe_table_t*
+{
+      return std::addressof(m_probe_table);
+}
+
+/* get_placement()
+   the placement profile the loads lay the code out by, if any
+*/
+auto  image::get_placement() noexcept -> placement_t*
+{
+      return m_placement;
+}
+
+/* set_placement()
+   have the later loads lay out the code sections holding the functions `placement` lists ahead of the others, in the
+   order of the profile, or in the order they're found if nullptr; the image doesn't take over the profile, which has to
+   outlive it
+*/
+void  image::set_placement(placement_t* placement) noexcept
+{
+      m_placement = placement;
+}
+
+/* get_load_stats()
+   statistics of the latest load; always nullptr unless built with load stats enabled (see `load_stats_enable`)
+*/
+auto  image::get_load_stats() const noexcept -> const load_stats_t*
+{
+      return m_load_stats.get();
+}
+
+/* get_memory_stats()
+   memory currently held by the pools of the image, along with the heap high watermark of the latest load; per segment
+   figures are available from the program table
+*/
+void  image::get_memory_stats(image_memory_stats_t& stats) const noexcept
+{
+      std::memset(std::addressof(stats), 0, sizeof(image_memory_stats_t));
+      m_string_table.get_memory_stats(stats.string_table);
+      m_symbol_table.get_memory_stats(stats.symbol_table);
+      m_symbol_index.get_memory_stats(stats.symbol_table);
+      m_symbol_filter.get_memory_stats(stats.symbol_table);
+      m_frozen_table.get_memory_stats(stats.symbol_table);
+      m_miss_cache.get_memory_stats(stats.symbol_table);
+      m_address_index.get_memory_stats(stats.symbol_table);
+      m_fixup_table.get_memory_stats(stats.fixup_table);
+      m_probe_table.get_memory_stats(stats.program_table);
+      m_program.get_memory_stats(stats.program_table);
+      stats.total.add(stats.string_table);
+      stats.total.add(stats.symbol_table);
+      stats.total.add(stats.fixup_table);
+      stats.total.add(stats.program_table);
+      stats.heap_used = stats::s_heap_used;
+      stats.heap_peak = m_heap_peak;
+}
+
 /*namespace uld*/ }
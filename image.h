@@ -23,58 +23,144 @@
 **/
 #include <uld.h>
 #include "target.h"
+#include "stats.h"
+#include "plan.h"
 #include "image/data.h"
+#include "image/allocator.h"
 #include "image/segment.h"
 #include "image/string_table.h"
 #include "image/symbol_table.h"
+#include "image/frozen_table.h"
+#include "image/export_table.h"
+#include "image/symbol_index.h"
+#include "image/miss_cache.h"
+#include "image/bloom_filter.h"
+#include "image/address_index.h"
+#include "image/fixup_table.h"
+#include "image/probe_table.h"
+#include "image/placement.h"
 #include "image/program_table.h"
+#include <memory>
 
 namespace uld {
 
 /* image
-   container for an in-memory executable image
+   container for an in-memory executable image; an image may have a parent, whose definitions it links its loads
+   against after its own, such that any number of images can share a common base without copying its symbols
    TODO:
     - recover (rollback latest factory additions in case of a failure)
-    - global relocations (factory to also export unsolved relocations)
 */
 class image
 {
+  public:
+  /* load_*
+     load options (see `set_load_options()`)
+  */
+  static constexpr unsigned int load_default      = 0u;
+  static constexpr unsigned int load_strip_unused = 0x00000001;  // only export the definitions another object of the batch references
+  static constexpr unsigned int load_strip_hidden = 0x00000002;  // keep STV_HIDDEN and STV_INTERNAL definitions within their batch
+  static constexpr unsigned int load_strip        = load_strip_unused | load_strip_hidden;
+
+  private:
   target*         m_target;
+  image*          m_parent;       // scope looked up after the image's own, see set_parent()
+  allocator_t*    m_allocator;    // memory source for the image pools
+  allocator_t*    m_scratch;      // memory source for the temporaries of the loads, given back at the end of each
 
   string_table_t  m_string_table;
   symbol_table_t  m_symbol_table;
+  symbol_index_t  m_symbol_index; // hash index over the names of the symbol table
+  bloom_filter_t  m_symbol_filter; // names of the frozen and symbol tables, for most misses to skip both
+  frozen_table_t  m_frozen_table; // symbols packed by the latest freeze(), looked up before the symbol table
+  const export_table_t* m_export_table; // firmware exports, looked up after the symbol table
+  miss_cache_t    m_miss_cache;   // names missing from all the scopes, see set_miss_cache_size()
+  address_index_t m_address_index; // ranges of the loaded functions and objects, see find_symbol_by_address()
   program_table_t m_program;
+  fixup_table_t   m_fixup_table;
+  probe_table_t   m_probe_table;  // counting trampolines the calls to some functions go through, see make_probe()
+  placement_t*    m_placement;    // hot functions the loads lay out first, see set_placement()
   unsigned int    m_state;
+  unsigned int    m_load_options;
+  std::uint32_t   m_generation;   // bumped whenever the symbols of the image change, for the miss caches to notice
+  std::uint32_t   m_heap_peak;  // pool heap high watermark of the latest load
+
+  std::unique_ptr<load_stats_t> m_load_stats;  // only allocated when built with load stats enabled
 
   private:
           void   uld_set();
-          bool   uld_load_elf32(bin_bfd_t&, unsigned int) noexcept;
-          bool   uld_load_object(raw_bfd_t&, unsigned int) noexcept;
+  template<typename Bt>
+          auto   uld_open_object(raw_bfd_t&) noexcept -> std::unique_ptr<Bt>;
           bool   uld_load_library(raw_bfd_t&, unsigned int) noexcept;
+          bool   uld_bind(symbol_index_t&) noexcept;
+          bool   uld_adopt(symbol_table_t&, symbol_index_t&) noexcept;
+          bool   uld_compact(symbol_table_t&) noexcept;
+          void   uld_set_address(symbol_t*, void*, void*) noexcept;
+          auto   uld_make_symbol(const char*, unsigned int, unsigned int) noexcept -> symbol_t*;
+          bool   uld_index(symbol_t*) noexcept;
+          bool   uld_reindex() noexcept;
+          bool   uld_refilter(int) noexcept;
+          bool   uld_index_addresses(bool) noexcept;
+          auto   uld_find_local(const char*, std::uint32_t, unsigned int) noexcept -> symbol_t*;
+          auto   uld_find_outer(const char*, std::uint32_t, unsigned int, symbol_t*) noexcept -> symbol_t*;
+          auto   uld_find_export(const char*, std::uint32_t, unsigned int, symbol_t*) noexcept -> symbol_t*;
+          void   uld_resolve_pending() noexcept;
+          auto   uld_get_generation() const noexcept -> std::uint32_t;
+  template<typename Bt, typename Ft>
+          bool   uld_place(std::vector<std::unique_ptr<Bt>>&, std::vector<std::unique_ptr<Ft>>&) noexcept;
+  template<typename Bt, typename Ft>
+          bool   uld_load_all(const char**, int) noexcept;
+          bool   uld_load_all(const char**, int) noexcept;
           bool   uld_error(int, const char*, ...) noexcept;
           void   uld_clear() noexcept;
 
   public:
-          image(target*) noexcept;
+          image(target*, allocator_t* = nullptr, allocator_t* = nullptr, image* = nullptr) noexcept;
           image(const image&) noexcept = delete;
           image(image&&) noexcept = delete;
           ~image();
 
           bool      load(const char*) noexcept;
+          bool      load_all(const char**, int) noexcept;
+          bool      plan(const char*, load_plan_t&) noexcept;
+          bool      freeze() noexcept;
           void      reset() noexcept;
 
+          unsigned int get_load_options() const noexcept;
+          void      set_load_options(unsigned int) noexcept;
+
+          image*    get_parent() noexcept;
+          bool      set_parent(image*) noexcept;
+          int       get_miss_cache_size() const noexcept;
+          bool      set_miss_cache_size(int) noexcept;
+
           symbol_t* find_symbol(const char*, unsigned int = symbol_t::bind_any) noexcept;
+          symbol_t* find_image_symbol(const char*, unsigned int = symbol_t::bind_any) noexcept;
+          symbol_t* find_symbol_by_address(const void*) const noexcept;
+          auto      find_export(const char*, unsigned int = symbol_t::bind_any) const noexcept -> const export_t*;
           symbol_t* make_symbol(const char*, unsigned int, unsigned int) noexcept;
           symbol_t* make_symbol(const char*, unsigned int, unsigned int, void*, void* = nullptr) noexcept;
+          probe_t*  make_probe(const char*) noexcept;
 
           segment*  get_segment_by_name(const char*) noexcept;
           segment*  get_segment_by_attributes(unsigned int, unsigned int) noexcept;
+          segment*  get_segment_by_section(const char*, unsigned int, unsigned int, int* = nullptr) noexcept;
           int       get_segment_count() const noexcept;
 
           target*   get_target() noexcept;
           auto      get_string_table() noexcept -> string_table_t*;
           auto      get_symbol_table() noexcept -> symbol_table_t*;
+          auto      get_frozen_table() noexcept -> frozen_table_t*;
+          auto      get_symbol_filter() const noexcept -> const bloom_filter_t*;
+          auto      get_address_index() const noexcept -> const address_index_t*;
+          auto      get_export_table() const noexcept -> const export_table_t*;
+          void      set_export_table(const export_table_t*) noexcept;
           auto      get_program_table() noexcept -> program_table_t*;
+          auto      get_fixup_table() noexcept -> fixup_table_t*;
+          auto      get_probe_table() noexcept -> probe_table_t*;
+          auto      get_placement() noexcept -> placement_t*;
+          void      set_placement(placement_t*) noexcept;
+          auto      get_load_stats() const noexcept -> const load_stats_t*;
+          void      get_memory_stats(image_memory_stats_t&) const noexcept;
 
           image& operator=(const image&) noexcept = delete;
           image& operator=(image&&) noexcept = delete;
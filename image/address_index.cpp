@@ -0,0 +1,177 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "address_index.h"
+#include <algorithm>
+
+namespace uld {
+
+      address_index_t::address_index_t(allocator_t* allocator) noexcept:
+      m_entry_list{
+          list_t<entry_t>(allocator),
+          list_t<entry_t>(allocator)
+      },
+      m_view{{nullptr, 0}, {nullptr, 0}},
+      m_view_ptr(std::addressof(m_view[0])),
+      m_view_index(0)
+{
+}
+
+      address_index_t::~address_index_t()
+{
+}
+
+bool  address_index_t::uld_is_less(const entry_t& lhs, const entry_t& rhs) noexcept
+{
+      return lhs.address < rhs.address;
+}
+
+/* uld_publish()
+   merge the sorted `entry_list` with the entries of the current view, unless `keep` is false, into the array the lookups
+   don't go through, then have them go through it
+*/
+bool  address_index_t::uld_publish(const entry_t* entry_list, int entry_count, bool keep) noexcept
+{
+      const view_t&    l_view = m_view[m_view_index];
+      int              l_view_index = m_view_index ^ 1;
+      list_t<entry_t>& l_entry_list = m_entry_list[l_view_index];
+      int              l_keep_count = keep ? l_view.entry_count : 0;
+      l_entry_list.clear();
+      if(l_entry_list.resize(l_keep_count + entry_count) == false) {
+          return false;
+      }
+      std::merge(
+          l_view.entry_list,
+          l_view.entry_list + l_keep_count,
+          entry_list,
+          entry_list + entry_count,
+          l_entry_list.data(),
+          uld_is_less
+      );
+      m_view[l_view_index].entry_list = l_entry_list.data();
+      m_view[l_view_index].entry_count = l_entry_list.size();
+      m_view_ptr.store(std::addressof(m_view[l_view_index]), std::memory_order_release);
+      m_view_index = l_view_index;
+      return true;
+}
+
+/* uld_update()
+   add the given symbols to the index, the ones without an address or a size excepted, or, unless `keep`, replace its
+   contents with them, in a single publication either way; the temporaries are taken from `scratch`, if given
+*/
+bool  address_index_t::uld_update(symbol_t* const* symbol_list, int count, allocator_t* scratch, bool keep) noexcept
+{
+      list_t<entry_t> l_entry_list(scratch);
+      if(l_entry_list.reserve(count) == false) {
+          return false;
+      }
+      for(int i_symbol = 0; i_symbol < count; i_symbol++) {
+          symbol_t* l_symbol_ptr = symbol_list[i_symbol];
+          if((l_symbol_ptr->ea != nullptr) &&
+              (l_symbol_ptr->size > 0)) {
+              l_entry_list.push_back(
+                  entry_t{
+                      reinterpret_cast<std::uintptr_t>(l_symbol_ptr->ea),
+                      static_cast<std::uint32_t>(l_symbol_ptr->size),
+                      l_symbol_ptr
+                  }
+              );
+          }
+      }
+      std::sort(l_entry_list.begin(), l_entry_list.end(), uld_is_less);
+      return uld_publish(l_entry_list.data(), l_entry_list.size(), keep);
+}
+
+/* insert()
+   add the given symbols to the index, the ones without an address or a size excepted; the temporaries are taken from
+   `scratch`, if given
+*/
+bool  address_index_t::insert(symbol_t* const* symbol_list, int count, allocator_t* scratch) noexcept
+{
+      return uld_update(symbol_list, count, scratch, true);
+}
+
+/* assign()
+   replace the contents of the index with the given symbols: the lookups go through the former contents until the new
+   ones are published, never through an empty view
+*/
+bool  address_index_t::assign(symbol_t* const* symbol_list, int count, allocator_t* scratch) noexcept
+{
+      return uld_update(symbol_list, count, scratch, false);
+}
+
+/* find_symbol()
+   the symbol whose range holds `address`, or nullptr; of overlapping ranges, the one starting last. Safe to call from
+   interrupt context.
+*/
+symbol_t* address_index_t::find_symbol(const void* address) const noexcept
+{
+      const view_t*  l_view = m_view_ptr.load(std::memory_order_acquire);
+      std::uintptr_t l_address = reinterpret_cast<std::uintptr_t>(address);
+      int            l_lb = 0;
+      int            l_ub = l_view->entry_count;
+      // find the first entry past the address
+      while(l_lb < l_ub) {
+          int l_mid = l_lb + (l_ub - l_lb) / 2;
+          if(l_view->entry_list[l_mid].address <= l_address) {
+              l_lb = l_mid + 1;
+          } else {
+              l_ub = l_mid;
+          }
+      }
+      if(l_lb > 0) {
+          const entry_t& l_entry = l_view->entry_list[l_lb - 1];
+          if(l_address - l_entry.address < l_entry.size) {
+              return l_entry.symbol;
+          }
+      }
+      return nullptr;
+}
+
+int   address_index_t::get_symbol_count() const noexcept
+{
+      return m_view[m_view_index].entry_count;
+}
+
+/* get_memory_stats()
+   add up the memory held by the index into `stats`, both arrays as overhead
+*/
+void  address_index_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int l_index_size = (m_entry_list[0].capacity() + m_entry_list[1].capacity()) * sizeof(entry_t);
+      stats.alloc_size += l_index_size;
+      stats.head_size  += l_index_size;
+}
+
+/* clear()
+   empty the index: the lookups go through an empty view from then on
+*/
+void  address_index_t::clear() noexcept
+{
+      int l_view_index = m_view_index ^ 1;
+      m_entry_list[l_view_index].clear();
+      m_view[l_view_index].entry_list = nullptr;
+      m_view[l_view_index].entry_count = 0;
+      m_view_ptr.store(std::addressof(m_view[l_view_index]), std::memory_order_release);
+      m_view_index = l_view_index;
+}
+
+/*namespace uld*/ }
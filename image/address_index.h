@@ -0,0 +1,86 @@
+#ifndef uld_image_address_index_h
+#define uld_image_address_index_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+#include <atomic>
+
+namespace uld {
+
+/* address_index_t
+   reverse lookup index, from an address to the symbol whose `[ea, ea + size)` range holds it: a sorted array of the
+   ranges, searched by bisection. Lookups neither allocate nor write, and may run in interrupt context (i.e. from a fault
+   handler or a sampling profiler) while the loader updates the index: updates are built into a second array, which is
+   then published with a single store; the array it replaces is kept until the next update, for the lookups of another
+   core to complete over.
+*/
+class address_index_t
+{
+  template<typename Xt>
+  using   list_t = block_list_t<Xt>;
+
+  struct entry_t
+  {
+    std::uintptr_t address;
+    std::uint32_t  size;
+    symbol_t*      symbol;
+  };
+
+  struct view_t
+  {
+    const entry_t* entry_list;
+    int            entry_count;
+  };
+
+  list_t<entry_t>       m_entry_list[2];
+  view_t                m_view[2];
+  std::atomic<const view_t*> m_view_ptr;
+  int                   m_view_index;   // the view the lookups currently go through
+
+  private:
+  static  bool  uld_is_less(const entry_t&, const entry_t&) noexcept;
+          bool  uld_publish(const entry_t*, int, bool) noexcept;
+          bool  uld_update(symbol_t* const*, int, allocator_t*, bool) noexcept;
+
+  public:
+          address_index_t(allocator_t* = nullptr) noexcept;
+          address_index_t(const address_index_t&) noexcept = delete;
+          address_index_t(address_index_t&&) noexcept = delete;
+          ~address_index_t();
+
+          bool      insert(symbol_t* const*, int, allocator_t* = nullptr) noexcept;
+          bool      assign(symbol_t* const*, int, allocator_t* = nullptr) noexcept;
+          symbol_t* find_symbol(const void*) const noexcept;
+          int       get_symbol_count() const noexcept;
+          void      get_memory_stats(memory_stats_t&) const noexcept;
+          void      clear() noexcept;
+
+          address_index_t& operator=(const address_index_t&) noexcept = delete;
+          address_index_t& operator=(address_index_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
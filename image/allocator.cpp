@@ -0,0 +1,278 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "allocator.h"
+#include <cstdlib>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace uld {
+
+static heap_allocator_t s_heap_allocator;
+
+      heap_allocator_t::~heap_allocator_t()
+{
+}
+
+void* heap_allocator_t::make_block(std::size_t size) noexcept
+{
+      void* l_block_ptr = std::malloc(size);
+      if(l_block_ptr != nullptr) {
+          m_make_count++;
+      }
+      return l_block_ptr;
+}
+
+void  heap_allocator_t::free_block(void* block_ptr, std::size_t) noexcept
+{
+      std::free(block_ptr);
+}
+
+std::uint32_t heap_allocator_t::get_make_count() const noexcept
+{
+      return m_make_count;
+}
+
+      arena_allocator_t::arena_allocator_t(void* data_ptr, std::size_t data_size) noexcept:
+      allocator_t(),
+      m_data_ptr(reinterpret_cast<std::uint8_t*>(data_ptr)),
+      m_data_size(data_size),
+      m_used_size(0),
+      m_peak_size(0)
+{
+      // align the start of the buffer, give up the bytes before
+      std::size_t l_data_addr = reinterpret_cast<std::size_t>(m_data_ptr);
+      std::size_t l_skip_size = get_block_size(l_data_addr) - l_data_addr;
+      if(l_skip_size < m_data_size) {
+          m_data_ptr  += l_skip_size;
+          m_data_size -= l_skip_size;
+      } else
+          m_data_size = 0;
+}
+
+      arena_allocator_t::~arena_allocator_t()
+{
+}
+
+void* arena_allocator_t::make_block(std::size_t size) noexcept
+{
+      std::size_t l_block_size = get_block_size(size);
+      if(l_block_size <= m_data_size - m_used_size) {
+          void* l_block_ptr = m_data_ptr + m_used_size;
+          m_used_size += l_block_size;
+          if(m_peak_size < m_used_size) {
+              m_peak_size = m_used_size;
+          }
+          return l_block_ptr;
+      }
+      return nullptr;
+}
+
+void  arena_allocator_t::free_block(void* block_ptr, std::size_t size) noexcept
+{
+      std::size_t l_block_size = get_block_size(size);
+      if(reinterpret_cast<std::uint8_t*>(block_ptr) + l_block_size == m_data_ptr + m_used_size) {
+          m_used_size -= l_block_size;
+      }
+}
+
+void  arena_allocator_t::reset() noexcept
+{
+      m_used_size = 0;
+}
+
+std::size_t arena_allocator_t::get_used_size() const noexcept
+{
+      return m_used_size;
+}
+
+std::size_t arena_allocator_t::get_peak_size() const noexcept
+{
+      return m_peak_size;
+}
+
+#if defined(__linux__)
+      map_allocator_t::map_allocator_t(std::size_t map_size, bool low) noexcept:
+      map_allocator_t(map_pages(map_size, low), map_size)
+{
+}
+
+      map_allocator_t::map_allocator_t(void* map_ptr, std::size_t map_size) noexcept:
+      arena_allocator_t(map_ptr, map_ptr != nullptr ? map_size : 0),
+      m_map_ptr(map_ptr),
+      m_map_size(map_ptr != nullptr ? map_size : 0)
+{
+}
+
+      map_allocator_t::~map_allocator_t()
+{
+      if(m_map_ptr != nullptr) {
+          munmap(m_map_ptr, m_map_size);
+      }
+}
+
+/* map_pages()
+   map `size` bytes of anonymous memory for code and data alike; nullptr if the system won't
+*/
+void* map_allocator_t::map_pages(std::size_t size, bool low) noexcept
+{
+      int  l_map_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+      if(size == 0) {
+          return nullptr;
+      }
+      if(low) {
+#if defined(MAP_32BIT)
+          l_map_flags |= MAP_32BIT;
+#else
+          return nullptr;
+#endif
+      }
+      void* l_map_ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, l_map_flags, -1, 0);
+      if(l_map_ptr == MAP_FAILED) {
+          return nullptr;
+      }
+      return l_map_ptr;
+}
+
+void* map_allocator_t::get_map_ptr() const noexcept
+{
+      return m_map_ptr;
+}
+
+std::size_t map_allocator_t::get_map_size() const noexcept
+{
+      return m_map_size;
+}
+#endif
+
+      scratch_allocator_t::scratch_allocator_t(allocator_t* source, std::size_t chunk_size) noexcept:
+      allocator_t(),
+      m_source(source),
+      m_chunk_head(nullptr),
+      m_chunk_size(chunk_size),
+      m_used_size(0),
+      m_chunk_count(0)
+{
+      if(m_source == nullptr) {
+          m_source = get_heap_allocator();
+      }
+      if(m_chunk_size < chunk_size_min) {
+          m_chunk_size = chunk_size_min;
+      }
+}
+
+      scratch_allocator_t::~scratch_allocator_t()
+{
+      reset();
+}
+
+/* make_chunk()
+   get a new chunk from the source allocator, large enough for at least `size` bytes; each chunk is twice the size of the
+   previous one, such that a load takes a logarithmic number of chunks at most, and a single one if reserved properly
+*/
+auto  scratch_allocator_t::make_chunk(std::size_t size) noexcept -> chunk_t*
+{
+      std::size_t l_chunk_size = m_chunk_size;
+      while(l_chunk_size < size) {
+          l_chunk_size <<= 1;
+      }
+      if(void*
+          l_chunk_data = m_source->make_block(chunk_head_size + l_chunk_size);
+          l_chunk_data != nullptr) {
+          chunk_t* l_chunk_ptr = reinterpret_cast<chunk_t*>(l_chunk_data);
+          l_chunk_ptr->next = m_chunk_head;
+          l_chunk_ptr->size = l_chunk_size;
+          l_chunk_ptr->used = 0;
+          m_chunk_head = l_chunk_ptr;
+          m_chunk_size = l_chunk_size << 1;
+          m_chunk_count++;
+          return l_chunk_ptr;
+      }
+      return nullptr;
+}
+
+void* scratch_allocator_t::make_block(std::size_t size) noexcept
+{
+      std::size_t l_block_size = get_block_size(size);
+      chunk_t*    l_chunk_ptr  = m_chunk_head;
+      if((l_chunk_ptr == nullptr) ||
+          (l_block_size > l_chunk_ptr->size - l_chunk_ptr->used)) {
+          l_chunk_ptr = make_chunk(l_block_size);
+          if(l_chunk_ptr == nullptr) {
+              return nullptr;
+          }
+      }
+      void* l_block_ptr = reinterpret_cast<std::uint8_t*>(l_chunk_ptr) + chunk_head_size + l_chunk_ptr->used;
+      l_chunk_ptr->used += l_block_size;
+      m_used_size += l_block_size;
+      return l_block_ptr;
+}
+
+void  scratch_allocator_t::free_block(void* block_ptr, std::size_t size) noexcept
+{
+      // give back the latest block of the current chunk, the rest is recovered at once upon reset()
+      if(m_chunk_head != nullptr) {
+          std::size_t   l_block_size = get_block_size(size);
+          std::uint8_t* l_chunk_top  = reinterpret_cast<std::uint8_t*>(m_chunk_head) + chunk_head_size + m_chunk_head->used;
+          if(reinterpret_cast<std::uint8_t*>(block_ptr) + l_block_size == l_chunk_top) {
+              m_chunk_head->used -= l_block_size;
+              m_used_size -= l_block_size;
+          }
+      }
+}
+
+/* reserve()
+   make sure the next chunk taken holds at least `size` bytes
+*/
+void  scratch_allocator_t::reserve(std::size_t size) noexcept
+{
+      if(m_chunk_size < size) {
+          m_chunk_size = size;
+      }
+}
+
+void  scratch_allocator_t::reset() noexcept
+{
+      while(m_chunk_head != nullptr) {
+          chunk_t* l_chunk_next = m_chunk_head->next;
+          m_source->free_block(m_chunk_head, chunk_head_size + m_chunk_head->size);
+          m_chunk_head = l_chunk_next;
+      }
+      m_used_size = 0;
+}
+
+std::size_t scratch_allocator_t::get_used_size() const noexcept
+{
+      return m_used_size;
+}
+
+std::uint32_t scratch_allocator_t::get_chunk_count() const noexcept
+{
+      return m_chunk_count;
+}
+
+heap_allocator_t* get_heap_allocator() noexcept
+{
+      return std::addressof(s_heap_allocator);
+}
+
+/*namespace uld*/ }
@@ -0,0 +1,224 @@
+#ifndef uld_image_allocator_h
+#define uld_image_allocator_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace uld {
+
+/* allocator_t
+   memory source for the pools and for the temporaries of a load; blocks are handed back along with their size, so that
+   the implementations need not keep any bookkeeping of their own
+*/
+class allocator_t
+{
+  public:
+  static constexpr std::size_t block_align = alignof(std::max_align_t);
+
+  public:
+  constexpr allocator_t() noexcept = default;
+          allocator_t(const allocator_t&) noexcept = delete;
+          allocator_t(allocator_t&&) noexcept = delete;
+  virtual ~allocator_t() = default;
+
+  virtual void* make_block(std::size_t) noexcept = 0;
+  virtual void  free_block(void*, std::size_t) noexcept = 0;
+
+  static  constexpr std::size_t get_block_size(std::size_t size) noexcept {
+          return (size + block_align - 1) & ~(block_align - 1);
+  }
+
+          allocator_t& operator=(const allocator_t&) noexcept = delete;
+          allocator_t& operator=(allocator_t&&) noexcept = delete;
+};
+
+/* heap_allocator_t
+   plain malloc() and free()
+*/
+class heap_allocator_t: public allocator_t
+{
+  std::uint32_t m_make_count;       // blocks taken from the system heap so far
+
+  public:
+  constexpr heap_allocator_t() noexcept:
+          allocator_t(),
+          m_make_count(0) {
+  }
+
+          ~heap_allocator_t();
+
+  virtual void* make_block(std::size_t) noexcept override;
+  virtual void  free_block(void*, std::size_t) noexcept override;
+          std::uint32_t get_make_count() const noexcept;
+};
+
+/* arena_allocator_t
+   bump allocator over a caller provided buffer (i.e. a static array); blocks are only given back if freed in the reverse
+   order of their allocation, otherwise the memory is recovered all at once, by reset()
+*/
+class arena_allocator_t: public allocator_t
+{
+  std::uint8_t* m_data_ptr;
+  std::size_t   m_data_size;
+  std::size_t   m_used_size;
+  std::size_t   m_peak_size;
+
+  public:
+          arena_allocator_t(void*, std::size_t) noexcept;
+          ~arena_allocator_t();
+
+  virtual void* make_block(std::size_t) noexcept override;
+  virtual void  free_block(void*, std::size_t) noexcept override;
+          void  reset() noexcept;
+          std::size_t get_used_size() const noexcept;
+          std::size_t get_peak_size() const noexcept;
+};
+
+#if defined(__linux__)
+/* map_allocator_t
+   arena over pages of its own, mapped readable, writable and executable, for a host image to load native code into (see
+   `target::add_region()`); `low` maps them within the first 2GB of the address space, for the absolute 32 bit relocations
+   (i.e. R_X86_64_32S) to reach them. The pages are unmapped upon destruction.
+*/
+class map_allocator_t: public arena_allocator_t
+{
+  void*         m_map_ptr;
+  std::size_t   m_map_size;
+
+  private:
+  static  void* map_pages(std::size_t, bool) noexcept;
+          map_allocator_t(void*, std::size_t) noexcept;
+
+  public:
+          map_allocator_t(std::size_t, bool = false) noexcept;
+          ~map_allocator_t();
+
+          void*       get_map_ptr() const noexcept;
+          std::size_t get_map_size() const noexcept;
+};
+#endif
+
+/* scratch_allocator_t
+   bump allocator for the temporaries of a single load: takes chunks of geometrically increasing size from another
+   allocator and gives them all back at once, upon destruction or reset()
+*/
+class scratch_allocator_t: public allocator_t
+{
+  struct chunk_t
+  {
+    chunk_t*      next;
+    std::size_t   size;             // bytes available after the header
+    std::size_t   used;
+  };
+
+  static constexpr std::size_t chunk_head_size = get_block_size(sizeof(chunk_t));
+  static constexpr std::size_t chunk_size_min = 1024;
+
+  allocator_t*  m_source;
+  chunk_t*      m_chunk_head;
+  std::size_t   m_chunk_size;       // size of the next chunk
+  std::size_t   m_used_size;
+  std::uint32_t m_chunk_count;
+
+  private:
+          chunk_t* make_chunk(std::size_t) noexcept;
+
+  public:
+          scratch_allocator_t(allocator_t* = nullptr, std::size_t = chunk_size_min) noexcept;
+          ~scratch_allocator_t();
+
+  virtual void* make_block(std::size_t) noexcept override;
+  virtual void  free_block(void*, std::size_t) noexcept override;
+          void  reserve(std::size_t) noexcept;
+          void  reset() noexcept;
+          std::size_t   get_used_size() const noexcept;
+          std::uint32_t get_chunk_count() const noexcept;
+};
+
+/* get_heap_allocator()
+   the system heap, the default memory source for pools given no allocator
+*/
+heap_allocator_t* get_heap_allocator() noexcept;
+
+/* std_allocator_t
+   adapter for the standard containers (i.e. the maps of the ELF factory) to take their memory from an `allocator_t`;
+   the containers can't be told that an allocation failed, so running out of memory throws `std::bad_alloc`, or aborts
+   where exceptions are disabled. Containers that have to recover from it use `block_list_t` instead.
+*/
+template<typename Xt>
+class std_allocator_t
+{
+  allocator_t*  m_allocator;
+
+  template<typename Yt>
+  friend class std_allocator_t;
+
+  public:
+  using value_type = Xt;
+
+  public:
+  inline  std_allocator_t(allocator_t* allocator) noexcept:
+          m_allocator(allocator) {
+  }
+
+  template<typename Yt>
+  inline  std_allocator_t(const std_allocator_t<Yt>& copy) noexcept:
+          m_allocator(copy.m_allocator) {
+  }
+
+  inline  Xt*   allocate(std::size_t count) {
+          void* l_data_ptr = m_allocator->make_block(count * sizeof(Xt));
+          if(l_data_ptr == nullptr) {
+#if defined(__cpp_exceptions)
+              throw std::bad_alloc();
+#else
+              std::abort();
+#endif
+          }
+          return reinterpret_cast<Xt*>(l_data_ptr);
+  }
+
+  inline  void  deallocate(Xt* data_ptr, std::size_t count) noexcept {
+          m_allocator->free_block(data_ptr, count * sizeof(Xt));
+  }
+
+  inline  allocator_t* get_allocator() const noexcept {
+          return m_allocator;
+  }
+
+  template<typename Yt>
+  inline  bool  operator==(const std_allocator_t<Yt>& rhs) const noexcept {
+          return m_allocator == rhs.m_allocator;
+  }
+
+  template<typename Yt>
+  inline  bool  operator!=(const std_allocator_t<Yt>& rhs) const noexcept {
+          return m_allocator != rhs.m_allocator;
+  }
+};
+
+/*namespace uld*/ }
+#endif
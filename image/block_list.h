@@ -0,0 +1,223 @@
+#ifndef uld_image_block_list_h
+#define uld_image_block_list_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "allocator.h"
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace uld {
+
+/* block_list_t
+   growable array of plain data over a single block taken from an `allocator_t`: the counterpart of a `std::vector` for
+   the containers that have to outlive running out of memory (i.e. an arena that's full), where every call that may
+   allocate tells whether it did, and leaves the list as it was if not
+*/
+template<typename Xt>
+class block_list_t
+{
+  static_assert(std::is_trivially_copyable<Xt>::value, "block_list_t only holds trivially copyable types");
+
+  static constexpr int capacity_min = 8;
+
+  allocator_t*  m_allocator;
+  Xt*           m_data_ptr;
+  int           m_size;
+  int           m_capacity;
+
+  public:
+  inline  block_list_t(allocator_t* allocator = nullptr) noexcept:
+          m_allocator(allocator != nullptr ? allocator : get_heap_allocator()),
+          m_data_ptr(nullptr),
+          m_size(0),
+          m_capacity(0) {
+  }
+
+          block_list_t(const block_list_t&) noexcept = delete;
+          block_list_t(block_list_t&&) noexcept = delete;
+
+  inline  ~block_list_t() {
+          release();
+  }
+
+  /* reserve()
+     make room for at least `count` items in all; false, and the list untouched, if the allocator is out of memory
+  */
+  inline  bool  reserve(int count) noexcept {
+          if(count > m_capacity) {
+              Xt* l_data_ptr = reinterpret_cast<Xt*>(m_allocator->make_block(count * sizeof(Xt)));
+              if(l_data_ptr == nullptr) {
+                  return false;
+              }
+              if(m_data_ptr != nullptr) {
+                  if(m_size > 0) {
+                      std::memcpy(l_data_ptr, m_data_ptr, m_size * sizeof(Xt));
+                  }
+                  m_allocator->free_block(m_data_ptr, m_capacity * sizeof(Xt));
+              }
+              m_data_ptr = l_data_ptr;
+              m_capacity = count;
+          }
+          return true;
+  }
+
+  inline  bool  resize(int count, const Xt& value = Xt()) noexcept {
+          if(reserve(count) == false) {
+              return false;
+          }
+          for(int i_item = m_size; i_item < count; i_item++) {
+              m_data_ptr[i_item] = value;
+          }
+          m_size = count;
+          return true;
+  }
+
+  /* append()
+     add `count` items at the end, doubling the room for them as needed
+  */
+  inline  bool  append(const Xt* data, int count) noexcept {
+          if(m_size + count > m_capacity) {
+              int l_capacity = m_capacity > 0 ? m_capacity * 2 : capacity_min;
+              while(l_capacity < m_size + count) {
+                  l_capacity *= 2;
+              }
+              if(reserve(l_capacity) == false) {
+                  return false;
+              }
+          }
+          if(count > 0) {
+              std::memcpy(m_data_ptr + m_size, data, count * sizeof(Xt));
+              m_size += count;
+          }
+          return true;
+  }
+
+  inline  bool  push_back(const Xt& value) noexcept {
+          return append(std::addressof(value), 1);
+  }
+
+  /* insert()
+     add `value` at position `index`, moving the items from there on back by one
+  */
+  inline  bool  insert(int index, const Xt& value) noexcept {
+          Xt   l_value = value;
+          if(append(std::addressof(l_value), 1) == false) {
+              return false;
+          }
+          std::memmove(m_data_ptr + index + 1, m_data_ptr + index, (m_size - index - 1) * sizeof(Xt));
+          m_data_ptr[index] = l_value;
+          return true;
+  }
+
+  inline  void  pop_back() noexcept {
+          m_size--;
+  }
+
+  /* clear()
+     drop the items, keeping the room they took
+  */
+  inline  void  clear() noexcept {
+          m_size = 0;
+  }
+
+  /* release()
+     drop the items and give their memory back
+  */
+  inline  void  release() noexcept {
+          if(m_data_ptr != nullptr) {
+              m_allocator->free_block(m_data_ptr, m_capacity * sizeof(Xt));
+              m_data_ptr = nullptr;
+          }
+          m_size = 0;
+          m_capacity = 0;
+  }
+
+  /* swap()
+     exchange contents with `other`, which has to draw from the same allocator
+  */
+  inline  void  swap(block_list_t& other) noexcept {
+          std::swap(m_data_ptr, other.m_data_ptr);
+          std::swap(m_size, other.m_size);
+          std::swap(m_capacity, other.m_capacity);
+  }
+
+  inline  allocator_t* get_allocator() const noexcept {
+          return m_allocator;
+  }
+
+  inline  Xt*   data() noexcept {
+          return m_data_ptr;
+  }
+
+  inline  const Xt* data() const noexcept {
+          return m_data_ptr;
+  }
+
+  inline  Xt*   begin() noexcept {
+          return m_data_ptr;
+  }
+
+  inline  const Xt* begin() const noexcept {
+          return m_data_ptr;
+  }
+
+  inline  Xt*   end() noexcept {
+          return m_data_ptr + m_size;
+  }
+
+  inline  const Xt* end() const noexcept {
+          return m_data_ptr + m_size;
+  }
+
+  inline  Xt&   back() noexcept {
+          return m_data_ptr[m_size - 1];
+  }
+
+  inline  int   size() const noexcept {
+          return m_size;
+  }
+
+  inline  int   capacity() const noexcept {
+          return m_capacity;
+  }
+
+  inline  bool  empty() const noexcept {
+          return m_size == 0;
+  }
+
+  inline  Xt&   operator[](int index) noexcept {
+          return m_data_ptr[index];
+  }
+
+  inline  const Xt& operator[](int index) const noexcept {
+          return m_data_ptr[index];
+  }
+
+          block_list_t& operator=(const block_list_t&) noexcept = delete;
+          block_list_t& operator=(block_list_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
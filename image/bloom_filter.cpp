@@ -0,0 +1,135 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bloom_filter.h"
+#include <utility>
+
+namespace uld {
+
+      bloom_filter_t::bloom_filter_t(allocator_t* allocator) noexcept:
+      m_word_list(allocator),
+      m_word_mask(0),
+      m_name_count(0)
+{
+}
+
+      bloom_filter_t::~bloom_filter_t()
+{
+}
+
+/* uld_get_bits()
+   the bits a mixed hash sets within its word: the low bits of the hash pick the word, three groups of five bits from
+   the top pick the bits
+*/
+std::uint32_t bloom_filter_t::uld_get_bits(std::uint32_t mix) noexcept
+{
+      return (1u << ((mix >> 17) & 31)) |
+          (1u << ((mix >> 22) & 31)) |
+          (1u << ((mix >> 27) & 31));
+}
+
+/* reserve()
+   size the filter for `count` names, rounded up to a power of two words, and empty it: the names are to be put back in
+   by the caller
+*/
+bool  bloom_filter_t::reserve(int count) noexcept
+{
+      int  l_word_count = word_count_min;
+      while(l_word_count * word_bits < count * bits_per_name) {
+          l_word_count <<= 1;
+      }
+      block_list_t<std::uint32_t> l_word_list(m_word_list.get_allocator());
+      if(l_word_list.resize(l_word_count, 0u) == false) {
+          return false;
+      }
+      m_word_list.swap(l_word_list);
+      m_word_mask = l_word_count - 1;
+      m_name_count = 0;
+      return true;
+}
+
+/* put_hash()
+   add the name of the given hash (see get_name_hash()) to the set
+*/
+void  bloom_filter_t::put_hash(std::uint32_t hash) noexcept
+{
+      if(m_word_list.empty() == false) {
+          std::uint32_t l_mix = get_hash_mix(hash);
+          m_word_list[l_mix & m_word_mask] |= uld_get_bits(l_mix);
+          m_name_count++;
+      }
+}
+
+/* has_hash()
+   check whether the name of the given hash may be in the set: false means it definitely isn't
+*/
+bool  bloom_filter_t::has_hash(std::uint32_t hash) const noexcept
+{
+      if(m_word_list.empty() == false) {
+          std::uint32_t l_mix = get_hash_mix(hash);
+          std::uint32_t l_bits = uld_get_bits(l_mix);
+          return (m_word_list[l_mix & m_word_mask] & l_bits) == l_bits;
+      }
+      return true;
+}
+
+/* is_full()
+   check whether the filter holds as many names as it was sized for
+*/
+bool  bloom_filter_t::is_full() const noexcept
+{
+      return m_name_count * bits_per_name >= m_word_list.size() * word_bits;
+}
+
+int   bloom_filter_t::get_name_count() const noexcept
+{
+      return m_name_count;
+}
+
+/* get_memory_stats()
+   add up the memory held by the filter into `stats`, all of it as overhead
+*/
+void  bloom_filter_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int l_filter_size = m_word_list.capacity() * sizeof(std::uint32_t);
+      stats.alloc_size += l_filter_size;
+      stats.head_size  += l_filter_size;
+}
+
+/* swap()
+   exchange contents with `other`, which has to draw from the same allocator
+*/
+void  bloom_filter_t::swap(bloom_filter_t& other) noexcept
+{
+      m_word_list.swap(other.m_word_list);
+      std::swap(m_word_mask, other.m_word_mask);
+      std::swap(m_name_count, other.m_name_count);
+}
+
+void  bloom_filter_t::clear() noexcept
+{
+      for(std::uint32_t& l_word : m_word_list) {
+          l_word = 0u;
+      }
+      m_name_count = 0;
+}
+
+/*namespace uld*/ }
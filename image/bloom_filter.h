@@ -0,0 +1,74 @@
+#ifndef uld_image_bloom_filter_h
+#define uld_image_bloom_filter_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "hash.h"
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+
+namespace uld {
+
+/* bloom_filter_t
+   blocked Bloom filter over name hashes: each name sets a few bits of a single word, picked by its mixed hash, such that
+   a lookup reads one word, and a name with any of its bits clear is definitely not in the set. The filter is sized for
+   a number of names, past which the false positive rate climbs: the owner is expected to rebuild it larger (`reserve()`)
+   before it gets there. An empty filter, i.e. one never reserved, holds everything.
+*/
+class bloom_filter_t
+{
+  /* bits_per_name
+     filter bits per name it's sized for: with three bits set per name, a false positive rate of about 4%
+  */
+  static constexpr int  bits_per_name = 8;
+  static constexpr int  word_bits = 32;
+  static constexpr int  word_count_min = 16;
+
+  block_list_t<std::uint32_t> m_word_list;
+  int           m_word_mask;
+  int           m_name_count;
+
+  private:
+  static  std::uint32_t uld_get_bits(std::uint32_t) noexcept;
+
+  public:
+          bloom_filter_t(allocator_t* = nullptr) noexcept;
+          bloom_filter_t(const bloom_filter_t&) noexcept = delete;
+          bloom_filter_t(bloom_filter_t&&) noexcept = delete;
+          ~bloom_filter_t();
+
+          bool  reserve(int) noexcept;
+          void  put_hash(std::uint32_t) noexcept;
+          bool  has_hash(std::uint32_t) const noexcept;
+          bool  is_full() const noexcept;
+          int   get_name_count() const noexcept;
+          void  get_memory_stats(memory_stats_t&) const noexcept;
+          void  swap(bloom_filter_t&) noexcept;
+          void  clear() noexcept;
+
+          bloom_filter_t& operator=(const bloom_filter_t&) noexcept = delete;
+          bloom_filter_t& operator=(bloom_filter_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
@@ -75,6 +75,9 @@ struct symbol_t
   static constexpr unsigned int bit_keep      = 0x00010000;
   static constexpr unsigned int bit_export    = bit_keep;
   static constexpr unsigned int bit_define    = 0x00020000;
+  static constexpr unsigned int bit_import    = 0x00040000;   // referenced by another object of the batch
+  static constexpr unsigned int bit_hidden    = 0x00080000;   // only visible within its batch (STV_HIDDEN, STV_INTERNAL)
+  static constexpr unsigned int bit_address   = 0x00100000;   // entered into the address index of the image
 
   const char*    name;
   unsigned int   type;
@@ -275,5 +278,27 @@ struct binding_t
   int           source_offset_last;     // offset within the source section where the symbol data ends
 };
 
+/* placing_t
+   section of an object to be placed ahead of the others of its segment, along with its rank: that of its hottest function
+   in the placement profile (see `image::set_placement()`), or behind, that of the segment rule mapping it
+*/
+struct placing_t
+{
+  int           rank;                   // rank of the hottest function of the section
+  int           source_index;           // index of the section in the source section table
+  int           align;                  // alignment of the section, as a power of 2
+};
+
+/* fixup_t
+   pending relocation entry - keeps track of relocations against symbols not yet defined within the image
+*/
+struct fixup_t
+{
+  symbol_t*     symbol;                 // symbol the relocation refers to, or nullptr once the fixup has been applied
+  std::uint8_t* address;                // address where the relocation applies
+  int           type;                   // relocation type, as defined by the machine of the image
+  int           error;                  // error the fixup failed with once its symbol was defined (see `e_*`), 0 if none
+};
+
 /*namespace uld*/ }
 #endif
@@ -0,0 +1,87 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "export_table.h"
+#include <stats.h>
+#include <cstring>
+
+/* uld_export_table
+   the export table of the firmware, defined by the source `tools/exportgen` generates; weak, such that a firmware built
+   without one still links, and has none
+*/
+extern "C" const uld::export_table_t uld_export_table __attribute__((weak));
+
+namespace uld {
+
+const export_t* export_table_t::find_export(const char* name, unsigned int bind_flags) const noexcept
+{
+      return find_export(name, get_name_hash(name), bind_flags);
+}
+
+/* find_export()
+   binary search the table for the first entry with the given hash of `name` (see get_name_hash()), then compare the
+   names of the entries sharing it
+*/
+const export_t* export_table_t::find_export(const char* name, std::uint32_t hash, unsigned int bind_flags) const noexcept
+{
+      if((name != nullptr) &&
+          (name[0] != 0)) {
+          std::uint32_t l_hash = hash;
+          unsigned int  l_flags = bind_flags & symbol_t::bind_any;
+          int           l_probe_count = 0;
+          int           l_lb = 0;
+          int           l_ub = m_export_count;
+          while(l_lb < l_ub) {
+              int l_mid = l_lb + (l_ub - l_lb) / 2;
+              l_probe_count++;
+              if(m_export_list[l_mid].hash < l_hash) {
+                  l_lb = l_mid + 1;
+              } else {
+                  l_ub = l_mid;
+              }
+          }
+          for(int i_export = l_lb; (i_export < m_export_count) && (m_export_list[i_export].hash == l_hash); i_export++) {
+              const export_t& l_export = m_export_list[i_export];
+              l_probe_count++;
+              if(std::strcmp(l_export.name, name) == 0) {
+                  if((l_flags == symbol_t::bind_any) ||
+                      ((l_flags & l_export.flags) == l_flags)) {
+                      stats::on_lookup(l_probe_count);
+                      return std::addressof(l_export);
+                  }
+              }
+          }
+          stats::on_lookup(l_probe_count);
+      }
+      return nullptr;
+}
+
+int   export_table_t::get_export_count() const noexcept
+{
+      return m_export_count;
+}
+
+const export_table_t* get_default_export_table() noexcept
+{
+      return std::addressof(uld_export_table);
+}
+
+/*namespace uld*/ }
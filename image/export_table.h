@@ -0,0 +1,112 @@
+#ifndef uld_image_export_table_h
+#define uld_image_export_table_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "hash.h"
+
+namespace uld {
+
+/* export_t
+   entry of an export table: a definition of the firmware the loaded objects may link against, known at build time
+*/
+struct export_t
+{
+  const char*   name;
+  std::uint32_t hash;     // get_name_hash() of the name, the key the table is sorted by
+  std::uint16_t type;     // symbol_t::type_function or symbol_t::type_object
+  std::uint16_t flags;    // symbol_t::bind_global or symbol_t::bind_weak
+  const void*   address;
+};
+
+/* export_table_t
+   read-only table of the firmware exports, generated at build time by `tools/exportgen` and kept in flash along with
+   the names it points to: the entries are sorted by name hash, such that a lookup is a binary search over the hashes,
+   followed by a name compare. The image looks its symbols up in it last (see image::find_symbol()), which saves the
+   firmware from registering its exports one by one at startup.
+*/
+class export_table_t
+{
+  const export_t*   m_export_list;
+  int               m_export_count;
+
+  public:
+  constexpr export_table_t(const export_t* export_list, int export_count) noexcept:
+            m_export_list(export_list),
+            m_export_count(export_count) {
+  }
+
+  template<int Count>
+  constexpr export_table_t(const export_t (&export_list)[Count]) noexcept:
+            export_table_t(export_list, Count) {
+  }
+
+  constexpr export_table_t(const export_table_t&) noexcept = default;
+  constexpr export_table_t(export_table_t&&) noexcept = default;
+
+  /* is_sorted()
+     check that each entry holds the hash of its name and that the hashes are in ascending order; the generated tables
+     static_assert on it
+  */
+  static constexpr bool is_sorted(const export_t* export_list, int export_count) noexcept {
+        for(int i_export = 0; i_export < export_count; i_export++) {
+            if(export_list[i_export].hash != get_name_hash(export_list[i_export].name)) {
+                return false;
+            }
+            if((i_export > 0) &&
+                (export_list[i_export].hash < export_list[i_export - 1].hash)) {
+                return false;
+            }
+        }
+        return true;
+  }
+
+  template<int Count>
+  static constexpr bool is_sorted(const export_t (&export_list)[Count]) noexcept {
+        return is_sorted(export_list, Count);
+  }
+
+          const export_t* find_export(const char*, unsigned int = symbol_t::bind_any) const noexcept;
+          const export_t* find_export(const char*, std::uint32_t, unsigned int) const noexcept;
+          int             get_export_count() const noexcept;
+
+  inline  const export_t* begin() const noexcept {
+          return m_export_list;
+  }
+
+  inline  const export_t* end() const noexcept {
+          return m_export_list + m_export_count;
+  }
+
+          export_table_t& operator=(const export_table_t&) noexcept = default;
+          export_table_t& operator=(export_table_t&&) noexcept = default;
+};
+
+/* get_default_export_table()
+   the export table linked into the firmware, as `uld_export_table` (which `tools/exportgen` defines), or nullptr if
+   there is none
+*/
+const export_table_t* get_default_export_table() noexcept;
+
+/*namespace uld*/ }
+#endif
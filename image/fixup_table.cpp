@@ -0,0 +1,97 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "fixup_table.h"
+
+namespace uld {
+
+      fixup_table_t::fixup_table_t(allocator_t* allocator) noexcept:
+      table(allocator),
+      m_fixup_count(0),
+      m_error_count(0)
+{
+}
+
+      fixup_table_t::~fixup_table_t()
+{
+}
+
+fixup_t* fixup_table_t::make_fixup(symbol_t* symbol_ptr, std::uint8_t* address, int type) noexcept
+{
+      // all the previous fixups have been applied: recycle the pages
+      if(m_fixup_count == 0) {
+          clear();
+      }
+      fixup_t* l_fixup_ptr = raw_get();
+      if(l_fixup_ptr != nullptr) {
+          l_fixup_ptr->symbol = symbol_ptr;
+          l_fixup_ptr->address = address;
+          l_fixup_ptr->type = type;
+          l_fixup_ptr->error = 0;
+          m_fixup_count++;
+      }
+      return l_fixup_ptr;
+}
+
+/* free_fixup()
+   mark a fixup as applied; the entry is reclaimed once all the pending fixups are gone
+*/
+void  fixup_table_t::free_fixup(fixup_t* fixup_ptr) noexcept
+{
+      if(fixup_ptr->symbol != nullptr) {
+          if(fixup_ptr->error != 0) {
+              fixup_ptr->error = 0;
+              m_error_count--;
+          }
+          fixup_ptr->symbol = nullptr;
+          m_fixup_count--;
+      }
+}
+
+/* fail_fixup()
+   mark a fixup as failed with `error`: it's kept, but no longer applied
+*/
+void  fixup_table_t::fail_fixup(fixup_t* fixup_ptr, int error) noexcept
+{
+      if((fixup_ptr->symbol != nullptr) &&
+          (fixup_ptr->error == 0)) {
+          fixup_ptr->error = error;
+          m_error_count++;
+      }
+}
+
+/* get_fixup_count()
+   number of fixups held by the table, the failed ones included
+*/
+int   fixup_table_t::get_fixup_count() const noexcept
+{
+      return m_fixup_count;
+}
+
+/* get_error_count()
+   number of fixups held by the table that failed to apply
+*/
+int   fixup_table_t::get_error_count() const noexcept
+{
+      return m_error_count;
+}
+
+/*namespace uld*/ }
@@ -0,0 +1,56 @@
+#ifndef uld_image_fixup_table_h
+#define uld_image_fixup_table_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "table.h"
+
+namespace uld {
+
+/* fixup_table_t
+   image-level list of relocations waiting for their target symbol to become defined; a fixup that can't be applied once
+   its symbol is (i.e. out of reach) stays in the table, along with the error it failed with, rather than be retried
+*/
+class fixup_table_t: public table<fixup_t, page_size>
+{
+  int     m_fixup_count;
+  int     m_error_count;
+
+  public:
+          fixup_table_t(allocator_t* = nullptr) noexcept;
+          fixup_table_t(const fixup_table_t&) noexcept = delete;
+          fixup_table_t(fixup_table_t&&) noexcept = delete;
+          ~fixup_table_t();
+
+          fixup_t*  make_fixup(symbol_t*, std::uint8_t*, int) noexcept;
+          void      free_fixup(fixup_t*) noexcept;
+          void      fail_fixup(fixup_t*, int) noexcept;
+          int       get_fixup_count() const noexcept;
+          int       get_error_count() const noexcept;
+
+          fixup_table_t& operator=(const fixup_table_t&) noexcept = delete;
+          fixup_table_t& operator=(fixup_table_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
@@ -0,0 +1,317 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "frozen_table.h"
+#include <algorithm>
+#include <cstring>
+
+      // increment between the seeds of a bucket, before mixing: the golden ratio, for the seeds to land far apart
+      static constexpr std::uint32_t s_seed_step = 0x9e3779b9u;
+
+namespace uld {
+
+      frozen_table_t::frozen_table_t(allocator_t* allocator) noexcept:
+      m_symbol_list(allocator),
+      m_seed_list(m_symbol_list.get_allocator()),
+      m_slot_count(0)
+{
+}
+
+      frozen_table_t::~frozen_table_t()
+{
+}
+
+/* uld_get_range()
+   map a mixed hash onto [0, count) with a multiply and a shift: the targets have no hardware divide
+*/
+int   frozen_table_t::uld_get_range(std::uint32_t hash, int count) noexcept
+{
+      return (static_cast<std::uint64_t>(hash) * static_cast<std::uint32_t>(count)) >> 32;
+}
+
+/* uld_get_slot()
+   slot the given seed maps a name onto
+*/
+int   frozen_table_t::uld_get_slot(std::uint32_t hash, std::int32_t seed, int slot_count) noexcept
+{
+      return uld_get_range(get_hash_mix(hash + static_cast<std::uint32_t>(seed) * s_seed_step), slot_count);
+}
+
+/* uld_get_slot()
+   the one slot a name can be in, -1 if its bucket is empty
+*/
+int   frozen_table_t::uld_get_slot(std::uint32_t hash) const noexcept
+{
+      std::int32_t l_seed = m_seed_list[uld_get_range(get_hash_mix(hash), m_seed_list.size())];
+      if(l_seed > 0) {
+          return uld_get_slot(hash, l_seed, m_slot_count);
+      } else
+      if(l_seed < 0) {
+          return -l_seed - 1;
+      }
+      return -1;
+}
+
+bool  frozen_table_t::uld_has_symbol(int index, const char* name, unsigned int flags) const noexcept
+{
+      const symbol_t& l_symbol = m_symbol_list[index];
+      if((l_symbol.name != nullptr) &&
+          (std::strcmp(l_symbol.name, name) == 0)) {
+          return (flags == symbol_t::bind_any) ||
+              ((flags & l_symbol.flags) == flags);
+      }
+      return false;
+}
+
+/* assign()
+   replace the contents of the table with copies of the `count` symbols at `symbol_list`; the build takes its temporaries
+   from `scratch`, if given. Names aren't copied, and should outlive the table. Of two symbols of the same name, the first
+   one is found first.
+*/
+bool  frozen_table_t::assign(const symbol_t* symbol_list, int count, allocator_t* scratch) noexcept
+{
+      allocator_t* l_scratch = scratch != nullptr ? scratch : get_heap_allocator();
+      int          l_bucket_count = (count + bucket_size - 1) / bucket_size;
+      int          l_size_max = 0;
+      int          l_free_slot = 0;
+      clear();
+      if(count <= 0) {
+          return true;
+      }
+      list_t<std::uint32_t> l_hash_list(l_scratch);
+      list_t<int>           l_key_list(l_scratch);    // symbol indices, grouped by bucket
+      list_t<int>           l_base_list(l_scratch);   // start of each bucket in `l_key_list`
+      list_t<int>           l_size_list(l_scratch);   // names left to place, per bucket
+      list_t<std::uint8_t>  l_used_list(l_scratch);
+      list_t<int>           l_spill_list(l_scratch);
+      if((l_hash_list.resize(count, 0) == false) ||
+          (l_key_list.resize(count, 0) == false) ||
+          (l_base_list.resize(l_bucket_count + 1, 0) == false) ||
+          (l_size_list.resize(l_bucket_count, 0) == false) ||
+          (l_used_list.resize(count, 0) == false) ||
+          (l_spill_list.reserve(count) == false) ||
+          (m_symbol_list.resize(count, symbol_t{}) == false) ||
+          (m_seed_list.resize(l_bucket_count, 0) == false)) {
+          clear();
+          return false;
+      }
+      m_slot_count = count;
+      // hash the names and group them by bucket, keeping their order within each
+      for(int i_symbol = 0; i_symbol < count; i_symbol++) {
+          l_hash_list[i_symbol] = get_name_hash(symbol_list[i_symbol].name);
+          l_size_list[uld_get_range(get_hash_mix(l_hash_list[i_symbol]), l_bucket_count)]++;
+      }
+      for(int i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+          l_base_list[i_bucket + 1] = l_base_list[i_bucket] + l_size_list[i_bucket];
+          if(l_size_list[i_bucket] > l_size_max) {
+              l_size_max = l_size_list[i_bucket];
+          }
+          l_size_list[i_bucket] = 0;
+      }
+      for(int i_symbol = 0; i_symbol < count; i_symbol++) {
+          int l_bucket = uld_get_range(get_hash_mix(l_hash_list[i_symbol]), l_bucket_count);
+          l_key_list[l_base_list[l_bucket] + l_size_list[l_bucket]] = i_symbol;
+          l_size_list[l_bucket]++;
+      }
+      // names sharing a hash can't be told apart by any seed: keep all but the first of them aside
+      for(int i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+          int* l_key_ptr = l_key_list.data() + l_base_list[i_bucket];
+          int  l_key_count = 0;
+          for(int i_key = 0; i_key < l_size_list[i_bucket]; i_key++) {
+              int  l_symbol = l_key_ptr[i_key];
+              bool l_unique = true;
+              for(int i_prev = 0; i_prev < l_key_count; i_prev++) {
+                  if(l_hash_list[l_key_ptr[i_prev]] == l_hash_list[l_symbol]) {
+                      l_unique = false;
+                      break;
+                  }
+              }
+              if(l_unique) {
+                  l_key_ptr[l_key_count++] = l_symbol;
+              } else
+                  l_spill_list.push_back(l_symbol);
+          }
+          l_size_list[i_bucket] = l_key_count;
+      }
+      // seed the buckets of more than one name, largest first, while there's the most room left
+      for(int l_size = l_size_max; l_size > 1; l_size--) {
+          for(int i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+              if(l_size_list[i_bucket] != l_size) {
+                  continue;
+              }
+              int* l_key_ptr = l_key_list.data() + l_base_list[i_bucket];
+              for(std::int32_t l_seed = 1; l_seed <= seed_count_max; l_seed++) {
+                  int  l_key_count = 0;
+                  while(l_key_count < l_size) {
+                      int l_slot = uld_get_slot(l_hash_list[l_key_ptr[l_key_count]], l_seed, m_slot_count);
+                      if(l_used_list[l_slot]) {
+                          break;
+                      }
+                      l_used_list[l_slot] = 1;
+                      l_key_count++;
+                  }
+                  if(l_key_count == l_size) {
+                      for(int i_key = 0; i_key < l_size; i_key++) {
+                          int l_symbol = l_key_ptr[i_key];
+                          int l_slot = uld_get_slot(l_hash_list[l_symbol], l_seed, m_slot_count);
+                          m_symbol_list[l_slot] = symbol_list[l_symbol];
+                      }
+                      m_seed_list[i_bucket] = l_seed;
+                      break;
+                  }
+                  // roll back the names of the bucket placed so far
+                  for(int i_key = 0; i_key < l_key_count; i_key++) {
+                      l_used_list[uld_get_slot(l_hash_list[l_key_ptr[i_key]], l_seed, m_slot_count)] = 0;
+                  }
+              }
+              if(m_seed_list[i_bucket] == 0) {
+                  for(int i_key = 0; i_key < l_size; i_key++) {
+                      l_spill_list.push_back(l_key_ptr[i_key]);
+                  }
+              }
+          }
+      }
+      // names alone in their bucket just take the next free slot
+      for(int i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+          if(l_size_list[i_bucket] == 1) {
+              int l_symbol = l_key_list[l_base_list[i_bucket]];
+              while(l_used_list[l_free_slot]) {
+                  l_free_slot++;
+              }
+              l_used_list[l_free_slot] = 1;
+              m_symbol_list[l_free_slot] = symbol_list[l_symbol];
+              m_seed_list[i_bucket] = -(l_free_slot + 1);
+          }
+      }
+      // the ones set aside go past the slots, in their original order
+      if(l_spill_list.size() > 0) {
+          std::sort(l_spill_list.begin(), l_spill_list.end());
+          if(m_symbol_list.reserve(count + l_spill_list.size()) == false) {
+              clear();
+              return false;
+          }
+          for(int l_symbol : l_spill_list) {
+              m_symbol_list.push_back(symbol_list[l_symbol]);
+          }
+      }
+      return true;
+}
+
+symbol_t* frozen_table_t::find_symbol(const char* name, unsigned int bind_flags) noexcept
+{
+      if(m_slot_count > 0) {
+          return find_symbol(name, get_name_hash(name), bind_flags);
+      }
+      return nullptr;
+}
+
+/* find_symbol()
+   look up a symbol by name, of the given hash (see get_name_hash()): one probe into the slot its name maps to, then,
+   only if that misses, a scan over the symbols that couldn't be placed - rarely any
+*/
+symbol_t* frozen_table_t::find_symbol(const char* name, std::uint32_t hash, unsigned int bind_flags) noexcept
+{
+      if((name) &&
+          (name[0] != 0) &&
+          (m_slot_count > 0)) {
+          std::uint32_t l_hash = hash;
+          unsigned int  l_flags = bind_flags & symbol_t::bind_any;
+          int           l_slot = uld_get_slot(l_hash);
+          int           l_probe_count = 1;
+          if(l_slot >= 0) {
+              if(uld_has_symbol(l_slot, name, l_flags)) {
+                  stats::on_lookup(l_probe_count);
+                  return std::addressof(m_symbol_list[l_slot]);
+              }
+          }
+          for(int i_symbol = m_slot_count; i_symbol < m_symbol_list.size(); i_symbol++) {
+              l_probe_count++;
+              if(uld_has_symbol(i_symbol, name, l_flags)) {
+                  stats::on_lookup(l_probe_count);
+                  return std::addressof(m_symbol_list[i_symbol]);
+              }
+          }
+          stats::on_lookup(l_probe_count);
+      }
+      return nullptr;
+}
+
+/* get_symbol_count()
+   number of symbols in the table; `begin()` and `end()` go over them, along with the slots left empty (nameless)
+*/
+int   frozen_table_t::get_symbol_count() const noexcept
+{
+      int l_symbol_count = 0;
+      for(const symbol_t& l_symbol : m_symbol_list) {
+          if(l_symbol.name != nullptr) {
+              l_symbol_count++;
+          }
+      }
+      return l_symbol_count;
+}
+
+/* get_spill_count()
+   number of symbols the hash couldn't place, which the lookups have to scan
+*/
+int   frozen_table_t::get_spill_count() const noexcept
+{
+      return m_symbol_list.size() - m_slot_count;
+}
+
+/* get_memory_stats()
+   add up the memory held by the table into `stats`; the arrays count as a single page each, the seeds as overhead and
+   the empty slots as slack
+*/
+void  frozen_table_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int  l_head_size = m_seed_list.capacity() * sizeof(std::int32_t);
+      int  l_used_size = get_symbol_count() * sizeof(symbol_t);
+      int  l_alloc_size = m_symbol_list.capacity() * sizeof(symbol_t) + l_head_size;
+      if(m_symbol_list.capacity() > 0) {
+          stats.page_count += 2;
+      }
+      stats.alloc_size += l_alloc_size;
+      stats.head_size  += l_head_size;
+      stats.used_size  += l_used_size;
+      stats.slack_size += l_alloc_size - l_head_size - l_used_size;
+}
+
+/* swap()
+   exchange contents with `other`, which has to draw from the same allocator
+*/
+void  frozen_table_t::swap(frozen_table_t& other) noexcept
+{
+      m_symbol_list.swap(other.m_symbol_list);
+      m_seed_list.swap(other.m_seed_list);
+      std::swap(m_slot_count, other.m_slot_count);
+}
+
+/* clear()
+   discard all the symbols, and give the memory of the table back
+*/
+void  frozen_table_t::clear() noexcept
+{
+      m_symbol_list.release();
+      m_seed_list.release();
+      m_slot_count = 0;
+}
+
+/*namespace uld*/ }
@@ -0,0 +1,95 @@
+#ifndef uld_image_frozen_table_h
+#define uld_image_frozen_table_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "hash.h"
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+
+namespace uld {
+
+/* frozen_table_t
+   read-only symbol table, for the symbols of an image that is done loading most of what it will ever load (i.e. after
+   boot): the symbols are packed into a single array, laid out by a minimal perfect hash over their names, such that a
+   lookup takes one hash and a single probe.
+   The hash is of the hash and displace kind: the names are spread into buckets of a few, then the buckets, largest
+   first, are each given the seed that maps all of their names onto free slots of the array; names alone in their bucket
+   take whatever slot is left and have it stored in place of the seed. The odd name the seeds can't place (i.e. two names
+   with the same hash) is kept past the end of the array, and only looked at when the probe misses.
+*/
+class frozen_table_t
+{
+  template<typename Xt>
+  using   list_t = block_list_t<Xt>;
+
+  /* bucket_size
+     average number of names per bucket: the larger, the fewer seeds to keep, but the more seeds to try at build time
+  */
+  static constexpr int  bucket_size = 4;
+
+  /* seed_count_max
+     seeds to try for a bucket before giving up on placing its names
+  */
+  static constexpr int  seed_count_max = 65536;
+
+  list_t<symbol_t>      m_symbol_list;  // symbols in slot order, followed by the ones that couldn't be placed
+  list_t<std::int32_t>  m_seed_list;    // per bucket: seed, -(slot + 1) for a single name, 0 if empty
+  int                   m_slot_count;
+
+  private:
+  static  int   uld_get_range(std::uint32_t, int) noexcept;
+  static  int   uld_get_slot(std::uint32_t, std::int32_t, int) noexcept;
+          int   uld_get_slot(std::uint32_t) const noexcept;
+          bool  uld_has_symbol(int, const char*, unsigned int) const noexcept;
+
+  public:
+          frozen_table_t(allocator_t* = nullptr) noexcept;
+          frozen_table_t(const frozen_table_t&) noexcept = delete;
+          frozen_table_t(frozen_table_t&&) noexcept = delete;
+          ~frozen_table_t();
+
+          bool      assign(const symbol_t*, int, allocator_t* = nullptr) noexcept;
+          symbol_t* find_symbol(const char*, unsigned int = symbol_t::bind_any) noexcept;
+          symbol_t* find_symbol(const char*, std::uint32_t, unsigned int) noexcept;
+          int       get_symbol_count() const noexcept;
+          int       get_spill_count() const noexcept;
+          void      get_memory_stats(memory_stats_t&) const noexcept;
+          void      swap(frozen_table_t&) noexcept;
+          void      clear() noexcept;
+
+  inline  symbol_t* begin() noexcept {
+          return m_symbol_list.data();
+  }
+
+  inline  symbol_t* end() noexcept {
+          return m_symbol_list.data() + m_symbol_list.size();
+  }
+
+          frozen_table_t& operator=(const frozen_table_t&) noexcept = delete;
+          frozen_table_t& operator=(frozen_table_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
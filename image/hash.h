@@ -0,0 +1,62 @@
+#ifndef uld_image_hash_h
+#define uld_image_hash_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+
+namespace uld {
+
+/* get_name_hash()
+   FNV-1a hash of a symbol name; with a negative `length`, hash up to the null terminator
+*/
+constexpr std::uint32_t get_name_hash(const char* name, int length = -1) noexcept
+{
+      std::uint32_t l_hash = 2166136261u;
+      if(name != nullptr) {
+          for(int l_index = 0; (length < 0) || (l_index < length); l_index++) {
+              std::uint8_t l_char = name[l_index];
+              if(l_char == 0) {
+                  break;
+              }
+              l_hash ^= l_char;
+              l_hash *= 16777619u;
+          }
+      }
+      return l_hash;
+}
+
+/* get_hash_mix()
+   scramble the bits of a name hash (the murmur3 finalizer), for the structures that index by a few of its bits to draw on
+   all of them
+*/
+constexpr std::uint32_t get_hash_mix(std::uint32_t hash) noexcept
+{
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6bu;
+      hash ^= hash >> 13;
+      hash *= 0xc2b2ae35u;
+      hash ^= hash >> 16;
+      return hash;
+}
+
+/*namespace uld*/ }
+#endif
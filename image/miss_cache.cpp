@@ -0,0 +1,131 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "miss_cache.h"
+#include <cstring>
+
+namespace uld {
+
+      miss_cache_t::miss_cache_t(allocator_t* allocator) noexcept:
+      m_entry_list(allocator),
+      m_entry_mask(0),
+      m_generation(0)
+{
+}
+
+      miss_cache_t::~miss_cache_t()
+{
+}
+
+/* resize()
+   make room for `count` entries, rounded up to a power of two, dropping the ones cached so far; a count of 0 disables
+   the cache and gives its memory back
+*/
+bool  miss_cache_t::resize(int count) noexcept
+{
+      int  l_entry_count = 0;
+      if(count > 0) {
+          l_entry_count = 1;
+          while(l_entry_count < count) {
+              l_entry_count <<= 1;
+          }
+      }
+      block_list_t<entry_t> l_entry_list(m_entry_list.get_allocator());
+      if(l_entry_list.resize(l_entry_count) == false) {
+          return false;
+      }
+      m_entry_list.swap(l_entry_list);
+      m_entry_mask = l_entry_count - 1;
+      clear();
+      return true;
+}
+
+/* has_name()
+   check whether `name`, of hash `hash`, is known to be missing from the scopes at `generation`
+*/
+bool  miss_cache_t::has_name(const char* name, std::uint32_t hash, std::uint32_t generation) noexcept
+{
+      if(m_entry_list.empty()) {
+          return false;
+      }
+      if(generation != m_generation) {
+          clear();
+          m_generation = generation;
+          return false;
+      }
+      const entry_t& l_entry = m_entry_list[hash & m_entry_mask];
+      if((l_entry.hash == hash) &&
+          (l_entry.name[0] != 0) &&
+          (std::strncmp(l_entry.name, name, name_size_max) == 0)) {
+          stats::on_lookup(1);
+          return true;
+      }
+      return false;
+}
+
+/* put_name()
+   remember that `name`, of hash `hash`, is missing from the scopes at `generation`, in place of whatever its entry held
+*/
+void  miss_cache_t::put_name(const char* name, std::uint32_t hash, std::uint32_t generation) noexcept
+{
+      if(m_entry_list.empty()) {
+          return;
+      }
+      int  l_name_size = std::strlen(name) + 1;
+      if(l_name_size > name_size_max) {
+          return;
+      }
+      if(generation != m_generation) {
+          clear();
+          m_generation = generation;
+      }
+      entry_t& l_entry = m_entry_list[hash & m_entry_mask];
+      l_entry.hash = hash;
+      std::memcpy(l_entry.name, name, l_name_size);
+}
+
+/* get_size()
+   number of entries of the cache, 0 if disabled
+*/
+int   miss_cache_t::get_size() const noexcept
+{
+      return m_entry_list.size();
+}
+
+/* get_memory_stats()
+   add up the memory held by the cache into `stats`, all of it as overhead
+*/
+void  miss_cache_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int l_cache_size = m_entry_list.capacity() * sizeof(entry_t);
+      stats.alloc_size += l_cache_size;
+      stats.head_size  += l_cache_size;
+}
+
+void  miss_cache_t::clear() noexcept
+{
+      for(entry_t& l_entry : m_entry_list) {
+          l_entry.hash = 0;
+          l_entry.name[0] = 0;
+      }
+}
+
+/*namespace uld*/ }
@@ -0,0 +1,74 @@
+#ifndef uld_image_miss_cache_h
+#define uld_image_miss_cache_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+
+namespace uld {
+
+/* miss_cache_t
+   negative lookup cache: a direct mapped set of the names a chain of lookup scopes (see image::find_symbol()) didn't
+   find, for the lookups that would miss again to return right away. Entries hold a copy of their name, such that a hit
+   is exact; names too long to fit are never cached. The cache holds for a single generation of the scopes it covers, and
+   empties itself as soon as it's asked about another.
+*/
+class miss_cache_t
+{
+  public:
+  /* name_size_max
+     room for a name in an entry, terminator included
+  */
+  static constexpr int name_size_max = 28;
+
+  private:
+  struct entry_t
+  {
+    std::uint32_t hash;
+    char          name[name_size_max];
+  };
+
+  block_list_t<entry_t> m_entry_list;
+  int           m_entry_mask;
+  std::uint32_t m_generation;
+
+  public:
+          miss_cache_t(allocator_t* = nullptr) noexcept;
+          miss_cache_t(const miss_cache_t&) noexcept = delete;
+          miss_cache_t(miss_cache_t&&) noexcept = delete;
+          ~miss_cache_t();
+
+          bool  resize(int) noexcept;
+          bool  has_name(const char*, std::uint32_t, std::uint32_t) noexcept;
+          void  put_name(const char*, std::uint32_t, std::uint32_t) noexcept;
+          int   get_size() const noexcept;
+          void  get_memory_stats(memory_stats_t&) const noexcept;
+          void  clear() noexcept;
+
+          miss_cache_t& operator=(const miss_cache_t&) noexcept = delete;
+          miss_cache_t& operator=(miss_cache_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
@@ -23,6 +23,8 @@
 **/
 #include <uld.h>
 #include <config.h>
+#include <stats.h>
+#include "allocator.h"
 #include <type_traits>
 #include <limits>
 
@@ -128,22 +130,49 @@ struct page: public page_base_t<Xt>
   // sanity check: make sure that PageSize allows for at least 4 elements
   static_assert(capacity > capacity_min, "PageSize should allow for at least `capacity_min` elements");
 
-  static  bool  make_page(base_type*& page, base_type* prev, base_type* next, int count) noexcept {
+  /* get_grow_size()
+     size of the page to follow one of `byte_count` bytes
+  */
+  static constexpr int get_grow_size(int byte_count) noexcept {
+         if(byte_count < page_size_max) {
+             byte_count <<= 1;
+             if(byte_count > page_size_max) {
+                 byte_count = page_size_max;
+             }
+         }
+         return byte_count;
+  }
+
+  /* get_reserve_size()
+     size of a page able to hold `count` elements
+  */
+  static constexpr int get_reserve_size(int count) noexcept {
+         return head_size + count * node_size;
+  }
+
+  /* make_page()
+     allocate a page for at least `count` elements (and no less than `capacity_min`), as large as will fit into
+     `byte_count_min` bytes
+  */
+  static  bool  make_page(base_type*& page, base_type* prev, base_type* next, int count, int byte_count_min, allocator_t* allocator) noexcept {
           base_type*  l_page_ptr = nullptr;
-          int         l_page_count = count / capacity;
+          int         l_node_count = (byte_count_min - head_size) / node_size;
           int         l_byte_count;
-          if(count % capacity) {
-              l_page_count += 1;
+          if(l_node_count < count) {
+              l_node_count = count;
           }
-          l_byte_count = l_page_count * size;
+          if(l_node_count < capacity_min) {
+              l_node_count = capacity_min;
+          }
+          l_byte_count = head_size + l_node_count * node_size;
           if(l_byte_count > 0) {
-              void* l_byte_ptr = malloc(l_byte_count);
+              void* l_byte_ptr = allocator->make_block(l_byte_count);
               if(l_byte_ptr != nullptr) {
                   l_page_ptr = reinterpret_cast<base_type*>(l_byte_ptr);
                   l_page_ptr->m_used = 0;
                   l_page_ptr->m_gto_base = 0;
                   l_page_ptr->m_gto_next = 0;
-                  l_page_ptr->m_size = get_capacity(l_byte_count);
+                  l_page_ptr->m_size = l_node_count;
                   l_page_ptr->m_page_prev = prev;
                   if(l_page_ptr->m_page_prev != nullptr) {
                       l_page_ptr->m_gto_base = l_page_ptr->m_page_prev->m_gto_next;
@@ -154,14 +183,48 @@ struct page: public page_base_t<Xt>
                   if(l_page_ptr->m_page_next != nullptr) {
                       l_page_ptr->m_page_next->m_page_prev = l_page_ptr;
                   }
+                  stats::on_alloc(get_byte_count(l_page_ptr));
               }
               page = l_page_ptr;
           }
           return l_page_ptr != nullptr;
   }
 
-  static  void  free_page(base_type*& page) noexcept {
-          free(page);
+  /* get_byte_count()
+     bytes held by the given page, as seen by the load stats
+  */
+  static constexpr int get_byte_count(base_type* page) noexcept {
+         return head_size + page->m_size * node_size;
+  }
+
+  /* get_alloc_size()
+     bytes actually allocated for the given page
+  */
+  static constexpr int get_alloc_size(base_type* page) noexcept {
+         return get_byte_count(page);
+  }
+
+  /* get_memory_stats()
+     add up the memory held by the pages from `page_head` onwards into `stats`
+  */
+  static  void  get_memory_stats(const base_type* page_head, memory_stats_t& stats) noexcept {
+          auto  l_page_iter = const_cast<base_type*>(page_head);
+          while(l_page_iter != nullptr) {
+              int l_alloc_size = get_alloc_size(l_page_iter);
+              int l_used_size  = l_page_iter->get_used_count() * node_size;
+              int l_slack_size = l_page_iter->get_free_count() * node_size;
+              stats.page_count++;
+              stats.alloc_size += l_alloc_size;
+              stats.head_size  += l_alloc_size - l_used_size - l_slack_size;
+              stats.used_size  += l_used_size;
+              stats.slack_size += l_slack_size;
+              l_page_iter = l_page_iter->m_page_next;
+          }
+  }
+
+  static  void  free_page(base_type*& page, allocator_t* allocator) noexcept {
+          stats::on_free(get_byte_count(page));
+          allocator->free_block(page, get_alloc_size(page));
   }
 };
 
@@ -0,0 +1,284 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "placement.h"
+#include "hash.h"
+#include <algorithm>
+#include <cstring>
+
+namespace uld {
+
+      placement_t::placement_t(allocator_t* allocator) noexcept:
+      m_name_list(allocator),
+      m_node_list(m_name_list.get_allocator()),
+      m_edge_list(m_name_list.get_allocator()),
+      m_slot_list(m_name_list.get_allocator()),
+      m_rank_list(m_name_list.get_allocator()),
+      m_ranked(true)
+{
+}
+
+      placement_t::~placement_t()
+{
+}
+
+/* uld_is_slot_less()
+   order of the name index, by hash
+*/
+bool  placement_t::uld_is_slot_less(const slot_t& lhs, std::uint32_t hash) noexcept
+{
+      return lhs.hash < hash;
+}
+
+/* uld_is_edge_heavier()
+   order in which the calls join the chains: heaviest first, ties in the order they were added
+*/
+bool  placement_t::uld_is_edge_heavier(const order_t& lhs, const order_t& rhs) noexcept
+{
+      if(lhs.weight != rhs.weight) {
+          return lhs.weight > rhs.weight;
+      }
+      return lhs.edge < rhs.edge;
+}
+
+auto  placement_t::uld_get_slot(const char* name, std::uint32_t hash) const noexcept -> const slot_t*
+{
+      auto i_slot = std::lower_bound(m_slot_list.begin(), m_slot_list.end(), hash, uld_is_slot_less);
+      while((i_slot != m_slot_list.end()) &&
+          (i_slot->hash == hash)) {
+          if(std::strcmp(m_name_list.data() + m_node_list[i_slot->node].name_offset, name) == 0) {
+              return std::addressof(*i_slot);
+          }
+          ++i_slot;
+      }
+      return nullptr;
+}
+
+/* uld_make_node()
+   index of the node for function `name`, which gets one behind those already listed if it has none; -1 if out of memory
+*/
+int   placement_t::uld_make_node(const char* name) noexcept
+{
+      std::uint32_t l_hash = get_name_hash(name);
+      if(const slot_t*
+          l_slot_ptr = uld_get_slot(name, l_hash);
+          l_slot_ptr != nullptr) {
+          return l_slot_ptr->node;
+      }
+      int  l_name_size = std::strlen(name) + 1;
+      int  l_name_offset = m_name_list.size();
+      int  l_node_index = m_node_list.size();
+      int  l_slot_index = std::lower_bound(m_slot_list.begin(), m_slot_list.end(), l_hash, uld_is_slot_less) - m_slot_list.begin();
+      if(m_name_list.append(name, l_name_size) == false) {
+          return -1;
+      }
+      if(m_node_list.push_back(node_t{l_hash, l_name_offset, -1}) == false) {
+          m_name_list.resize(l_name_offset);
+          return -1;
+      }
+      if(m_slot_list.insert(l_slot_index, slot_t{l_hash, l_node_index}) == false) {
+          m_node_list.pop_back();
+          m_name_list.resize(l_name_offset);
+          return -1;
+      }
+      m_ranked = false;
+      return l_node_index;
+}
+
+/* uld_rank()
+   join the functions into call chains and lay the chains out by their hottest function
+*/
+bool  placement_t::uld_rank() noexcept
+{
+      int  l_node_count = m_node_list.size();
+      int  l_edge_count = m_edge_list.size();
+      block_list_t<int>     l_head_list(m_name_list.get_allocator());  // first node of the chain of each node
+      block_list_t<int>     l_tail_list(m_name_list.get_allocator());  // last node of the chains, by first node
+      block_list_t<int>     l_next_list(m_name_list.get_allocator());  // next node in the chain
+      block_list_t<order_t> l_edge_order(m_name_list.get_allocator());
+      m_rank_list.clear();
+      if((l_head_list.resize(l_node_count, 0) == false) ||
+          (l_tail_list.resize(l_node_count, 0) == false) ||
+          (l_next_list.resize(l_node_count, -1) == false) ||
+          (l_edge_order.reserve(l_edge_count) == false) ||
+          (m_rank_list.reserve(l_node_count) == false)) {
+          return false;
+      }
+      for(int i_node = 0; i_node < l_node_count; i_node++) {
+          l_head_list[i_node] = i_node;
+          l_tail_list[i_node] = i_node;
+      }
+      for(int i_edge = 0; i_edge < l_edge_count; i_edge++) {
+          l_edge_order.push_back(order_t{m_edge_list[i_edge].weight, i_edge});
+      }
+      std::sort(l_edge_order.begin(), l_edge_order.end(), uld_is_edge_heavier);
+      // append the chain of the callee to the one of the caller, as long as the call joins the end of the one to the
+      // start of the other
+      for(auto& l_order : l_edge_order) {
+          edge_t& l_edge = m_edge_list[l_order.edge];
+          int     l_caller_head = l_head_list[l_edge.caller];
+          if((l_head_list[l_edge.callee] != l_edge.callee) ||
+              (l_tail_list[l_caller_head] != l_edge.caller) ||
+              (l_caller_head == l_edge.callee)) {
+              continue;
+          }
+          l_next_list[l_edge.caller] = l_edge.callee;
+          l_tail_list[l_caller_head] = l_tail_list[l_edge.callee];
+          for(int i_node = l_edge.callee; i_node >= 0; i_node = l_next_list[i_node]) {
+              l_head_list[i_node] = l_caller_head;
+          }
+      }
+      // lay the chains out in the order of their hottest node, which is the first of theirs in the list
+      for(int i_node = 0; i_node < l_node_count; i_node++) {
+          m_node_list[i_node].rank = -1;
+      }
+      for(int i_node = 0; i_node < l_node_count; i_node++) {
+          int  l_head = l_head_list[i_node];
+          if(m_node_list[l_head].rank < 0) {
+              for(int i_chain = l_head; i_chain >= 0; i_chain = l_next_list[i_chain]) {
+                  m_node_list[i_chain].rank = m_rank_list.size();
+                  m_rank_list.push_back(i_chain);
+              }
+          }
+      }
+      return true;
+}
+
+/* add_function()
+   list function `name` as the next hottest one; functions already listed keep their place
+*/
+bool  placement_t::add_function(const char* name) noexcept
+{
+      return uld_make_node(name) >= 0;
+}
+
+/* add_edge()
+   note that `caller` calls `callee`, `weight` times over the profiled run; the functions not yet listed are listed after
+   the others
+*/
+bool  placement_t::add_edge(const char* caller, const char* callee, std::uint32_t weight) noexcept
+{
+      int  l_caller = uld_make_node(caller);
+      if(l_caller < 0) {
+          return false;
+      }
+      int  l_callee = uld_make_node(callee);
+      if(l_callee < 0) {
+          return false;
+      }
+      if(l_caller != l_callee) {
+          for(edge_t& l_edge : m_edge_list) {
+              if((l_edge.caller == l_caller) &&
+                  (l_edge.callee == l_callee)) {
+                  l_edge.weight += weight;
+                  m_ranked = false;
+                  return true;
+              }
+          }
+          if(m_edge_list.push_back(edge_t{l_caller, l_callee, weight}) == false) {
+              return false;
+          }
+          m_ranked = false;
+      }
+      return true;
+}
+
+/* update()
+   rank the functions, if any were added since they last were; the image does so at the start of each load
+*/
+bool  placement_t::update() noexcept
+{
+      if(m_ranked == false) {
+          m_ranked = uld_rank();
+      }
+      return m_ranked;
+}
+
+/* find_rank()
+   position of function `name`, of hash `hash`, in the layout; -1 if the profile doesn't list it, i.e. if it's cold
+*/
+int   placement_t::find_rank(const char* name, std::uint32_t hash) const noexcept
+{
+      if(m_ranked) {
+          if(const slot_t*
+              l_slot_ptr = uld_get_slot(name, hash);
+              l_slot_ptr != nullptr) {
+              return m_node_list[l_slot_ptr->node].rank;
+          }
+      }
+      return -1;
+}
+
+int   placement_t::find_rank(const char* name) const noexcept
+{
+      return find_rank(name, get_name_hash(name));
+}
+
+/* get_function()
+   name of the function at position `rank` of the layout
+*/
+auto  placement_t::get_function(int rank) const noexcept -> const char*
+{
+      if(m_ranked) {
+          if((rank >= 0) &&
+              (rank < m_rank_list.size())) {
+              return m_name_list.data() + m_node_list[m_rank_list[rank]].name_offset;
+          }
+      }
+      return nullptr;
+}
+
+int   placement_t::get_function_count() const noexcept
+{
+      return m_node_list.size();
+}
+
+int   placement_t::get_edge_count() const noexcept
+{
+      return m_edge_list.size();
+}
+
+/* get_memory_stats()
+   add up the memory held by the profile into `stats`, all of it as overhead
+*/
+void  placement_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int l_profile_size =
+          m_name_list.capacity() +
+          m_node_list.capacity() * sizeof(node_t) +
+          m_edge_list.capacity() * sizeof(edge_t) +
+          m_slot_list.capacity() * sizeof(slot_t) +
+          m_rank_list.capacity() * sizeof(int);
+      stats.alloc_size += l_profile_size;
+      stats.head_size  += l_profile_size;
+}
+
+void  placement_t::clear() noexcept
+{
+      m_name_list.clear();
+      m_node_list.clear();
+      m_edge_list.clear();
+      m_slot_list.clear();
+      m_rank_list.clear();
+      m_ranked = true;
+}
+
+/*namespace uld*/ }
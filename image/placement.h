@@ -0,0 +1,107 @@
+#ifndef uld_image_placement_h
+#define uld_image_placement_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+
+namespace uld {
+
+/* placement_t
+   code placement profile: the functions of the loaded code that run the most, hottest first, and optionally the calls
+   between them, weighted by their count; see image::set_placement().
+   The profile ranks the functions it lists for the loader to lay them out in that order: the calls, heaviest first,
+   join the functions into chains, a call appending the chain of its callee to the one of its caller as long as the
+   caller ends its chain and the callee starts its own, such that the heavy call pairs end up next to each other; the
+   chains then follow the order of their hottest function. Functions an edge names, but the list doesn't, rank after
+   the listed ones.
+*/
+class placement_t
+{
+  struct node_t
+  {
+    std::uint32_t hash;
+    int           name_offset;  // offset of the name into the name list
+    int           rank;         // position in the layout, valid once ranked
+  };
+
+  struct edge_t
+  {
+    int           caller;
+    int           callee;
+    std::uint32_t weight;
+  };
+
+  struct slot_t
+  {
+    std::uint32_t hash;
+    int           node;
+  };
+
+  /* order_t
+     position of a call in the order the calls join the chains
+  */
+  struct order_t
+  {
+    std::uint32_t weight;
+    int           edge;
+  };
+
+  block_list_t<char>    m_name_list;
+  block_list_t<node_t>  m_node_list;  // in the order the functions were added
+  block_list_t<edge_t>  m_edge_list;
+  block_list_t<slot_t>  m_slot_list;  // nodes sorted by name hash
+  block_list_t<int>     m_rank_list;  // nodes in layout order
+  bool    m_ranked;
+
+  private:
+  static  bool  uld_is_slot_less(const slot_t&, std::uint32_t) noexcept;
+  static  bool  uld_is_edge_heavier(const order_t&, const order_t&) noexcept;
+          auto  uld_get_slot(const char*, std::uint32_t) const noexcept -> const slot_t*;
+          int   uld_make_node(const char*) noexcept;
+          bool  uld_rank() noexcept;
+
+  public:
+          placement_t(allocator_t* = nullptr) noexcept;
+          placement_t(const placement_t&) noexcept = delete;
+          placement_t(placement_t&&) noexcept = delete;
+          ~placement_t();
+
+          bool  add_function(const char*) noexcept;
+          bool  add_edge(const char*, const char*, std::uint32_t = 1) noexcept;
+          bool  update() noexcept;
+          int   find_rank(const char*, std::uint32_t) const noexcept;
+          int   find_rank(const char*) const noexcept;
+          auto  get_function(int) const noexcept -> const char*;
+          int   get_function_count() const noexcept;
+          int   get_edge_count() const noexcept;
+          void  get_memory_stats(memory_stats_t&) const noexcept;
+          void  clear() noexcept;
+
+          placement_t& operator=(const placement_t&) noexcept = delete;
+          placement_t& operator=(placement_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
@@ -35,17 +35,36 @@ class pool
   using  node_type = typename page<Xt, PageSize>::node_type;
 
   protected:
+  allocator_t* m_allocator;
   page_type*  m_page_head;
   page_type*  m_page_tail;
   page_type*  m_page_current;
   int         m_page_count;
+  int         m_page_size;      // size of the next page
+  int         m_reserve_size;   // size requested by reserve() for the next page, if larger
+
+  /* get_next_size()
+     size of the next page: the larger of the growth size and what was asked for by `reserve()`
+  */
+  inline  int   get_next_size() const noexcept {
+          if(m_reserve_size > m_page_size) {
+              return m_reserve_size;
+          }
+          return m_page_size;
+  }
 
   public:
-  inline  pool() noexcept:
+  inline  pool(allocator_t* allocator = nullptr) noexcept:
+          m_allocator(allocator),
           m_page_head(nullptr),
           m_page_tail(nullptr),
           m_page_current(nullptr),
-          m_page_count(0) {
+          m_page_count(0),
+          m_page_size(PageSize),
+          m_reserve_size(0) {
+          if(m_allocator == nullptr) {
+              m_allocator = get_heap_allocator();
+          }
   }
 
           pool(const pool&) noexcept = delete;
@@ -56,13 +75,13 @@ class pool
           page_type* l_page_iter = m_page_tail;
           while(l_page_iter != nullptr) {
               l_page_prev = l_page_iter->m_page_prev;
-              page<node_type, PageSize>::free_page(l_page_iter);
+              page<node_type, PageSize>::free_page(l_page_iter, m_allocator);
               l_page_iter = l_page_prev;
           }
   }
 
   /* raw_get()
-     reserve an element from the pool
+     reserve an element from the pool; nullptr if a new page is needed and the allocator can't provide it
   */
           node_type*  raw_get() noexcept {
           node_type*  l_node;
@@ -75,18 +94,113 @@ class pool
           }
           if(m_page_current == nullptr) {
               if(bool
-                  l_alloc_success = page<Xt, PageSize>::make_page(m_page_current, m_page_tail, nullptr, 1);
-                  l_alloc_success == true) {
-                  m_page_tail = m_page_current;
-                  if(m_page_head == nullptr) {
-                      m_page_head = m_page_current;
-                  }
-                  m_page_count++;
+                  l_alloc_success = page<Xt, PageSize>::make_page(m_page_current, m_page_tail, nullptr, 1, get_next_size(), m_allocator);
+                  l_alloc_success == false) {
+                  return nullptr;
+              }
+              m_page_tail = m_page_current;
+              if(m_page_head == nullptr) {
+                  m_page_head = m_page_current;
               }
+              m_page_count++;
+              m_page_size = page<Xt, PageSize>::get_grow_size(m_page_size);
+              m_reserve_size = 0;
           }
           return raw_get();
   }
 
+  /* reserve()
+     make sure that the next `count` elements fit in a single page: if the current page is too short on room, the next one
+     will be allocated large enough to hold them all; on a pool that has no pages yet this is a hint for the size of the
+     first page, which may then be smaller than `PageSize`
+  */
+          void  reserve(int count) noexcept {
+          int l_reserve_size = page<Xt, PageSize>::get_reserve_size(count);
+          if(m_page_head == nullptr) {
+              m_page_size = l_reserve_size;
+          } else
+          if((m_page_current == nullptr) ||
+              (m_page_current->get_free_count() < count)) {
+              if(l_reserve_size > m_reserve_size) {
+                  m_reserve_size = l_reserve_size;
+              }
+          }
+  }
+
+  /* adopt()
+     take over the pages of `other`, which has to draw its memory from the same allocator; the elements keep their
+     addresses and `other` is left empty
+  */
+          bool  adopt(pool& other) noexcept {
+          if(other.m_allocator != m_allocator) {
+              return false;
+          }
+          if(other.m_page_head != nullptr) {
+              page_type* l_page_iter = other.m_page_head;
+              int        l_gto_delta = 0;
+              if(m_page_tail != nullptr) {
+                  l_gto_delta = m_page_tail->m_gto_next - l_page_iter->m_gto_base;
+                  m_page_tail->m_page_next = l_page_iter;
+              } else
+                  m_page_head = l_page_iter;
+              l_page_iter->m_page_prev = m_page_tail;
+              while(l_page_iter != nullptr) {
+                  l_page_iter->m_gto_base += l_gto_delta;
+                  l_page_iter->m_gto_next += l_gto_delta;
+                  l_page_iter = l_page_iter->m_page_next;
+              }
+              if(m_page_current == nullptr) {
+                  m_page_current = other.m_page_head;
+              }
+              m_page_tail = other.m_page_tail;
+              m_page_count += other.m_page_count;
+              other.m_page_head = nullptr;
+              other.m_page_tail = nullptr;
+              other.m_page_current = nullptr;
+              other.m_page_count = 0;
+          }
+          return true;
+  }
+
+  /* clear()
+     discard all the elements in the pool, but keep the pages around for reuse
+  */
+          void  clear() noexcept {
+          page_type* l_page_iter = m_page_head;
+          while(l_page_iter != nullptr) {
+              l_page_iter->m_used = 0;
+              l_page_iter->m_gto_next = l_page_iter->m_gto_base;
+              l_page_iter = l_page_iter->m_page_next;
+          }
+          m_page_current = m_page_head;
+  }
+
+  /* release()
+     discard all the elements in the pool and give its pages back to the allocator; the pool starts over as if new
+  */
+          void  release() noexcept {
+          page_type* l_page_prev;
+          page_type* l_page_iter = m_page_tail;
+          while(l_page_iter != nullptr) {
+              l_page_prev = l_page_iter->m_page_prev;
+              page<node_type, PageSize>::free_page(l_page_iter, m_allocator);
+              l_page_iter = l_page_prev;
+          }
+          m_page_head = nullptr;
+          m_page_tail = nullptr;
+          m_page_current = nullptr;
+          m_page_count = 0;
+          m_page_size = PageSize;
+          m_reserve_size = 0;
+  }
+
+  /* get_memory_stats()
+     add up the memory held by the pool into `stats`
+  */
+          void  get_memory_stats(memory_stats_t& stats) const noexcept {
+          page<Xt, PageSize>::get_memory_stats(m_page_head, stats);
+  }
+
           pool& operator=(const pool&) noexcept = delete;
           pool& operator=(pool&&) noexcept = delete;
 };
@@ -105,17 +219,38 @@ class pool<char, PageSize>
   static constexpr int  chr_reserve_min = 8;
 
   protected:
+  allocator_t* m_allocator;
   page_type*  m_page_head;
   page_type*  m_page_tail;
   page_type*  m_page_current;
   int         m_page_count;
+  int         m_page_size;      // size of the next page
+  int         m_reserve_size;   // size requested by reserve() for the next page, if larger
+  int         m_pad_size;
+
+  /* get_next_size()
+     size of the next page: the larger of the growth size and what was asked for by `reserve()`
+  */
+  inline  int   get_next_size() const noexcept {
+          if(m_reserve_size > m_page_size) {
+              return m_reserve_size;
+          }
+          return m_page_size;
+  }
 
   public:
-  inline  pool() noexcept:
+  inline  pool(allocator_t* allocator = nullptr) noexcept:
+          m_allocator(allocator),
           m_page_head(nullptr),
           m_page_tail(nullptr),
           m_page_current(nullptr),
-          m_page_count(0) {
+          m_page_count(0),
+          m_page_size(PageSize),
+          m_reserve_size(0),
+          m_pad_size(0) {
+          if(m_allocator == nullptr) {
+              m_allocator = get_heap_allocator();
+          }
   }
 
           pool(const pool&) noexcept = delete;
@@ -126,31 +261,35 @@ class pool<char, PageSize>
           page_type* l_page_iter = m_page_tail;
           while(l_page_iter != nullptr) {
               l_page_prev = l_page_iter->m_page_prev;
-              page<data_type, PageSize>::free_page(l_page_iter);
+              page<data_type, PageSize>::free_page(l_page_iter, m_allocator);
               l_page_iter = l_page_prev;
           }
   }
 
   /* raw_get()
-     reserve `size` contiguous characters from the pool
+     reserve `size` contiguous characters from the pool; nullptr if a new page is needed and the allocator can't provide it
   */
           data_type*  raw_get(int count) noexcept {
+          int l_char_count = get_round_value(count, chr_reserve_min);
           do {
               if(__builtin_expect(m_page_current == nullptr, false)) {
                   if(bool
-                      l_alloc_success = page<data_type, PageSize>::make_page(m_page_current, m_page_tail, nullptr, count);
-                      l_alloc_success == true) {
-                      m_page_tail = m_page_current;
-                      if(m_page_head == nullptr) {
-                          m_page_head = m_page_current;
-                      }
-                      m_page_count++;
+                      l_alloc_success = page<data_type, PageSize>::make_page(m_page_current, m_page_tail, nullptr, l_char_count, get_next_size(), m_allocator);
+                      l_alloc_success == false) {
+                      return nullptr;
+                  }
+                  m_page_tail = m_page_current;
+                  if(m_page_head == nullptr) {
+                      m_page_head = m_page_current;
                   }
+                  m_page_count++;
+                  m_page_size = page<data_type, PageSize>::get_grow_size(m_page_size);
+                  m_reserve_size = 0;
               }
               if(__builtin_expect(m_page_current != nullptr, true)) {
-                  int        l_char_count = get_round_value(count, chr_reserve_min);
-                  data_type* l_char_base  = m_page_current->raw_get(l_char_count);
+                  data_type* l_char_base = m_page_current->raw_get(l_char_count);
                   if(l_char_base != nullptr) {
+                      m_pad_size += l_char_count - count;
                       return  l_char_base;
                   }
                   m_page_current = m_page_current->m_page_next;
@@ -160,6 +299,60 @@ class pool<char, PageSize>
           return nullptr;
   }
 
+  /* reserve()
+     make sure that the next `count` characters, in `string_count` strings, fit in a single page (see `pool<Xt>::reserve()`)
+  */
+          void  reserve(int count, int string_count = 0) noexcept {
+          int l_reserve_size;
+          count += string_count * (chr_reserve_min - 1);
+          l_reserve_size = page<data_type, PageSize>::get_reserve_size(count);
+          if(m_page_head == nullptr) {
+              m_page_size = l_reserve_size;
+          } else
+          if((m_page_current == nullptr) ||
+              (m_page_current->get_free_count() < count)) {
+              if(l_reserve_size > m_reserve_size) {
+                  m_reserve_size = l_reserve_size;
+              }
+          }
+  }
+
+  /* adopt()
+     take over the pages of `other` (see `pool<Xt>::adopt()`)
+  */
+          bool  adopt(pool& other) noexcept {
+          if(other.m_allocator != m_allocator) {
+              return false;
+          }
+          if(other.m_page_head != nullptr) {
+              page_type* l_page_iter = other.m_page_head;
+              int        l_gto_delta = 0;
+              if(m_page_tail != nullptr) {
+                  l_gto_delta = m_page_tail->m_gto_next - l_page_iter->m_gto_base;
+                  m_page_tail->m_page_next = l_page_iter;
+              } else
+                  m_page_head = l_page_iter;
+              l_page_iter->m_page_prev = m_page_tail;
+              while(l_page_iter != nullptr) {
+                  l_page_iter->m_gto_base += l_gto_delta;
+                  l_page_iter->m_gto_next += l_gto_delta;
+                  l_page_iter = l_page_iter->m_page_next;
+              }
+              if(m_page_current == nullptr) {
+                  m_page_current = other.m_page_head;
+              }
+              m_page_tail = other.m_page_tail;
+              m_page_count += other.m_page_count;
+              other.m_page_head = nullptr;
+              other.m_page_tail = nullptr;
+              other.m_page_current = nullptr;
+              other.m_page_count = 0;
+              m_pad_size += other.m_pad_size;
+              other.m_pad_size = 0;
+          }
+          return true;
+  }
+
   /**/    data_type* get_offset_ptr(int offset) noexcept {
           if(offset >= 0) {
               page_type*  i_page_ptr    = m_page_head;
@@ -175,6 +368,14 @@ class pool<char, PageSize>
           return nullptr;
   }
 
+  /* get_memory_stats()
+     add up the memory held by the pool into `stats`; padding is the rounding of the strings to `chr_reserve_min`
+  */
+          void  get_memory_stats(memory_stats_t& stats) const noexcept {
+          page<data_type, PageSize>::get_memory_stats(m_page_head, stats);
+          stats.pad_size += m_pad_size;
+  }
+
           pool& operator=(const pool&) noexcept = delete;
           pool& operator=(pool&&) noexcept = delete;
 };
@@ -187,19 +388,40 @@ class pool<std::uint8_t, PageSize>
   using  data_type = typename page<std::uint8_t, PageSize>::node_type;
 
   protected:
+  allocator_t* m_allocator;
   page_type*  m_page_head;
   page_type*  m_page_tail;
   page_type*  m_page_current;
   int         m_page_count;
+  int         m_page_size;      // size of the next page
+  int         m_reserve_size;   // size requested by reserve() for the next page, if larger
   int         m_align;
+  int         m_pad_size;
+
+  /* get_next_size()
+     size of the next page: the larger of the growth size and what was asked for by `reserve()`
+  */
+  inline  int   get_next_size() const noexcept {
+          if(m_reserve_size > m_page_size) {
+              return m_reserve_size;
+          }
+          return m_page_size;
+  }
 
   public:
-  inline  pool(int align = 0) noexcept:
+  inline  pool(int align = 0, allocator_t* allocator = nullptr) noexcept:
+          m_allocator(allocator),
           m_page_head(nullptr),
           m_page_tail(nullptr),
           m_page_current(nullptr),
           m_page_count(0),
-          m_align(align) {
+          m_page_size(PageSize),
+          m_reserve_size(0),
+          m_align(align),
+          m_pad_size(0) {
+          if(m_allocator == nullptr) {
+              m_allocator = get_heap_allocator();
+          }
   }
 
           pool(const pool&) noexcept = delete;
@@ -210,28 +432,32 @@ class pool<std::uint8_t, PageSize>
           page_type* l_page_iter = m_page_tail;
           while(l_page_iter != nullptr) {
               l_page_prev = l_page_iter->m_page_prev;
-              page<data_type, PageSize>::free_page(l_page_iter);
+              page<data_type, PageSize>::free_page(l_page_iter, m_allocator);
               l_page_iter = l_page_prev;
           }
   }
 
   /* raw_get()
-     get `size` bytes from the pool, at the set alignment
+     get `size` bytes from the pool, at the set alignment; nullptr if a new page is needed and the allocator can't provide
+     it
   */
           data_type*  raw_get(int size) noexcept {
-          int         l_data_offset = 0;
-          int         l_data_count = get_round_value(size, 1 << m_align);
           do {
+              int     l_data_offset = 0;
+              int     l_data_count = get_round_value(size, 1 << m_align);
               if(__builtin_expect(m_page_current == nullptr, false)) {
                   if(bool
-                      l_alloc_success = page<data_type, PageSize>::make_page(m_page_current, m_page_tail, nullptr, size);
-                      l_alloc_success == true) {
-                      m_page_tail = m_page_current;
-                      if(m_page_head == nullptr) {
-                          m_page_head = m_page_current;
-                      }
-                      m_page_count++;
+                      l_alloc_success = page<data_type, PageSize>::make_page(m_page_current, m_page_tail, nullptr, l_data_count + (1 << m_align), get_next_size(), m_allocator);
+                      l_alloc_success == false) {
+                      return nullptr;
                   }
+                  m_page_tail = m_page_current;
+                  if(m_page_head == nullptr) {
+                      m_page_head = m_page_current;
+                  }
+                  m_page_count++;
+                  m_page_size = page<data_type, PageSize>::get_grow_size(m_page_size);
+                  m_reserve_size = 0;
               }
               if(__builtin_expect(m_page_current != nullptr, true)) {
                   if((m_align >= 1) &&
@@ -249,6 +475,7 @@ class pool<std::uint8_t, PageSize>
                   data_type* l_data_base = m_page_current->raw_get(l_data_count);
                   if(l_data_base != nullptr) {
                       data_type* l_data_ptr = l_data_base + l_data_offset;
+                      m_pad_size += l_data_count - size;
                       return     l_data_ptr;
                   }
                   m_page_current = m_page_current->m_page_next;
@@ -258,6 +485,69 @@ class pool<std::uint8_t, PageSize>
           return nullptr;
   }
 
+  /* raw_get()
+     get `size` bytes from the pool, at `1 << align` rather than the set alignment and with no rounding of the size, such
+     that blocks of mixed alignments pack together; `pad_size` receives the bytes skipped ahead of the block
+  */
+          data_type*  raw_get(int size, int align, int& pad_size) noexcept {
+          do {
+              int     l_data_offset = 0;
+              int     l_data_count = size;
+              if(__builtin_expect(m_page_current == nullptr, false)) {
+                  if(bool
+                      l_alloc_success = page<data_type, PageSize>::make_page(m_page_current, m_page_tail, nullptr, l_data_count + (1 << align), get_next_size(), m_allocator);
+                      l_alloc_success == false) {
+                      return nullptr;
+                  }
+                  m_page_tail = m_page_current;
+                  if(m_page_head == nullptr) {
+                      m_page_head = m_page_current;
+                  }
+                  m_page_count++;
+                  m_page_size = page<data_type, PageSize>::get_grow_size(m_page_size);
+                  m_reserve_size = 0;
+              }
+              if(align >= 1) {
+                  std::size_t l_align_mask = (static_cast<std::size_t>(1) << align) - 1;
+                  std::size_t l_data_addr  = reinterpret_cast<std::size_t>(m_page_current->get_next_ptr());
+                  if(l_data_addr & l_align_mask) {
+                      l_data_offset  = (l_align_mask + 1) - (l_data_addr & l_align_mask);
+                      l_data_count  += l_data_offset;
+                  }
+              }
+              data_type* l_data_base = m_page_current->raw_get(l_data_count);
+              if(l_data_base != nullptr) {
+                  m_pad_size += l_data_offset;
+                  pad_size = l_data_offset;
+                  return l_data_base + l_data_offset;
+              }
+              m_page_current = m_page_current->m_page_next;
+          }
+          while(true);
+          return nullptr;
+  }
+
+  /* reserve()
+     make sure that the next `size` bytes fit in a single page (see `pool<Xt>::reserve()`); the caller accounts for the
+     alignment of each block within
+  */
+          void  reserve(int size) noexcept {
+          int l_reserve_size = page<data_type, PageSize>::get_reserve_size(size + (1 << m_align));
+          if(m_page_head == nullptr) {
+              m_page_size = l_reserve_size;
+          } else
+          if((m_page_current == nullptr) ||
+              (m_page_current->get_free_count() < size)) {
+              if(l_reserve_size > m_reserve_size) {
+                  m_reserve_size = l_reserve_size;
+              }
+          }
+  }
+
+  inline  int  get_align() const noexcept {
+          return m_align;
+  }
+
   inline  int  get_table_offset() const noexcept {
           if(m_page_current != nullptr) {
               return m_page_current->m_gto_next;
@@ -265,6 +555,22 @@ class pool<std::uint8_t, PageSize>
           return 0;
   }
 
+  /* get_table_offset()
+     table offset of the byte at `data_ptr`; -1 if that's not part of the pool
+  */
+  inline  int  get_table_offset(const std::uint8_t* data_ptr) const noexcept {
+          page_type*  i_page_ptr = m_page_head;
+          while(i_page_ptr) {
+              const std::uint8_t* l_base_ptr = i_page_ptr->get_base_ptr();
+              if((data_ptr >= l_base_ptr) &&
+                  (data_ptr < l_base_ptr + i_page_ptr->get_used_count())) {
+                  return i_page_ptr->m_gto_base + static_cast<int>(data_ptr - l_base_ptr);
+              }
+              i_page_ptr = i_page_ptr->m_page_next;
+          }
+          return -1;
+  }
+
   inline  std::uint8_t* get_table_ptr(int offset) noexcept {
           if(offset >= 0) {
               page_type*  i_page_ptr    = m_page_head;
@@ -294,6 +600,14 @@ class pool<std::uint8_t, PageSize>
           return nullptr;
   }
 
+  /* get_memory_stats()
+     add up the memory held by the pool into `stats`; padding is the alignment of the blocks to `1 << m_align`
+  */
+          void  get_memory_stats(memory_stats_t& stats) const noexcept {
+          page<data_type, PageSize>::get_memory_stats(m_page_head, stats);
+          stats.pad_size += m_pad_size;
+  }
+
           pool& operator=(const pool&) noexcept = delete;
           pool& operator=(pool&&) noexcept = delete;
 };
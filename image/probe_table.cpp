@@ -0,0 +1,180 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "probe_table.h"
+#include "hash.h"
+#include <cstring>
+
+namespace uld {
+
+/* probe_frame_t
+   probed call in progress
+*/
+struct probe_frame_t
+{
+  probe_t*       probe;
+  std::uint8_t*  return_address;
+  std::uint32_t  time;
+};
+
+/* probe_thunk_t
+   the code the probed functions return to, which branches to `leave` as a literal
+*/
+struct alignas(4) probe_thunk_t
+{
+  std::uint16_t  code[6];
+  std::uint32_t  leave;
+};
+
+static probe_frame_t s_frame_list[probe_depth_max];
+static int     s_frame_count = 0;
+static probe_thunk_t s_exit_thunk;
+
+/* uld_probe_enter(), uld_probe_leave()
+   probe_enter() and probe_leave() as called by the trampolines: the function to continue to and the address it should
+   return to come back in r0 and r1
+*/
+extern "C" std::uint64_t uld_probe_enter(probe_t* probe, std::uint8_t* return_address) noexcept
+{
+      std::uint32_t l_return_address = reinterpret_cast<std::uintptr_t>(probe_enter(probe, return_address));
+      std::uint32_t l_body_address = reinterpret_cast<std::uintptr_t>(probe->body);
+      return l_body_address | (static_cast<std::uint64_t>(l_return_address) << 32);
+}
+
+extern "C" std::uint32_t uld_probe_leave() noexcept
+{
+      return reinterpret_cast<std::uintptr_t>(probe_leave());
+}
+
+/* probe_enter()
+   count the call and push it on the shadow stack, the slot first, for the calls made by the interrupt handlers
+   meanwhile to nest
+*/
+auto  probe_enter(probe_t* probe, std::uint8_t* return_address) noexcept -> std::uint8_t*
+{
+      probe->call_count++;
+      if(s_frame_count < probe_depth_max) {
+          probe_frame_t& l_frame = s_frame_list[s_frame_count++];
+          l_frame.probe = probe;
+          l_frame.return_address = return_address;
+          l_frame.time = time_us_32();
+          return reinterpret_cast<std::uint8_t*>(std::addressof(s_exit_thunk)) + 1;
+      }
+      return return_address;
+}
+
+auto  probe_leave() noexcept -> std::uint8_t*
+{
+      std::uint32_t  l_time = time_us_32();
+      probe_frame_t& l_frame = s_frame_list[s_frame_count - 1];
+      probe_t*       l_probe_ptr = l_frame.probe;
+      std::uint8_t*  l_return_address = l_frame.return_address;
+      l_probe_ptr->time += l_time - l_frame.time;
+      s_frame_count--;
+      return l_return_address;
+}
+
+      probe_table_t::probe_table_t(allocator_t* allocator) noexcept:
+      table(allocator),
+      m_probe_count(0)
+{
+}
+
+      probe_table_t::~probe_table_t()
+{
+}
+
+/* make_probe()
+   the probe of the function `name`, made if not there yet; the name has to outlive the table
+*/
+probe_t* probe_table_t::make_probe(const char* name) noexcept
+{
+      if(probe_t*
+          l_probe_ptr = find_probe(name);
+          l_probe_ptr != nullptr) {
+          return l_probe_ptr;
+      }
+      if(s_exit_thunk.leave == 0) {
+          s_exit_thunk.code[0] = 0xb40f;  // push {r0, r1, r2, r3}
+          s_exit_thunk.code[1] = 0x4802;  // ldr  r0, leave
+          s_exit_thunk.code[2] = 0x4780;  // blx  r0
+          s_exit_thunk.code[3] = 0x4684;  // mov  ip, r0
+          s_exit_thunk.code[4] = 0xbc0f;  // pop  {r0, r1, r2, r3}
+          s_exit_thunk.code[5] = 0x4760;  // bx   ip
+          s_exit_thunk.leave = reinterpret_cast<std::uintptr_t>(uld_probe_leave);
+      }
+      probe_t* l_probe_ptr = raw_get();
+      if(l_probe_ptr != nullptr) {
+          l_probe_ptr->code[0] = 0xb40f;  // push {r0, r1, r2, r3}
+          l_probe_ptr->code[1] = 0x4671;  // mov  r1, lr
+          l_probe_ptr->code[2] = 0x4803;  // ldr  r0, record
+          l_probe_ptr->code[3] = 0x4a04;  // ldr  r2, enter
+          l_probe_ptr->code[4] = 0x4790;  // blx  r2
+          l_probe_ptr->code[5] = 0x4684;  // mov  ip, r0
+          l_probe_ptr->code[6] = 0x468e;  // mov  lr, r1
+          l_probe_ptr->code[7] = 0xbc0f;  // pop  {r0, r1, r2, r3}
+          l_probe_ptr->code[8] = 0x4760;  // bx   ip
+          l_probe_ptr->code[9] = 0xbf00;  // nop
+          l_probe_ptr->record = reinterpret_cast<std::uintptr_t>(l_probe_ptr);
+          l_probe_ptr->enter = reinterpret_cast<std::uintptr_t>(uld_probe_enter);
+          l_probe_ptr->name = name;
+          l_probe_ptr->hash = get_name_hash(name);
+          l_probe_ptr->body = nullptr;
+          l_probe_ptr->site_count = 0;
+          l_probe_ptr->call_count = 0;
+          l_probe_ptr->time = 0;
+          m_probe_count++;
+      }
+      return l_probe_ptr;
+}
+
+probe_t* probe_table_t::find_probe(const char* name) noexcept
+{
+      if(m_probe_count > 0) {
+          std::uint32_t l_hash = get_name_hash(name);
+          for(probe_t& l_probe : *this) {
+              if(l_probe.hash == l_hash) {
+                  if(std::strcmp(l_probe.name, name) == 0) {
+                      return std::addressof(l_probe);
+                  }
+              }
+          }
+      }
+      return nullptr;
+}
+
+int   probe_table_t::get_probe_count() const noexcept
+{
+      return m_probe_count;
+}
+
+/* reset_counts()
+   zero the call counts and times of all the probes
+*/
+void  probe_table_t::reset_counts() noexcept
+{
+      for(probe_t& l_probe : *this) {
+          l_probe.call_count = 0;
+          l_probe.time = 0;
+      }
+}
+
+/*namespace uld*/ }
@@ -0,0 +1,87 @@
+#ifndef uld_image_probe_table_h
+#define uld_image_probe_table_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "table.h"
+
+namespace uld {
+
+/* probe_t
+   counting trampoline for a function of the loaded code (see `image::make_probe()`): the thumb call relocations against
+   the function branch to `code`, which counts the call and notes the time in probe_enter(), has the function return to
+   the shared exit thunk, then continues to the function itself; the exit thunk adds up the time spent in the function,
+   callees included, in probe_leave() and returns to the caller. `code` branches to `record` and `enter` as literals,
+   and so has to stay the first member.
+*/
+struct alignas(4) probe_t
+{
+  std::uint16_t  code[10];
+  std::uint32_t  record;     // address of the probe
+  std::uint32_t  enter;      // address of uld_probe_enter()
+  const char*    name;
+  std::uint32_t  hash;
+  std::uint8_t*  body;       // address the trampoline continues to: that of the function, thumb bit included
+  std::uint32_t  site_count; // call sites redirected to the probe
+  std::uint32_t  call_count;
+  std::uint32_t  time;       // microseconds spent in the function, callees included
+};
+
+/* probe_depth_max
+   depth of the shadow stack of the probed calls in progress; the calls made deeper than that are counted, but not timed
+*/
+constexpr int probe_depth_max = 64;
+
+/* probe_table_t
+   the probes of an image; the probed calls in progress are kept on a single shadow stack, shared by all the images,
+   which supports the calls made from interrupt handlers, as these nest, but not the calls made from the second core,
+   nor the calls unwound without returning (longjmp())
+*/
+class probe_table_t: public table<probe_t, page_size>
+{
+  int     m_probe_count;
+
+  public:
+          probe_table_t(allocator_t* = nullptr) noexcept;
+          probe_table_t(const probe_table_t&) noexcept = delete;
+          probe_table_t(probe_table_t&&) noexcept = delete;
+          ~probe_table_t();
+
+          probe_t*  make_probe(const char*) noexcept;
+          probe_t*  find_probe(const char*) noexcept;
+          int       get_probe_count() const noexcept;
+          void      reset_counts() noexcept;
+
+          probe_table_t& operator=(const probe_table_t&) noexcept = delete;
+          probe_table_t& operator=(probe_table_t&&) noexcept = delete;
+};
+
+/* probe_enter(), probe_leave()
+   the halves of a probed call, called by the trampoline and by the exit thunk respectively: probe_enter() counts the
+   call and returns the address the function should return to, probe_leave() returns the address of the caller
+*/
+auto  probe_enter(probe_t*, std::uint8_t*) noexcept -> std::uint8_t*;
+auto  probe_leave() noexcept -> std::uint8_t*;
+
+/*namespace uld*/ }
+#endif
@@ -23,20 +23,33 @@
 #include "target.h"
 #include "string_table.h"
 #include "symbol_table.h"
+#include "hash.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
 
 namespace uld {
 
-      program_table_t::program_table_t(target* target, string_table_t* strtab, symbol_table_t* symtab) noexcept:
+      program_table_t::program_table_t(target* target, string_table_t* strtab, symbol_table_t* symtab, allocator_t* allocator) noexcept:
       m_target(target),
       m_string_table(strtab),
       m_symbol_table(symtab),
-      m_segment_count(segment_count_min)
+      m_allocator(allocator),
+      m_segment_list(allocator),
+      m_slot_list(m_segment_list.get_allocator()),
+      m_rule_list(m_segment_list.get_allocator())
 {
-      make_segment(nullptr, section_t::type_undef, section_t::no_flags);
+      if(m_segment_list.reserve(segment_count_min)) {
+          m_segment_list.resize(segment_default_count, nullptr);
+          make_segment(nullptr, section_t::type_undef, section_t::no_flags);
+      }
 }
 
       program_table_t::~program_table_t()
 {
+      for(segment* l_segment_ptr : m_segment_list) {
+          delete l_segment_ptr;
+      }
 }
 
 int   program_table_t::get_default_segment_mapping(unsigned int type, unsigned int flags) const noexcept
@@ -63,6 +76,10 @@ int   program_table_t::get_default_segment_mapping(unsigned int type, unsigned i
       return -1;
 }
 
+/* get_default_segment_alignment()
+   alignment of the blocks a default segment hands out, unless they ask for their own: the sections of the objects are
+   placed at their `sh_addralign`, see `factory::uld_get_section_data()`
+*/
 int   program_table_t::get_default_segment_alignment(unsigned int type, unsigned int flags) const noexcept
 {
       if(type == section_t::type_undef) {
@@ -89,67 +106,256 @@ segment* program_table_t::make_segment(int meta, unsigned int type, unsigned int
         return make_segment(m_target->get_segment_name(meta), type, flags, align);
 }
 
-segment* program_table_t::make_segment(const char* name, unsigned int type, unsigned int flags, int align) noexcept
+/* uld_has_pattern()
+   tell if section `name` matches `pattern`: exactly, or by prefix if the pattern ends with a `*`; a null pattern matches
+   any name
+*/
+bool  program_table_t::uld_has_pattern(const char* pattern, const char* name) noexcept
 {
-      int  i_segment = get_default_segment_mapping(type, flags);
-      if(i_segment > 0) {
-          // if the default mapping returns an existing segment but names don't match, then this has to be a new segment
-          // clear segment index if so and let the routine create a new segment
-          if((name != nullptr) &&
-              (m_segment_list[i_segment] != nullptr)) {
-              if(m_segment_list[i_segment]->has_name(name) == false) {
-                  i_segment = -1;
+      if(pattern == nullptr) {
+          return true;
+      }
+      if(name == nullptr) {
+          return false;
+      }
+      int  l_pattern_length = std::strlen(pattern);
+      if((l_pattern_length > 0) &&
+          (pattern[l_pattern_length - 1] == '*')) {
+          return std::strncmp(pattern, name, l_pattern_length - 1) == 0;
+      }
+      return std::strcmp(pattern, name) == 0;
+}
+
+/* uld_index_segment()
+   add the segment at `index` to the name index, doubling the index as it gets half full
+*/
+bool  program_table_t::uld_index_segment(int index) noexcept
+{
+      const char* l_name = m_segment_list[index]->get_name();
+      if(l_name == nullptr) {
+          return true;
+      }
+      int  l_index_count = 0;
+      for(const slot_t& l_slot : m_slot_list) {
+          if(l_slot.index >= 0) {
+              l_index_count++;
+          }
+      }
+      if((l_index_count + 1) * 2 > m_slot_list.size()) {
+          int  l_slot_count = m_slot_list.size() > 0 ? m_slot_list.size() * 2 : slot_count_min;
+          block_list_t<slot_t> l_slot_list(m_slot_list.get_allocator());
+          if(l_slot_list.resize(l_slot_count, slot_t{0, -1}) == false) {
+              return false;
+          }
+          for(const slot_t& l_slot : m_slot_list) {
+              if(l_slot.index >= 0) {
+                  int  i_slot = l_slot.hash & (l_slot_count - 1);
+                  while(l_slot_list[i_slot].index >= 0) {
+                      i_slot = (i_slot + 1) & (l_slot_count - 1);
+                  }
+                  l_slot_list[i_slot] = l_slot;
               }
           }
+          m_slot_list.swap(l_slot_list);
       }
-      // look for a free slot into the local segment array
-      if(i_segment < 0) {
-          for(int i_segment = m_segment_count; i_segment < segment_count_max; i_segment++) {
-              if(m_segment_list[i_segment] == nullptr) {
-                  i_segment = i_segment;
-                  break;
+      int           l_slot_mask = m_slot_list.size() - 1;
+      std::uint32_t l_hash = get_name_hash(l_name);
+      int           i_slot = l_hash & l_slot_mask;
+      while(m_slot_list[i_slot].index >= 0) {
+          i_slot = (i_slot + 1) & l_slot_mask;
+      }
+      m_slot_list[i_slot].hash = l_hash;
+      m_slot_list[i_slot].index = index;
+      return true;
+}
+
+/* uld_find_segment()
+   index of the segment named `name`, of hash `hash`, -1 if there's none
+*/
+int   program_table_t::uld_find_segment(const char* name, std::uint32_t hash) const noexcept
+{
+      if(m_slot_list.empty()) {
+          return -1;
+      }
+      int  l_slot_mask = m_slot_list.size() - 1;
+      for(int i_slot = hash & l_slot_mask; m_slot_list[i_slot].index >= 0; i_slot = (i_slot + 1) & l_slot_mask) {
+          if(m_slot_list[i_slot].hash == hash) {
+              int  l_index = m_slot_list[i_slot].index;
+              if(m_segment_list[l_index]->has_name(name)) {
+                  return l_index;
               }
           }
       }
-      // create the the segment and associate a 'section' symbol with it
+      return -1;
+}
+
+/* uld_get_region_segment()
+   the segment of `region` standing for the default segment of sections of type `type` and flags `flags`, named after
+   both, i.e. `.text@scratch_x`; made on first use, without any memory of its own until something is placed into it
+*/
+segment* program_table_t::uld_get_region_segment(const region_t* region, unsigned int type, unsigned int flags) noexcept
+{
+      int  l_default_index = get_default_segment_mapping(type, flags);
+      if(l_default_index <= 0) {
+          return get_segment_by_attributes(type, flags);
+      }
+      segment* l_default_ptr = get_segment_by_index(l_default_index);
+      if(l_default_ptr == nullptr) {
+          return nullptr;
+      }
+      char     l_name[64];
+      int      l_name_length = std::snprintf(l_name, sizeof(l_name), "%s@%s", l_default_ptr->get_name(), region->name);
+      if((l_name_length < 0) ||
+          (l_name_length >= static_cast<int>(sizeof(l_name)))) {
+          return nullptr;
+      }
+      if(segment*
+          l_segment_ptr = get_segment_by_name(l_name);
+          l_segment_ptr != nullptr) {
+          return l_segment_ptr;
+      }
+      return make_segment(l_name, l_default_ptr->get_type(), l_default_ptr->get_flags(), l_default_ptr->get_align(), region->allocator);
+}
+
+/* make_segment()
+   the segment named `name`, made if there's none yet: the first segment made for a type and flags the image has a
+   default segment for takes its place, the others are added after the default ones
+*/
+segment* program_table_t::make_segment(const char* name, unsigned int type, unsigned int flags, int align, allocator_t* allocator) noexcept
+{
+      if(name != nullptr) {
+          if(segment*
+              l_segment_ptr = get_segment_by_name(name);
+              l_segment_ptr != nullptr) {
+              return l_segment_ptr;
+          }
+      }
+      int  i_segment = get_default_segment_mapping(type, flags);
+      if(m_segment_list.size() < segment_default_count) {
+          return nullptr;
+      }
       if(i_segment >= 0) {
-          if(i_segment > 0) {
-              if(m_segment_list[i_segment] == nullptr) {
-                  symbol_t* l_symbol_ptr = m_symbol_table->make_symbol(name, type, flags);
-                  if(l_symbol_ptr == nullptr) {
-                      return nullptr;
-                  }
-                  if(align <= 0) {
-                      align = get_default_segment_alignment(type, flags);
-                  }
-                  auto l_segment_ptr = std::make_unique<segment>(l_symbol_ptr->name, type, flags, align);
-                  if(l_segment_ptr == nullptr) {
-                      return nullptr;
-                  }
-                  l_symbol_ptr->ea = nullptr;
-                  l_symbol_ptr->ra = nullptr;
-                  m_segment_list[i_segment] = std::move(l_segment_ptr);
-              }
-              if(i_segment >= segment_count_min) {
-                  m_segment_count++;
+          // the default slot is taken by a segment of another name: this has to be a new segment
+          if(m_segment_list[i_segment] != nullptr) {
+              if(i_segment == 0) {
+                  return m_segment_list[i_segment];
               }
+              i_segment = -1;
           }
-          return m_segment_list[i_segment].get();
       }
-      return nullptr;
+      // create the the segment; its name goes into the string table, but not into the symbol table: a 'section' symbol
+      // would never get an address, and only lengthen the lookups
+      const char* l_name_ptr = nullptr;
+      if(name != nullptr) {
+          l_name_ptr = m_string_table->make_string(name);
+          if(l_name_ptr == nullptr) {
+              return nullptr;
+          }
+      }
+      if(align <= 0) {
+          align = get_default_segment_alignment(type, flags);
+      }
+      if(allocator == nullptr) {
+          allocator = m_allocator;
+      }
+      if(i_segment < 0) {
+          if(m_segment_list.push_back(nullptr) == false) {
+              return nullptr;
+          }
+          i_segment = m_segment_list.size() - 1;
+      }
+      segment* l_segment_ptr = new(std::nothrow) segment(l_name_ptr, type, flags, align, allocator);
+      if(l_segment_ptr == nullptr) {
+          return nullptr;
+      }
+      m_segment_list[i_segment] = l_segment_ptr;
+      if(uld_index_segment(i_segment) == false) {
+          return nullptr;
+      }
+      return l_segment_ptr;
+}
+
+/* make_region_segment()
+   make segment `name` within region `region_name` of the target memory map, its pages taken from the allocator of the
+   region; nullptr if there's no such region, or if the loader can't allocate from it
+*/
+segment* program_table_t::make_region_segment(const char* name, unsigned int type, unsigned int flags, int align, const char* region_name) noexcept
+{
+      const region_t* l_region_ptr = m_target->get_region_by_name(region_name);
+      if((l_region_ptr == nullptr) ||
+          (l_region_ptr->allocator == nullptr)) {
+          return nullptr;
+      }
+      return make_segment(name, type, flags, align, l_region_ptr->allocator);
+}
+
+bool  program_table_t::uld_make_rule(const char* pattern, unsigned int flags_mask, unsigned int flags, segment* target, const region_t* region) noexcept
+{
+      const char* l_pattern_ptr = nullptr;
+      if(pattern != nullptr) {
+          l_pattern_ptr = m_string_table->make_string(pattern);
+          if(l_pattern_ptr == nullptr) {
+              return false;
+          }
+      }
+      return m_rule_list.push_back(rule_t{l_pattern_ptr, flags_mask, flags & flags_mask, target, region});
+}
+
+/* add_segment_rule()
+   have the sections whose name matches `pattern` (exactly, or by prefix if it ends with a `*`; any name if nullptr) and
+   whose flags, masked by `flags_mask`, equal `flags`, go to segment `segment_name`, which has to exist (see
+   `make_segment()` and `make_region_segment()`); the rules are tried in the order they were added, the first match
+   winning, and the sections none of them matches go to the default segments. Within a batch, the sections the rules
+   place are laid out in the order of their rules, ahead of the others of their segment. The rules apply to the
+   sections loaded from then on.
+*/
+bool  program_table_t::add_segment_rule(const char* pattern, unsigned int flags_mask, unsigned int flags, const char* segment_name) noexcept
+{
+      segment* l_segment_ptr = get_segment_by_name(segment_name);
+      if(l_segment_ptr == nullptr) {
+          return false;
+      }
+      return uld_make_rule(pattern, flags_mask, flags, l_segment_ptr, nullptr);
+}
+
+/* add_region_rule()
+   same as `add_segment_rule()`, for the sections to go to the segment of region `region_name` of the target memory map
+   standing for the default segment of their type and flags; only regions the loader can allocate from qualify
+*/
+bool  program_table_t::add_region_rule(const char* pattern, unsigned int flags_mask, unsigned int flags, const char* region_name) noexcept
+{
+      const region_t* l_region_ptr = m_target->get_region_by_name(region_name);
+      if(l_region_ptr == nullptr) {
+          return false;
+      }
+      if(l_region_ptr->allocator == nullptr) {
+          return false;
+      }
+      return uld_make_rule(pattern, flags_mask, flags, nullptr, l_region_ptr);
+}
+
+int   program_table_t::get_rule_count() const noexcept
+{
+      return m_rule_list.size();
 }
 
 segment* program_table_t::get_segment_by_index(int index) noexcept
 {
       if((index >= 0) &&
-          (index < m_segment_count)) {
-          return m_segment_list[index].get();
+          (index < m_segment_list.size())) {
+          return m_segment_list[index];
       }
       return nullptr;
 }
 
-segment* program_table_t::get_segment_by_name(const char*) noexcept
+segment* program_table_t::get_segment_by_name(const char* name) noexcept
 {
+      if(name != nullptr) {
+          int  l_index = uld_find_segment(name, get_name_hash(name));
+          if(l_index >= 0) {
+              return m_segment_list[l_index];
+          }
+      }
       return nullptr;
 }
 
@@ -160,14 +366,17 @@ segment* program_table_t::get_segment_by_attributes(unsigned int type, unsigned
           return get_segment_by_index(i_segment);
       } else
       if(i_segment < 0) {
-          for(i_segment = 0; i_segment < m_segment_count; i_segment++) {
+          for(i_segment = 0; i_segment < m_segment_list.size(); i_segment++) {
+              if(m_segment_list[i_segment] == nullptr) {
+                  continue;
+              }
               if(m_segment_list[i_segment]->has_type(type)) {
                   // match only on type and disregard attribute flags or match the exact specified flags
                   if((flags & section_t::type_bits) == section_t::type_bits) {
-                      return m_segment_list[i_segment].get();
+                      return m_segment_list[i_segment];
                   } else
                   if(m_segment_list[i_segment]->has_flags(flags)) {
-                      return m_segment_list[i_segment].get();
+                      return m_segment_list[i_segment];
                   }
               }
           }
@@ -175,13 +384,65 @@ segment* program_table_t::get_segment_by_attributes(unsigned int type, unsigned
       return nullptr;
 }
 
+/* get_segment_by_section()
+   the segment a section named `name`, of type `type` and flags `flags`, goes to: that of the first rule the section
+   matches, whose index goes to `rule_index` (-1 if none), or the default one for its type and flags
+*/
+segment* program_table_t::get_segment_by_section(const char* name, unsigned int type, unsigned int flags, int* rule_index) noexcept
+{
+      int  l_rule_count = m_rule_list.size();
+      for(int i_rule = 0; i_rule < l_rule_count; i_rule++) {
+          const rule_t& l_rule = m_rule_list[i_rule];
+          if((flags & l_rule.flags_mask) == l_rule.flags) {
+              if(uld_has_pattern(l_rule.pattern, name)) {
+                  if(rule_index != nullptr) {
+                      *rule_index = i_rule;
+                  }
+                  if(l_rule.target != nullptr) {
+                      return l_rule.target;
+                  }
+                  return uld_get_region_segment(l_rule.region, type, flags);
+              }
+          }
+      }
+      if(rule_index != nullptr) {
+          *rule_index = -1;
+      }
+      return get_segment_by_attributes(type, flags);
+}
+
 int   program_table_t::get_segment_count() const noexcept
 {
-      return m_segment_count;
+      return m_segment_list.size();
 }
 
 void  program_table_t::free_segment(segment*) noexcept
 {
 }
 
+/* get_segment_memory_stats()
+   add up the memory held by the segment at `index` into `stats`; false if there's no such segment
+*/
+bool  program_table_t::get_segment_memory_stats(int index, memory_stats_t& stats) const noexcept
+{
+      if((index >= 0) &&
+          (index < m_segment_list.size())) {
+          if(m_segment_list[index] != nullptr) {
+              m_segment_list[index]->get_memory_stats(stats);
+              return true;
+          }
+      }
+      return false;
+}
+
+/* get_memory_stats()
+   add up the memory held by all the segments into `stats`
+*/
+void  program_table_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      for(int i_segment = 0; i_segment < m_segment_list.size(); i_segment++) {
+          get_segment_memory_stats(i_segment, stats);
+      }
+}
+
 /*namespace uld*/ }
@@ -22,47 +22,88 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include <uld.h>
+#include <target.h>
 #include "segment.h"
 #include "table.h"
-#include <memory>
+#include "block_list.h"
 
 namespace uld {
 
 class string_table_t;
 class symbol_table_t;
   
+/* program_table_t
+   segments of an image; sections go to the default segment for their type and flags, unless a segment rule (see
+   `add_segment_rule()`) sends them to a named segment of the image, or a region rule (see `add_region_rule()`) to the
+   same kind of segment within a region of the target memory map. Segments are looked up by name through a hash index.
+*/
 class program_table_t
 {
   target*                   m_target;
   string_table_t*           m_string_table;
   symbol_table_t*           m_symbol_table;
+  allocator_t*              m_allocator;      // memory source for the segments
 
   private:
   static constexpr int      segment_count_min = 8;
-  static constexpr int      segment_count_max = 16;
+  static constexpr int      segment_default_count = 5;  // null, text, data, rodata and bss, at their mapping index
+  static constexpr int      slot_count_min = 16;
+
+  /* rule_t
+     placement rule: sections whose name matches `pattern` (if any) and whose flags, masked by `flags_mask`, equal
+     `flags`, go to segment `target` or, if none, to the segment of `region` standing for their default one
+  */
+  struct rule_t
+  {
+    const char*     pattern;
+    unsigned int    flags_mask;
+    unsigned int    flags;
+    segment*        target;
+    const region_t* region;
+  };
+
+  struct slot_t
+  {
+    std::uint32_t   hash;
+    int             index;            // index of the segment, -1 if the slot is free
+  };
 
   private:
-  std::unique_ptr<segment>  m_segment_list[segment_count_max];
-  int                       m_segment_count;
+  block_list_t<segment*>    m_segment_list;   // owned, the default ones at their mapping index
+  block_list_t<slot_t>      m_slot_list;      // open addressed index of the segment names
+  block_list_t<rule_t>      m_rule_list;
 
   private:
           int         get_default_segment_mapping(unsigned int, unsigned int) const noexcept;
           int         get_default_segment_alignment(unsigned int, unsigned int) const noexcept;
+  static  bool        uld_has_pattern(const char*, const char*) noexcept;
+          bool        uld_index_segment(int) noexcept;
+          int         uld_find_segment(const char*, std::uint32_t) const noexcept;
+          bool        uld_make_rule(const char*, unsigned int, unsigned int, segment*, const region_t*) noexcept;
+          segment*    uld_get_region_segment(const region_t*, unsigned int, unsigned int) noexcept;
 
   public:
-          program_table_t(target*, string_table_t*, symbol_table_t*) noexcept;
+          program_table_t(target*, string_table_t*, symbol_table_t*, allocator_t* = nullptr) noexcept;
           program_table_t(const program_table_t&) noexcept = delete;
           program_table_t(program_table_t&&) noexcept = delete;
           ~program_table_t();
 
           segment*    make_segment(int, unsigned int, unsigned int, int = 0) noexcept;
-          segment*    make_segment(const char*, unsigned int, unsigned int, int = 0) noexcept;
+          segment*    make_segment(const char*, unsigned int, unsigned int, int = 0, allocator_t* = nullptr) noexcept;
+          segment*    make_region_segment(const char*, unsigned int, unsigned int, int, const char*) noexcept;
+          bool        add_segment_rule(const char*, unsigned int, unsigned int, const char*) noexcept;
+          bool        add_region_rule(const char*, unsigned int, unsigned int, const char*) noexcept;
+          int         get_rule_count() const noexcept;
           segment*    get_segment_by_index(int) noexcept;
           segment*    get_segment_by_name(const char*) noexcept;
           segment*    get_segment_by_attributes(unsigned int, unsigned int) noexcept;
+          segment*    get_segment_by_section(const char*, unsigned int, unsigned int, int* = nullptr) noexcept;
           int         get_segment_count() const noexcept;
           void        free_segment(segment*) noexcept;
 
+          bool        get_segment_memory_stats(int, memory_stats_t&) const noexcept;
+          void        get_memory_stats(memory_stats_t&) const noexcept;
+
           program_table_t& operator=(const program_table_t&) noexcept = delete;
           symbol_table_t& operator=(program_table_t&&) noexcept = delete;
 };
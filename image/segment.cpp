@@ -24,8 +24,8 @@
 
 namespace uld {
 
-      segment::segment(const char* name, unsigned int type, unsigned int flags, int align) noexcept:
-      pool(align),
+      segment::segment(const char* name, unsigned int type, unsigned int flags, int align, allocator_t* allocator) noexcept:
+      pool(align, allocator),
       m_name(name),
       m_type(type),
       m_flags(flags)
@@ -35,7 +35,7 @@ class segment: public pool<std::uint8_t, page_size>
   unsigned int  m_flags;
 
   public:
-        segment(const char*, unsigned int, unsigned int, int = 0) noexcept;
+        segment(const char*, unsigned int, unsigned int, int = 0, allocator_t* = nullptr) noexcept;
         segment(const segment&) noexcept = delete;
         segment(segment&&) noexcept = delete;
         ~segment();
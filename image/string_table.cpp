@@ -20,13 +20,22 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "string_table.h"
+#include "hash.h"
 #include <cstring>
 
 namespace uld {
 
-      string_table_t::string_table_t() noexcept:
-      pool()
+      string_table_t::string_table_t(allocator_t* allocator, bool intern, int reserve_size) noexcept:
+      pool(allocator),
+      m_slot_list(m_allocator),
+      m_slot_mask(0),
+      m_string_count(0),
+      m_intern(intern)
 {
+      // size the first page, if so asked
+      if(reserve_size > 0) {
+          reserve(reserve_size);
+      }
       // reserve a first empty string entry
       make_string(nullptr, 1);
 }
@@ -35,30 +44,188 @@ namespace uld {
 {
 }
 
+/* uld_reserve_slots()
+   make room for (at least) `count` strings into the interning index, keeping its load under three quarters: the index is
+   pure overhead on top of the strings, and names hash well enough for the probe runs to stay short
+*/
+bool  string_table_t::uld_reserve_slots(int count) noexcept
+{
+      int  l_slot_count = slot_count_min;
+      while(l_slot_count * 3 < count * 4) {
+          l_slot_count <<= 1;
+      }
+      if(l_slot_count > m_slot_list.size()) {
+          block_list_t<slot_t> l_slot_list(m_slot_list.get_allocator());
+          if(l_slot_list.resize(l_slot_count, slot_t{0, nullptr}) == false) {
+              return false;
+          }
+          int  l_slot_mask = l_slot_count - 1;
+          for(slot_t& l_slot : m_slot_list) {
+              if(l_slot.string != nullptr) {
+                  int l_slot_index = l_slot.hash & l_slot_mask;
+                  while(l_slot_list[l_slot_index].string != nullptr) {
+                      l_slot_index = (l_slot_index + 1) & l_slot_mask;
+                  }
+                  l_slot_list[l_slot_index] = l_slot;
+              }
+          }
+          m_slot_list.swap(l_slot_list);
+          m_slot_mask = l_slot_mask;
+      }
+      return true;
+}
+
+/* uld_get_slot()
+   find the slot holding the string of `string_length` characters at `string_ptr`, or the free slot it would go into;
+   nullptr if the index has no slots at all
+*/
+auto  string_table_t::uld_get_slot(const char* string_ptr, int string_length, std::uint32_t hash) noexcept -> slot_t*
+{
+      if(m_slot_list.size() > 0) {
+          int  l_slot_index = hash & m_slot_mask;
+          while(m_slot_list[l_slot_index].string != nullptr) {
+              slot_t& l_slot = m_slot_list[l_slot_index];
+              if(l_slot.hash == hash) {
+                  if((std::strncmp(l_slot.string, string_ptr, string_length) == 0) &&
+                      (l_slot.string[string_length] == 0)) {
+                      return std::addressof(l_slot);
+                  }
+              }
+              l_slot_index = (l_slot_index + 1) & m_slot_mask;
+          }
+          return std::addressof(m_slot_list[l_slot_index]);
+      }
+      return nullptr;
+}
+
+/* adopt()
+   take over the pages of `other`, which has to draw from the same allocator and be in the same mode; when interning, the
+   strings of `other` join the index, save for those the table already holds: `find_string()` then maps them to the copies
+   of the table
+*/
+bool  string_table_t::adopt(string_table_t& other) noexcept
+{
+      if(other.m_intern != m_intern) {
+          return false;
+      }
+      if(pool::adopt(other) == false) {
+          return false;
+      }
+      if(m_intern) {
+          if(uld_reserve_slots(m_string_count + other.m_string_count) == false) {
+              return false;
+          }
+          for(slot_t& l_slot : other.m_slot_list) {
+              if(l_slot.string != nullptr) {
+                  slot_t* l_slot_ptr = uld_get_slot(l_slot.string, std::strlen(l_slot.string), l_slot.hash);
+                  if(l_slot_ptr->string == nullptr) {
+                      *l_slot_ptr = l_slot;
+                      m_string_count++;
+                  }
+              }
+          }
+          other.m_slot_list.clear();
+          other.m_slot_mask = 0;
+          other.m_string_count = 0;
+      }
+      return true;
+}
+
+/* reserve()
+   make room for the next `count` characters, in `string_count` strings (see `pool<char>::reserve()`), and for as many more
+   strings into the interning index
+*/
+void  string_table_t::reserve(int count, int string_count) noexcept
+{
+      pool::reserve(count, string_count);
+      if(m_intern) {
+          uld_reserve_slots(m_string_count + string_count);
+      }
+}
+
+/* make_string()
+   copy a string into the table, or, if `string_ptr` is nullptr, reserve a blank one of `string_length` characters; in
+   interning mode, a string that the table already holds is returned instead of being copied
+*/
 char* string_table_t::make_string(const char* string_ptr, int string_length) noexcept
 {
-      char* l_string_ptr = nullptr;
-      int   l_string_size;
+      char*   l_string_ptr = nullptr;
+      int     l_string_size;
+      slot_t* l_slot_ptr = nullptr;
       if(string_length <= 0) {
           if(string_ptr != nullptr) {
-              l_string_size = std::strlen(string_ptr) + 1;
+              string_length = std::strlen(string_ptr);
           } else
               return nullptr;
-      } else
-          l_string_size = string_length + 1;
+      }
+      l_string_size = string_length + 1;
+      if(m_intern) {
+          if(string_ptr != nullptr) {
+              std::uint32_t l_hash = get_name_hash(string_ptr, string_length);
+              if(uld_reserve_slots(m_string_count + 1) == false) {
+                  return nullptr;
+              }
+              l_slot_ptr = uld_get_slot(string_ptr, string_length, l_hash);
+              if(l_slot_ptr->string != nullptr) {
+                  return l_slot_ptr->string;
+              }
+              l_slot_ptr->hash = l_hash;
+          }
+      }
       l_string_ptr = raw_get(l_string_size);
       if(l_string_ptr != nullptr) {
           if(string_ptr != nullptr) {
-              std::memcpy(l_string_ptr, string_ptr, l_string_size);
+              std::memcpy(l_string_ptr, string_ptr, string_length);
+              l_string_ptr[string_length] = 0;
           } else
               std::memset(l_string_ptr, 0, l_string_size);
+          if(l_slot_ptr != nullptr) {
+              l_slot_ptr->string = l_string_ptr;
+              m_string_count++;
+          }
       }
       return l_string_ptr;
 }
 
+/* find_string()
+   get the interned copy of the given string; nullptr if the table doesn't hold it, or isn't in interning mode
+*/
+char* string_table_t::find_string(const char* string_ptr, int string_length) noexcept
+{
+      if(m_intern) {
+          if(string_ptr != nullptr) {
+              if(string_length <= 0) {
+                  string_length = std::strlen(string_ptr);
+              }
+              if(slot_t*
+                  l_slot_ptr = uld_get_slot(string_ptr, string_length, get_name_hash(string_ptr, string_length));
+                  l_slot_ptr != nullptr) {
+                  return l_slot_ptr->string;
+              }
+          }
+      }
+      return nullptr;
+}
+
 char* string_table_t::get_string(int offset) noexcept
 {
       return get_offset_ptr(offset);
 }
 
+bool  string_table_t::is_interning() const noexcept
+{
+      return m_intern;
+}
+
+/* get_memory_stats()
+   add up the memory held by the table into `stats`; the interning index counts as overhead
+*/
+void  string_table_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int l_index_size = m_slot_list.capacity() * sizeof(slot_t);
+      pool::get_memory_stats(stats);
+      stats.alloc_size += l_index_size;
+      stats.head_size  += l_index_size;
+}
+
 /*namespace uld*/ }
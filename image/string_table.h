@@ -23,20 +23,48 @@
 **/
 #include <uld.h>
 #include "pool.h"
+#include "allocator.h"
+#include "block_list.h"
 
 namespace uld {
 
+/* string_table_t
+   string pool; in interning mode, equal strings are only stored once - and so, within the same table, two strings are equal
+   if and only if their pointers are
+*/
 class string_table_t: public pool<char, page_size>
 {
+  struct slot_t
+  {
+    std::uint32_t hash;
+    char*         string;
+  };
+
+  static constexpr int slot_count_min = 64;
+
+  block_list_t<slot_t> m_slot_list;
+  int     m_slot_mask;
+  int     m_string_count;
+  bool    m_intern;
+
+  private:
+          bool  uld_reserve_slots(int) noexcept;
+          auto  uld_get_slot(const char*, int, std::uint32_t) noexcept -> slot_t*;
+
   public:
-          string_table_t() noexcept;
+          string_table_t(allocator_t* = nullptr, bool = false, int = 0) noexcept;
           string_table_t(const string_table_t&) noexcept = delete;
           string_table_t(string_table_t&&) noexcept = delete;
 
           ~string_table_t();
 
+          bool  adopt(string_table_t&) noexcept;
+          void  reserve(int, int = 0) noexcept;
           char* make_string(const char*, int = 0) noexcept;
+          char* find_string(const char*, int = 0) noexcept;
           char* get_string(int) noexcept;
+          bool  is_interning() const noexcept;
+          void  get_memory_stats(memory_stats_t&) const noexcept;
 
           string_table_t& operator=(const string_table_t&) noexcept = delete;
           string_table_t& operator=(string_table_t&&) noexcept = delete;
@@ -0,0 +1,162 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "symbol_index.h"
+#include <stats.h>
+#include <cstring>
+#include <utility>
+
+namespace uld {
+
+      symbol_index_t::symbol_index_t(allocator_t* allocator) noexcept:
+      m_slot_list(allocator),
+      m_slot_mask(0),
+      m_symbol_count(0)
+{
+}
+
+      symbol_index_t::~symbol_index_t()
+{
+}
+
+/* reserve()
+   make room for (at least) `count` symbols, keeping the load of the index under one half
+*/
+bool  symbol_index_t::reserve(int count) noexcept
+{
+      int  l_slot_count = slot_count_min;
+      while(l_slot_count < count * 2) {
+          l_slot_count <<= 1;
+      }
+      if(l_slot_count > m_slot_list.size()) {
+          block_list_t<slot_t> l_slot_list(m_slot_list.get_allocator());
+          if(l_slot_list.resize(l_slot_count, slot_t{0, nullptr}) == false) {
+              return false;
+          }
+          int  l_slot_mask = l_slot_count - 1;
+          for(slot_t& l_slot : m_slot_list) {
+              if(l_slot.symbol != nullptr) {
+                  int l_slot_index = l_slot.hash & l_slot_mask;
+                  while(l_slot_list[l_slot_index].symbol != nullptr) {
+                      l_slot_index = (l_slot_index + 1) & l_slot_mask;
+                  }
+                  l_slot_list[l_slot_index] = l_slot;
+              }
+          }
+          m_slot_list.swap(l_slot_list);
+          m_slot_mask = l_slot_mask;
+      }
+      return true;
+}
+
+/* get_slot()
+   find the slot holding the symbol with the given name; nullptr if the name is not in the index
+*/
+auto  symbol_index_t::get_slot(const char* name, std::uint32_t hash) noexcept -> slot_t*
+{
+      if(m_symbol_count > 0) {
+          int  l_slot_index = hash & m_slot_mask;
+          int  l_probe_count = 1;
+          while(m_slot_list[l_slot_index].symbol != nullptr) {
+              slot_t& l_slot = m_slot_list[l_slot_index];
+              if(l_slot.hash == hash) {
+                  if(std::strcmp(l_slot.symbol->name, name) == 0) {
+                      stats::on_lookup(l_probe_count);
+                      return std::addressof(l_slot);
+                  }
+              }
+              l_slot_index = (l_slot_index + 1) & m_slot_mask;
+              l_probe_count++;
+          }
+          stats::on_lookup(l_probe_count);
+      }
+      return nullptr;
+}
+
+/* make_slot()
+   find the slot for the given name, or claim a new one for it; the caller is expected to fill in the `symbol` member of
+   a new slot
+*/
+auto  symbol_index_t::make_slot(const char* name, std::uint32_t hash) noexcept -> slot_t*
+{
+      if(slot_t*
+          l_slot_ptr = get_slot(name, hash);
+          l_slot_ptr != nullptr) {
+          return l_slot_ptr;
+      }
+      if(reserve(m_symbol_count + 1) == false) {
+          return nullptr;
+      }
+      int  l_slot_index = hash & m_slot_mask;
+      while(m_slot_list[l_slot_index].symbol != nullptr) {
+          l_slot_index = (l_slot_index + 1) & m_slot_mask;
+      }
+      m_slot_list[l_slot_index].hash = hash;
+      m_slot_list[l_slot_index].symbol = nullptr;
+      m_symbol_count++;
+      return std::addressof(m_slot_list[l_slot_index]);
+}
+
+symbol_t* symbol_index_t::find_symbol(const char* name) noexcept
+{
+      if(slot_t*
+          l_slot_ptr = get_slot(name, get_name_hash(name));
+          l_slot_ptr != nullptr) {
+          return l_slot_ptr->symbol;
+      }
+      return nullptr;
+}
+
+int   symbol_index_t::get_symbol_count() const noexcept
+{
+      return m_symbol_count;
+}
+
+/* get_memory_stats()
+   add up the memory held by the index into `stats`, all of it as overhead
+*/
+void  symbol_index_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int l_index_size = m_slot_list.capacity() * sizeof(slot_t);
+      stats.alloc_size += l_index_size;
+      stats.head_size  += l_index_size;
+}
+
+/* swap()
+   exchange contents with `other`, which has to draw from the same allocator
+*/
+void  symbol_index_t::swap(symbol_index_t& other) noexcept
+{
+      m_slot_list.swap(other.m_slot_list);
+      std::swap(m_slot_mask, other.m_slot_mask);
+      std::swap(m_symbol_count, other.m_symbol_count);
+}
+
+void  symbol_index_t::clear() noexcept
+{
+      for(slot_t& l_slot : m_slot_list) {
+          l_slot.hash = 0;
+          l_slot.symbol = nullptr;
+      }
+      m_symbol_count = 0;
+}
+
+/*namespace uld*/ }
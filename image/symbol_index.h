@@ -0,0 +1,81 @@
+#ifndef uld_image_symbol_index_h
+#define uld_image_symbol_index_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "hash.h"
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+
+namespace uld {
+
+/* symbol_index_t
+   open addressing hash index over a set of symbols, keyed by name
+*/
+class symbol_index_t
+{
+  public:
+  struct slot_t
+  {
+    std::uint32_t hash;
+    symbol_t*     symbol;
+  };
+
+  private:
+  static constexpr int slot_count_min = 64;
+
+  private:
+  block_list_t<slot_t> m_slot_list;
+  int                 m_slot_mask;
+  int                 m_symbol_count;
+
+  public:
+          symbol_index_t(allocator_t* = nullptr) noexcept;
+          symbol_index_t(const symbol_index_t&) noexcept = delete;
+          symbol_index_t(symbol_index_t&&) noexcept = delete;
+          ~symbol_index_t();
+
+          bool      reserve(int) noexcept;
+          slot_t*   get_slot(const char*, std::uint32_t) noexcept;
+          slot_t*   make_slot(const char*, std::uint32_t) noexcept;
+          symbol_t* find_symbol(const char*) noexcept;
+          int       get_symbol_count() const noexcept;
+          void      get_memory_stats(memory_stats_t&) const noexcept;
+          void      swap(symbol_index_t&) noexcept;
+          void      clear() noexcept;
+
+  inline  slot_t*   begin() noexcept {
+          return m_slot_list.data();
+  }
+
+  inline  slot_t*   end() noexcept {
+          return m_slot_list.data() + m_slot_list.size();
+  }
+
+          symbol_index_t& operator=(const symbol_index_t&) noexcept = delete;
+          symbol_index_t& operator=(symbol_index_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
@@ -0,0 +1,296 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "symbol_store.h"
+#include "symbol_table.h"
+#include "program_table.h"
+#include <cstring>
+
+namespace uld {
+
+      symbol_store_t::symbol_store_t(program_table_t* program, allocator_t* allocator) noexcept:
+      m_program(program),
+      m_key_list(allocator),
+      m_addr_list(m_key_list.get_allocator()),
+      m_size_list(m_key_list.get_allocator()),
+      m_info_list(m_key_list.get_allocator()),
+      m_name_list(m_key_list.get_allocator())
+{
+}
+
+      symbol_store_t::~symbol_store_t()
+{
+}
+
+/* uld_get_segment()
+   find the segment holding `address` and its offset into that segment; 0 - and the address itself - if there's none
+*/
+int   symbol_store_t::uld_get_segment(std::uint8_t* address, std::uintptr_t& offset) const noexcept
+{
+      if(address != nullptr) {
+          int  l_segment_count = m_program->get_segment_count();
+          if(l_segment_count > segment_count_max) {
+              l_segment_count = segment_count_max;
+          }
+          for(int i_segment = 1; i_segment < l_segment_count; i_segment++) {
+              if(segment*
+                  l_segment_ptr = m_program->get_segment_by_index(i_segment);
+                  l_segment_ptr != nullptr) {
+                  if(int
+                      l_offset = l_segment_ptr->get_table_offset(address);
+                      l_offset >= 0) {
+                      offset = l_offset;
+                      return i_segment;
+                  }
+              }
+          }
+      }
+      offset = reinterpret_cast<std::uintptr_t>(address);
+      return 0;
+}
+
+/* reserve()
+   make room for `count` more symbols, with `name_size` more bytes of names
+*/
+bool  symbol_store_t::reserve(int count, int name_size) noexcept
+{
+      int  l_count = m_key_list.size() + count;
+      return m_key_list.reserve(l_count) &&
+          m_addr_list.reserve(l_count) &&
+          m_size_list.reserve(l_count) &&
+          m_info_list.reserve(l_count) &&
+          m_name_list.reserve(m_name_list.size() + name_size);
+}
+
+/* make_symbol()
+   add a symbol to the store; returns its index, or -1 if it can't be represented: its name wouldn't fit into the name
+   block, or its runtime address is neither its effective address nor one past it - or if the store is out of memory
+*/
+int   symbol_store_t::make_symbol(
+            const char*   name,
+            unsigned int  type,
+            unsigned int  flags,
+            std::uint8_t* ea,
+            std::uint8_t* ra,
+            int           size
+      ) noexcept
+{
+      int             l_name_offset = m_name_list.size();
+      int             l_name_length;
+      std::uint16_t   l_info;
+      std::uintptr_t  l_addr;
+      key_t           l_key;
+      if(name == nullptr) {
+          return -1;
+      }
+      l_name_length = std::strlen(name);
+      if(l_name_offset + l_name_length + 1 > name_size_max) {
+          return -1;
+      }
+      l_info = (type & info_type_bits) | ((flags & symbol_t::bind_bits) << info_bind_shift);
+      if(ra == ea + 1) {
+          l_info |= info_vle;
+      } else
+      if(ra != ea) {
+          return -1;
+      }
+      l_key.hash = get_name_hash(name, l_name_length);
+      l_key.name = l_name_offset;
+      l_key.segment = uld_get_segment(ea, l_addr);
+      int  l_key_count = m_key_list.size();
+      if((m_name_list.append(name, l_name_length + 1) == false) ||
+          (m_key_list.push_back(l_key) == false) ||
+          (m_addr_list.push_back(l_addr) == false) ||
+          (m_size_list.push_back(size) == false) ||
+          (m_info_list.push_back(l_info) == false)) {
+          m_name_list.resize(l_name_offset);
+          m_key_list.resize(l_key_count);
+          m_addr_list.resize(l_key_count);
+          m_size_list.resize(l_key_count);
+          m_info_list.resize(l_key_count);
+          return -1;
+      }
+      return l_key_count;
+}
+
+int   symbol_store_t::make_symbol(const symbol_t& symbol) noexcept
+{
+      return make_symbol(symbol.name, symbol.type, symbol.flags, symbol.ea, symbol.ra, symbol.size);
+}
+
+/* load()
+   copy the named symbols of `table` whose binding matches `bind_flags` into the store; returns the number of symbols
+   copied, or -1 if one of them could not be
+*/
+int   symbol_store_t::load(symbol_table_t& table, unsigned int bind_flags) noexcept
+{
+      int          l_load_count = 0;
+      int          l_name_size = 0;
+      unsigned int l_flags = bind_flags & symbol_t::bind_any;
+      for(symbol_t& l_symbol : table) {
+          if((l_symbol.name != nullptr) &&
+              (l_symbol.name[0] != 0)) {
+              if((l_flags == symbol_t::bind_any) ||
+                  ((l_flags & l_symbol.flags) == l_flags)) {
+                  l_name_size += std::strlen(l_symbol.name) + 1;
+                  l_load_count++;
+              }
+          }
+      }
+      if(reserve(l_load_count, l_name_size) == false) {
+          return -1;
+      }
+      l_load_count = 0;
+      for(symbol_t& l_symbol : table) {
+          if((l_symbol.name != nullptr) &&
+              (l_symbol.name[0] != 0)) {
+              if((l_flags == symbol_t::bind_any) ||
+                  ((l_flags & l_symbol.flags) == l_flags)) {
+                  if(make_symbol(l_symbol) < 0) {
+                      return -1;
+                  }
+                  l_load_count++;
+              }
+          }
+      }
+      return l_load_count;
+}
+
+/* find_symbol()
+   index of the first symbol with the given name and binding; -1 if there's none
+*/
+int   symbol_store_t::find_symbol(const char* name, unsigned int bind_flags) const noexcept
+{
+      if((name) &&
+          (name[0] != 0)) {
+          std::uint32_t l_hash = get_name_hash(name);
+          unsigned int  l_flags = bind_flags & symbol_t::bind_any;
+          int           l_key_count = m_key_list.size();
+          const key_t*  l_key_list = m_key_list.data();
+          for(int i_key = 0; i_key < l_key_count; i_key++) {
+              if(l_key_list[i_key].hash == l_hash) {
+                  if(std::strcmp(m_name_list.data() + l_key_list[i_key].name, name) == 0) {
+                      if((l_flags == symbol_t::bind_any) ||
+                          ((l_flags & get_flags(i_key)) == l_flags)) {
+                          stats::on_lookup(i_key + 1);
+                          return i_key;
+                      }
+                  }
+              }
+          }
+          stats::on_lookup(l_key_count);
+      }
+      return -1;
+}
+
+/* get_symbol()
+   fill in `symbol` with the symbol at `index`; its name points into the store, and remains valid until the next symbol is
+   added
+*/
+bool  symbol_store_t::get_symbol(int index, symbol_t& symbol) const noexcept
+{
+      if((index >= 0) &&
+          (index < m_key_list.size())) {
+          symbol.name = get_name(index);
+          symbol.type = get_type(index);
+          symbol.flags = get_flags(index);
+          symbol.size = get_size(index);
+          symbol.ea = get_ea(index);
+          symbol.ra = get_ra(index);
+          return true;
+      }
+      return false;
+}
+
+auto  symbol_store_t::get_name(int index) const noexcept -> const char*
+{
+      return m_name_list.data() + m_key_list[index].name;
+}
+
+auto  symbol_store_t::get_type(int index) const noexcept -> unsigned int
+{
+      return m_info_list[index] & info_type_bits;
+}
+
+auto  symbol_store_t::get_flags(int index) const noexcept -> unsigned int
+{
+      return (m_info_list[index] & info_bind_bits) >> info_bind_shift;
+}
+
+auto  symbol_store_t::get_size(int index) const noexcept -> int
+{
+      return m_size_list[index];
+}
+
+auto  symbol_store_t::get_ea(int index) const noexcept -> std::uint8_t*
+{
+      int  l_segment = m_key_list[index].segment;
+      if(l_segment > 0) {
+          if(segment*
+              l_segment_ptr = m_program->get_segment_by_index(l_segment);
+              l_segment_ptr != nullptr) {
+              return l_segment_ptr->get_table_ptr(m_addr_list[index]);
+          }
+          return nullptr;
+      }
+      return reinterpret_cast<std::uint8_t*>(m_addr_list[index]);
+}
+
+auto  symbol_store_t::get_ra(int index) const noexcept -> std::uint8_t*
+{
+      std::uint8_t* l_ea = get_ea(index);
+      if(m_info_list[index] & info_vle) {
+          return l_ea + 1;
+      }
+      return l_ea;
+}
+
+int   symbol_store_t::get_symbol_count() const noexcept
+{
+      return m_key_list.size();
+}
+
+/* get_memory_stats()
+   add up the memory held by the store into `stats`; the arrays count as a single page each
+*/
+void  symbol_store_t::get_memory_stats(memory_stats_t& stats) const noexcept
+{
+      int  l_used_size = m_key_list.size() * sizeof(key_t) + m_addr_list.size() * sizeof(std::uintptr_t) +
+              m_size_list.size() * sizeof(std::uint32_t) + m_info_list.size() * sizeof(std::uint16_t) + m_name_list.size();
+      int  l_alloc_size = m_key_list.capacity() * sizeof(key_t) + m_addr_list.capacity() * sizeof(std::uintptr_t) +
+              m_size_list.capacity() * sizeof(std::uint32_t) + m_info_list.capacity() * sizeof(std::uint16_t) +
+              m_name_list.capacity();
+      stats.page_count += 5;
+      stats.alloc_size += l_alloc_size;
+      stats.used_size  += l_used_size;
+      stats.slack_size += l_alloc_size - l_used_size;
+}
+
+void  symbol_store_t::clear() noexcept
+{
+      m_key_list.clear();
+      m_addr_list.clear();
+      m_size_list.clear();
+      m_info_list.clear();
+      m_name_list.clear();
+}
+
+/*namespace uld*/ }
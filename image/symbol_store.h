@@ -0,0 +1,107 @@
+#ifndef uld_image_symbol_store_h
+#define uld_image_symbol_store_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "data.h"
+#include "hash.h"
+#include "allocator.h"
+#include "block_list.h"
+#include <stats.h>
+
+namespace uld {
+
+class program_table_t;
+class symbol_table_t;
+
+/* symbol_store_t
+   compact alternative to `symbol_table_t`, meant for large and rarely changing sets of symbols (i.e. the exports of an
+   image): the data a lookup scans - the hash and the offset of the name - is kept in one dense array, the rest in parallel
+   arrays indexed alike, and the names are packed back to back into a single block.
+   Addresses are stored relative to the segment they fall into, so the store needs the program table they belong to;
+   symbols outside any segment (i.e. defined by the host) keep their absolute address. Of the flags, only the binding is
+   kept.
+*/
+class symbol_store_t
+{
+  template<typename Xt>
+  using   list_t = block_list_t<Xt>;
+
+  public:
+  struct key_t
+  {
+    std::uint32_t hash;
+    std::uint32_t name:24;          // offset of the name in the name block
+    std::uint32_t segment:8;        // index of the segment holding the symbol, 0 for an absolute address
+  };
+
+  /* info_*
+     type and binding of a symbol, packed
+  */
+  static constexpr std::uint16_t info_type_bits = 0x000f;
+  static constexpr std::uint16_t info_bind_bits = 0x00f0;
+  static constexpr int           info_bind_shift = 4;
+  static constexpr std::uint16_t info_vle = 0x0100;     // the runtime address is one past the effective address
+
+  static constexpr int  name_size_max = 1 << 24;
+  static constexpr int  segment_count_max = 1 << 8;
+
+  private:
+  program_table_t*          m_program;
+  list_t<key_t>             m_key_list;     // hot: scanned by the lookups
+  list_t<std::uintptr_t>    m_addr_list;    // cold: segment relative (or absolute) effective address
+  list_t<std::uint32_t>     m_size_list;
+  list_t<std::uint16_t>     m_info_list;
+  list_t<char>              m_name_list;
+
+  private:
+          int   uld_get_segment(std::uint8_t*, std::uintptr_t&) const noexcept;
+
+  public:
+          symbol_store_t(program_table_t*, allocator_t* = nullptr) noexcept;
+          symbol_store_t(const symbol_store_t&) noexcept = delete;
+          symbol_store_t(symbol_store_t&&) noexcept = delete;
+          ~symbol_store_t();
+
+          bool  reserve(int, int = 0) noexcept;
+          int   make_symbol(const char*, unsigned int, unsigned int, std::uint8_t*, std::uint8_t*, int = 0) noexcept;
+          int   make_symbol(const symbol_t&) noexcept;
+          int   load(symbol_table_t&, unsigned int = symbol_t::bind_global) noexcept;
+          int   find_symbol(const char*, unsigned int = symbol_t::bind_any) const noexcept;
+          bool  get_symbol(int, symbol_t&) const noexcept;
+
+          auto  get_name(int) const noexcept -> const char*;
+          auto  get_type(int) const noexcept -> unsigned int;
+          auto  get_flags(int) const noexcept -> unsigned int;
+          auto  get_size(int) const noexcept -> int;
+          auto  get_ea(int) const noexcept -> std::uint8_t*;
+          auto  get_ra(int) const noexcept -> std::uint8_t*;
+          int   get_symbol_count() const noexcept;
+          void  get_memory_stats(memory_stats_t&) const noexcept;
+          void  clear() noexcept;
+
+          symbol_store_t& operator=(const symbol_store_t&) noexcept = delete;
+          symbol_store_t& operator=(symbol_store_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
@@ -21,11 +21,12 @@
 **/
 #include "symbol_table.h"
 #include "string_table.h"
+#include <stats.h>
 
 namespace uld {
 
-      symbol_table_t::symbol_table_t(string_table_t* strtab) noexcept:
-      table(),
+      symbol_table_t::symbol_table_t(string_table_t* strtab, allocator_t* allocator) noexcept:
+      table(allocator),
       m_string_table(strtab)
 {
 }
@@ -34,6 +35,11 @@ namespace uld {
 {
 }
 
+string_table_t* symbol_table_t::get_string_table() noexcept
+{
+      return m_string_table;
+}
+
 symbol_t* symbol_table_t::make_symbol(const char* name) noexcept
 {
         return make_symbol(name, symbol_t::type_undef, symbol_t::no_flags);
@@ -55,15 +61,20 @@ symbol_t* symbol_table_t::make_symbol(
             unsigned int  flags
       ) noexcept
 {
+      // intern the name ahead of the symbol, so that running out of memory doesn't leave a nameless symbol in the table
+      const char* l_name = nullptr;
+      if(name_ptr != nullptr) {
+          if(name_length <= 0) {
+              name_length = std::strlen(name_ptr);
+          }
+          l_name = m_string_table->make_string(name_ptr, name_length);
+          if(l_name == nullptr) {
+              return nullptr;
+          }
+      }
       symbol_t* l_symbol_ptr = raw_get();
       if(l_symbol_ptr != nullptr) {
-          l_symbol_ptr->name = nullptr;
-          if(name_ptr != nullptr) {
-              if(name_length <= 0) {
-                  name_length = std::strlen(name_ptr);
-              }
-              l_symbol_ptr->name = m_string_table->make_string(name_ptr, name_length);
-          }
+          l_symbol_ptr->name = l_name;
           l_symbol_ptr->type = type;
           l_symbol_ptr->flags = flags;
           l_symbol_ptr->size = 0;
@@ -79,23 +90,39 @@ symbol_t* symbol_table_t::find_symbol(const char* name, unsigned int bind_flags)
           (name[0] != 0)) {
           iterator     i_node  = begin();
           unsigned int l_flags = bind_flags & symbol_t::bind_any;
+          int          l_probe_count = 0;
+          bool         l_intern = m_string_table->is_interning();
+          if(l_intern) {
+              // all the names of the table are interned: a name the string table doesn't hold can't be found, and one that
+              // it does only needs its pointer compared
+              name = m_string_table->find_string(name);
+              if(name == nullptr) {
+                  stats::on_lookup(0);
+                  return nullptr;
+              }
+          }
           while(i_node) {
               symbol_t*   l_sym_ptr  = i_node;
               const char* l_sym_name = l_sym_ptr->name;
               if((l_sym_name) &&
                   (l_sym_name[0] != 0)) {
                   // NOTE: pretense to use strncmp() instead of strcmp() - it yields an unwarranted fault
-                  bool l_cmp_name = std::strncmp(l_sym_name, name, std::numeric_limits<short int>::max()) == 0;
+                  bool l_cmp_name = l_intern ?
+                          l_sym_name == name :
+                          std::strncmp(l_sym_name, name, std::numeric_limits<short int>::max()) == 0;
                   bool l_cmp_flags = 
                           (l_flags == symbol_t::bind_any) ||
                           ((l_flags & l_sym_ptr->flags) == l_flags);
                   if((l_cmp_name == true) &&
                       (l_cmp_flags == true)) {
+                      stats::on_lookup(l_probe_count + 1);
                       return i_node;
                   }
               }
+              l_probe_count++;
               i_node++;
           }
+          stats::on_lookup(l_probe_count);
       }
       return nullptr;
 }
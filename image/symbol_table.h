@@ -34,11 +34,12 @@ class symbol_table_t: public table<symbol_t, page_size>
   string_table_t* m_string_table;
 
   public:
-          symbol_table_t(string_table_t*) noexcept;
+          symbol_table_t(string_table_t*, allocator_t* = nullptr) noexcept;
           symbol_table_t(const symbol_table_t&) noexcept = delete;
           symbol_table_t(symbol_table_t&&) noexcept = delete;
           ~symbol_table_t();
 
+          string_table_t* get_string_table() noexcept;
           symbol_t* make_symbol(const char*) noexcept;
           symbol_t* make_symbol(const char*, unsigned int, unsigned int) noexcept;
           symbol_t* make_symbol(const char*, int, unsigned int, unsigned int) noexcept;
@@ -169,15 +169,18 @@ class table: public pool<Xt, PageSize>
   };
 
   public:
-  inline  table() noexcept:
-          pool_type() {
+  inline  table(allocator_t* allocator = nullptr) noexcept:
+          pool_type(allocator) {
   }
 
   inline  ~table() {
   }
 
   inline  iterator begin() const noexcept {
-          return   iterator(pool_type::m_page_head, pool_type::m_page_head->get_base_ptr());
+          if(pool_type::m_page_head != nullptr) {
+              return iterator(pool_type::m_page_head, pool_type::m_page_head->get_base_ptr());
+          }
+          return   end();
   }
 
   inline  iterator end() const noexcept {
@@ -0,0 +1,63 @@
+#ifndef uld_plan_h
+#define uld_plan_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include <vector>
+
+namespace uld {
+
+/* load_plan_t
+   what loading an object would take, as estimated by `image::plan()` from the object's headers and tables alone
+*/
+struct load_plan_t
+{
+  static constexpr int rel_type_max = 256;
+
+  /* segment_plan_t
+     data the object would add to one of the image segments
+  */
+  struct segment_plan_t
+  {
+    const char*   name;
+    unsigned int  type;
+    unsigned int  flags;
+    int           align;                  // alignment of the segment, as a power of 2
+    std::uint32_t section_count;
+    std::uint32_t data_size;              // bytes, alignment padding included
+  };
+
+  std::vector<segment_plan_t> segment_list;
+  std::uint32_t data_size;                // bytes added to all the segments
+  std::uint32_t symbol_count;             // function and object symbols, local ones included
+  std::uint32_t export_count;             // global definitions, to be added to the image symbol table
+  std::uint32_t import_count;             // undefined references
+  std::uint32_t unresolved_count;         // strong references the image has no definition for (yet)
+  std::uint32_t conflict_count;           // global definitions clashing with a strong definition in the image
+  std::uint32_t symbol_size;              // bytes the new image symbols and their names would take
+  std::uint32_t rel_count;
+  std::uint32_t rel_type_count[rel_type_max];
+  std::uint32_t read_size;                // bytes to read from storage, each once: headers, tables, allocated sections
+};
+
+/*namespace uld*/ }
+#endif
@@ -0,0 +1,513 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "profile.h"
+#include "image.h"
+#include "image/hash.h"
+#include <algorithm>
+#include <cstring>
+#ifdef ULD_PROFILE
+#if PICO_ON_DEVICE
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/structs/timer.h"
+#else
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+#endif
+
+namespace uld {
+
+/* s_profiler
+   the profiler the sampling interrupt feeds, if any
+*/
+static std::atomic<profiler_t*> s_profiler{nullptr};
+
+#ifdef ULD_PROFILE
+#if PICO_ON_DEVICE
+static int           s_alarm = -1;
+static std::uint32_t s_period = 0;
+
+/* uld_profile_on_irq()
+   acknowledge the alarm and arm it for the next period, then sample the program counter the alarm interrupted
+*/
+extern "C" void uld_profile_on_irq(const void* pc) noexcept
+{
+      timer_hw->intr = 1u << s_alarm;
+      timer_hw->alarm[s_alarm] = timer_hw->timerawl + s_period;
+      if(profiler_t*
+          l_profiler_ptr = s_profiler.load(std::memory_order_relaxed);
+          l_profiler_ptr != nullptr) {
+          l_profiler_ptr->put_sample(pc);
+      }
+}
+
+/* uld_profile_irq()
+   alarm interrupt handler: fetch the program counter from the exception frame, on the stack the interrupted code was
+   running on, and tail call uld_profile_on_irq() with it, which returns from the exception
+*/
+extern "C" __attribute__((naked)) void uld_profile_irq() noexcept
+{
+      __asm__ volatile(
+          "movs r0, #4\n"
+          "mov  r1, lr\n"
+          "tst  r0, r1\n"
+          "beq  1f\n"
+          "mrs  r0, psp\n"
+          "b    2f\n"
+          "1:\n"
+          "mrs  r0, msp\n"
+          "2:\n"
+          "ldr  r0, [r0, #24]\n"
+          "ldr  r1, 3f\n"
+          "bx   r1\n"
+          ".align 2\n"
+          "3:\n"
+          ".word uld_profile_on_irq\n"
+      );
+}
+
+static bool  uld_start_timer(int period) noexcept
+{
+      int l_alarm = hardware_alarm_claim_unused(false);
+      if(l_alarm < 0) {
+          return false;
+      }
+      s_alarm = l_alarm;
+      s_period = period;
+      irq_set_exclusive_handler(TIMER_IRQ_0 + l_alarm, uld_profile_irq);
+      hw_set_bits(std::addressof(timer_hw->inte), 1u << l_alarm);
+      irq_set_enabled(TIMER_IRQ_0 + l_alarm, true);
+      timer_hw->alarm[l_alarm] = timer_hw->timerawl + s_period;
+      return true;
+}
+
+static void  uld_stop_timer() noexcept
+{
+      irq_set_enabled(TIMER_IRQ_0 + s_alarm, false);
+      hw_clear_bits(std::addressof(timer_hw->inte), 1u << s_alarm);
+      timer_hw->armed = 1u << s_alarm;
+      timer_hw->intr = 1u << s_alarm;
+      irq_remove_handler(TIMER_IRQ_0 + s_alarm, uld_profile_irq);
+      hardware_alarm_unclaim(s_alarm);
+      s_alarm = -1;
+}
+#else
+static bool  s_action_set = false;
+
+/* uld_get_context_pc()
+   program counter of the interrupted thread
+*/
+static const void* uld_get_context_pc(void* context) noexcept
+{
+      ucontext_t* l_context_ptr = reinterpret_cast<ucontext_t*>(context);
+#if defined(__x86_64__)
+      return reinterpret_cast<const void*>(l_context_ptr->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__i386__)
+      return reinterpret_cast<const void*>(l_context_ptr->uc_mcontext.gregs[REG_EIP]);
+#elif defined(__aarch64__)
+      return reinterpret_cast<const void*>(l_context_ptr->uc_mcontext.pc);
+#else
+      return nullptr;
+#endif
+}
+
+static void  uld_on_sigprof(int, siginfo_t*, void* context) noexcept
+{
+      if(profiler_t*
+          l_profiler_ptr = s_profiler.load(std::memory_order_relaxed);
+          l_profiler_ptr != nullptr) {
+          l_profiler_ptr->put_sample(uld_get_context_pc(context));
+      }
+}
+
+/* uld_start_timer()
+   sample every `period` microseconds of CPU time of the process; the SIGPROF handler stays in place once set, for the
+   signals still pending when the timer stops to find no profiler rather than terminating the process
+*/
+static bool  uld_start_timer(int period) noexcept
+{
+      itimerval l_timer;
+      if(s_action_set == false) {
+          struct sigaction l_action;
+          std::memset(std::addressof(l_action), 0, sizeof(l_action));
+          l_action.sa_sigaction = uld_on_sigprof;
+          l_action.sa_flags = SA_SIGINFO | SA_RESTART;
+          sigemptyset(std::addressof(l_action.sa_mask));
+          if(sigaction(SIGPROF, std::addressof(l_action), nullptr) != 0) {
+              return false;
+          }
+          s_action_set = true;
+      }
+      l_timer.it_interval.tv_sec = period / 1000000;
+      l_timer.it_interval.tv_usec = period % 1000000;
+      l_timer.it_value = l_timer.it_interval;
+      return setitimer(ITIMER_PROF, std::addressof(l_timer), nullptr) == 0;
+}
+
+static void  uld_stop_timer() noexcept
+{
+      itimerval l_timer;
+      std::memset(std::addressof(l_timer), 0, sizeof(l_timer));
+      setitimer(ITIMER_PROF, std::addressof(l_timer), nullptr);
+}
+#endif
+#endif
+
+/* uld_put_u32(), uld_put_u64()
+   little endian stores for the dump
+*/
+static std::uint8_t* uld_put_u32(std::uint8_t* data, std::uint32_t value) noexcept
+{
+      data[0] = value & 0xff;
+      data[1] =(value >> 8) & 0xff;
+      data[2] =(value >> 16) & 0xff;
+      data[3] =(value >> 24) & 0xff;
+      return data + 4;
+}
+
+static std::uint8_t* uld_put_u64(std::uint8_t* data, std::uint64_t value) noexcept
+{
+      data = uld_put_u32(data, value & 0xffffffffu);
+      return uld_put_u32(data, value >> 32);
+}
+
+static bool  uld_is_bucket_more(const profile_bucket_t& lhs, const profile_bucket_t& rhs) noexcept
+{
+      return lhs.count > rhs.count;
+}
+
+      profiler_t::profiler_t(image* image, int ring_size, allocator_t* allocator) noexcept:
+      m_image(image),
+      m_ring(allocator),
+      m_ring_mask(0),
+      m_ring_head(0),
+      m_ring_tail(0),
+      m_drop_count(0),
+      m_bucket_list(m_ring.get_allocator()),
+      m_bucket_count(0),
+      m_sample_count(0),
+      m_other_count(0),
+      m_running(false)
+{
+      if constexpr (profile_enable) {
+          int l_ring_size = 16;
+          while(l_ring_size < ring_size) {
+              l_ring_size *= 2;
+          }
+          if(m_ring.resize(l_ring_size, nullptr)) {
+              m_ring_mask = l_ring_size - 1;
+          }
+      }
+}
+
+      profiler_t::~profiler_t()
+{
+      stop();
+}
+
+/* uld_find_bucket()
+   the histogram bucket of `name`, or the empty one it would take; the histogram grows by half its size whenever it
+   gets three quarters full
+*/
+auto  profiler_t::uld_find_bucket(const char* name) noexcept -> profile_bucket_t*
+{
+      int l_bucket_size = m_bucket_list.size();
+      if((m_bucket_count + 1) * 4 > l_bucket_size * 3) {
+          list_t<profile_bucket_t> l_bucket_list(m_bucket_list.get_allocator());
+          int l_next_size = l_bucket_size > 0 ? l_bucket_size * 2 : 64;
+          if(l_bucket_list.resize(l_next_size, profile_bucket_t{nullptr, nullptr, 0, 0, 0}) == false) {
+              return nullptr;
+          }
+          for(profile_bucket_t& l_bucket : m_bucket_list) {
+              if(l_bucket.name != nullptr) {
+                  std::uint32_t l_index = get_hash_mix(reinterpret_cast<std::uintptr_t>(l_bucket.name));
+                  while(l_bucket_list[l_index & (l_next_size - 1)].name != nullptr) {
+                      l_index++;
+                  }
+                  l_bucket_list[l_index & (l_next_size - 1)] = l_bucket;
+              }
+          }
+          m_bucket_list.swap(l_bucket_list);
+          l_bucket_size = l_next_size;
+      }
+      std::uint32_t l_index = get_hash_mix(reinterpret_cast<std::uintptr_t>(name));
+      while(true) {
+          profile_bucket_t& l_bucket = m_bucket_list[l_index & (l_bucket_size - 1)];
+          if((l_bucket.name == name) ||
+              (l_bucket.name == nullptr)) {
+              return std::addressof(l_bucket);
+          }
+          l_index++;
+      }
+}
+
+/* uld_attribute()
+   count a sample against the symbol of the image or of its parents which holds it, or failing that, against the segment;
+   samples out of both, or which the histogram has no room for, count as `other`
+*/
+void  profiler_t::uld_attribute(const void* address) noexcept
+{
+      const char*         l_name = nullptr;
+      const std::uint8_t* l_address = nullptr;
+      std::uint32_t       l_size = 0;
+      unsigned int        l_type = profile_bucket_t::bucket_symbol;
+      m_sample_count++;
+      for(image* i_image = m_image; i_image != nullptr; i_image = i_image->get_parent()) {
+          if(symbol_t*
+              l_symbol_ptr = i_image->find_symbol_by_address(address);
+              l_symbol_ptr != nullptr) {
+              l_name = l_symbol_ptr->name;
+              l_address = l_symbol_ptr->ea;
+              l_size = l_symbol_ptr->size;
+              break;
+          }
+      }
+      if(l_name == nullptr) {
+          for(image* i_image = m_image; (i_image != nullptr) && (l_name == nullptr); i_image = i_image->get_parent()) {
+              program_table_t* l_program_ptr = i_image->get_program_table();
+              for(int i_segment = 1; i_segment < l_program_ptr->get_segment_count(); i_segment++) {
+                  if(segment*
+                      l_segment_ptr = l_program_ptr->get_segment_by_index(i_segment);
+                      l_segment_ptr != nullptr) {
+                      if(l_segment_ptr->get_table_offset(reinterpret_cast<const std::uint8_t*>(address)) >= 0) {
+                          l_name = l_segment_ptr->get_name();
+                          l_type = profile_bucket_t::bucket_segment;
+                          break;
+                      }
+                  }
+              }
+          }
+      }
+      if(l_name != nullptr) {
+          if(profile_bucket_t*
+              l_bucket_ptr = uld_find_bucket(l_name);
+              l_bucket_ptr != nullptr) {
+              if(l_bucket_ptr->name == nullptr) {
+                  l_bucket_ptr->name = l_name;
+                  l_bucket_ptr->address = l_address;
+                  l_bucket_ptr->size = l_size;
+                  l_bucket_ptr->type = l_type;
+                  m_bucket_count++;
+              }
+              l_bucket_ptr->count++;
+              return;
+          }
+      }
+      m_other_count++;
+}
+
+/* start()
+   start sampling every `period` microseconds; fails if the profiler was built out, if another profiler is sampling or
+   if the period is shorter than `profile_period_min`
+*/
+bool  profiler_t::start(int period) noexcept
+{
+      if constexpr (profile_enable) {
+          profiler_t* l_profiler_ptr = nullptr;
+          if(m_running || m_ring.empty() || (period < profile_period_min)) {
+              return false;
+          }
+          if(s_profiler.compare_exchange_strong(l_profiler_ptr, this) == false) {
+              return false;
+          }
+#ifdef ULD_PROFILE
+          if(uld_start_timer(period) == false) {
+              s_profiler.store(nullptr);
+              return false;
+          }
+#endif
+          m_running = true;
+          return true;
+      }
+      return false;
+}
+
+void  profiler_t::stop() noexcept
+{
+      if(m_running) {
+#ifdef ULD_PROFILE
+          uld_stop_timer();
+#endif
+          s_profiler.store(nullptr);
+          m_running = false;
+      }
+}
+
+bool  profiler_t::is_running() const noexcept
+{
+      return m_running;
+}
+
+/* put_sample()
+   queue a program counter sample; safe to call from interrupt context, and to feed the profiler from a sampling source
+   of the caller's own, though only ever from one at a time
+*/
+void  profiler_t::put_sample(const void* address) noexcept
+{
+      if constexpr (profile_enable) {
+          std::uint32_t l_head = m_ring_head.load(std::memory_order_relaxed);
+          std::uint32_t l_tail = m_ring_tail.load(std::memory_order_acquire);
+          if((m_ring.empty() == false) &&
+              (l_head - l_tail <= m_ring_mask)) {
+              m_ring[l_head & m_ring_mask] = address;
+              m_ring_head.store(l_head + 1, std::memory_order_release);
+          } else
+              m_drop_count.store(m_drop_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      }
+}
+
+/* drain()
+   attribute the queued samples to the histogram; to call from the thread doing the loads, often enough for the ring
+   not to fill up. Returns the count of samples drained.
+*/
+int   profiler_t::drain() noexcept
+{
+      std::uint32_t l_tail = m_ring_tail.load(std::memory_order_relaxed);
+      std::uint32_t l_head = m_ring_head.load(std::memory_order_acquire);
+      int           l_drain_count = l_head - l_tail;
+      while(l_tail != l_head) {
+          uld_attribute(m_ring[l_tail & m_ring_mask]);
+          l_tail++;
+      }
+      m_ring_tail.store(l_tail, std::memory_order_release);
+      return l_drain_count;
+}
+
+/* get_histogram()
+   copy the `count` buckets with the most samples into `bucket_list`, by descending sample count; returns the count of
+   buckets copied
+*/
+int   profiler_t::get_histogram(profile_bucket_t* bucket_list, int count) const noexcept
+{
+      int l_copy_count = 0;
+      if(count > 0) {
+          for(const profile_bucket_t& l_bucket : m_bucket_list) {
+              if(l_bucket.name != nullptr) {
+                  if(l_copy_count < count) {
+                      bucket_list[l_copy_count++] = l_bucket;
+                      std::push_heap(bucket_list, bucket_list + l_copy_count, uld_is_bucket_more);
+                  } else
+                  if(l_bucket.count > bucket_list[0].count) {
+                      std::pop_heap(bucket_list, bucket_list + l_copy_count, uld_is_bucket_more);
+                      bucket_list[l_copy_count - 1] = l_bucket;
+                      std::push_heap(bucket_list, bucket_list + l_copy_count, uld_is_bucket_more);
+                  }
+              }
+          }
+          std::sort_heap(bucket_list, bucket_list + l_copy_count, uld_is_bucket_more);
+      }
+      return l_copy_count;
+}
+
+int   profiler_t::get_bucket_count() const noexcept
+{
+      return m_bucket_count;
+}
+
+/* get_sample_count()
+   samples drained so far, those attributed to no bucket included
+*/
+std::uint32_t profiler_t::get_sample_count() const noexcept
+{
+      return m_sample_count;
+}
+
+/* get_drop_count()
+   samples lost to a full ring
+*/
+std::uint32_t profiler_t::get_drop_count() const noexcept
+{
+      return m_drop_count.load(std::memory_order_relaxed);
+}
+
+/* get_other_count()
+   samples out of the code and data of the image and its parents, i.e. in the firmware
+*/
+std::uint32_t profiler_t::get_other_count() const noexcept
+{
+      return m_other_count;
+}
+
+int   profiler_t::get_dump_size() const noexcept
+{
+      int l_dump_size = profile_header_size + m_bucket_count * profile_bucket_size;
+      for(const profile_bucket_t& l_bucket : m_bucket_list) {
+          if(l_bucket.name != nullptr) {
+              l_dump_size += std::strlen(l_bucket.name) + 1;
+          }
+      }
+      return l_dump_size;
+}
+
+/* dump()
+   write the histogram into `data`, in the layout described by `profile_magic`, the buckets in no particular order;
+   returns the count of bytes written, or 0 if `size` is less than get_dump_size()
+*/
+int   profiler_t::dump(std::uint8_t* data, int size) const noexcept
+{
+      int           l_dump_size = get_dump_size();
+      std::uint8_t* l_data_ptr = data;
+      std::uint8_t* l_name_base = data + profile_header_size + m_bucket_count * profile_bucket_size;
+      std::uint8_t* l_name_ptr = l_name_base;
+      if(size < l_dump_size) {
+          return 0;
+      }
+      l_data_ptr = uld_put_u32(l_data_ptr, profile_magic);
+      l_data_ptr = uld_put_u32(l_data_ptr, profile_version);
+      l_data_ptr = uld_put_u32(l_data_ptr, m_sample_count);
+      l_data_ptr = uld_put_u32(l_data_ptr, get_drop_count());
+      l_data_ptr = uld_put_u32(l_data_ptr, m_other_count);
+      l_data_ptr = uld_put_u32(l_data_ptr, m_bucket_count);
+      l_data_ptr = uld_put_u32(l_data_ptr, data + l_dump_size - l_name_base);
+      for(const profile_bucket_t& l_bucket : m_bucket_list) {
+          if(l_bucket.name != nullptr) {
+              int l_name_size = std::strlen(l_bucket.name) + 1;
+              l_data_ptr = uld_put_u64(l_data_ptr, reinterpret_cast<std::uintptr_t>(l_bucket.address));
+              l_data_ptr = uld_put_u32(l_data_ptr, l_bucket.size);
+              l_data_ptr = uld_put_u32(l_data_ptr, l_bucket.count);
+              l_data_ptr = uld_put_u32(l_data_ptr, l_bucket.type);
+              l_data_ptr = uld_put_u32(l_data_ptr, l_name_ptr - l_name_base);
+              std::memcpy(l_name_ptr, l_bucket.name, l_name_size);
+              l_name_ptr += l_name_size;
+          }
+      }
+      return l_dump_size;
+}
+
+/* clear()
+   discard the queued samples and the histogram
+*/
+void  profiler_t::clear() noexcept
+{
+      m_ring_tail.store(m_ring_head.load(std::memory_order_acquire), std::memory_order_release);
+      for(profile_bucket_t& l_bucket : m_bucket_list) {
+          l_bucket = profile_bucket_t{nullptr, nullptr, 0, 0, 0};
+      }
+      m_bucket_count = 0;
+      m_sample_count = 0;
+      m_other_count = 0;
+      m_drop_count.store(0, std::memory_order_relaxed);
+}
+
+/*namespace uld*/ }
@@ -0,0 +1,115 @@
+#ifndef uld_profile_h
+#define uld_profile_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "config.h"
+#include "image/allocator.h"
+#include "image/block_list.h"
+#include <atomic>
+
+namespace uld {
+
+/* profile_bucket_t
+   histogram entry of the profiler: the samples that fell into a function or object of the image, or, for code the image
+   tables hold no symbol for (i.e. static functions), into one of its segments
+*/
+struct profile_bucket_t
+{
+  static constexpr unsigned int bucket_symbol  = 0u;
+  static constexpr unsigned int bucket_segment = 1u;
+
+  const char*         name;
+  const std::uint8_t* address;    // start of the symbol, nullptr for segments
+  std::uint32_t       size;       // size of the symbol, 0 for segments
+  std::uint32_t       count;      // samples
+  unsigned int        type;
+};
+
+/* profile_*
+   layout of the binary dump of a profile (see `profiler_t::dump()`), all fields little endian: a header, the buckets,
+   then their names, zero terminated, back to back
+*/
+constexpr std::uint32_t profile_magic = 0x50444c55;   // "ULDP"
+constexpr std::uint32_t profile_version = 1u;
+constexpr int profile_header_size = 28;   // magic, version, sample, drop and other counts, bucket count, names size
+constexpr int profile_bucket_size = 24;   // address (64 bit), size, count, type, name offset
+
+/* profile_period_min
+   shortest sampling period, in microseconds, start() accepts, such that the overhead of the sampling stays bounded
+*/
+constexpr int profile_period_min = 100;
+
+/* profiler_t
+   sampling profiler for the code loaded into an image: the program counter is sampled from a periodic interrupt (on the
+   device a hardware alarm, on host builds SIGPROF from a profiling interval timer) into a fixed size ring, at a constant
+   cost per sample and without locks, samples which find the ring full being counted and dropped; drain() attributes
+   them, from the thread doing the loads, to the functions and objects of the image and of its parents, and failing
+   those, to their segments. Only one profiler samples at a time. Compiles to a stub unless built with ULD_PROFILE.
+*/
+class profiler_t
+{
+  template<typename Xt>
+  using   list_t = block_list_t<Xt>;
+
+  image*          m_image;
+  list_t<const void*> m_ring;
+  std::uint32_t   m_ring_mask;
+  std::atomic<std::uint32_t> m_ring_head;   // written by the sampling interrupt only
+  std::atomic<std::uint32_t> m_ring_tail;   // written by drain() only
+  std::atomic<std::uint32_t> m_drop_count;  // written by the sampling interrupt only
+  list_t<profile_bucket_t> m_bucket_list;   // open addressing over the name pointers
+  int             m_bucket_count;
+  std::uint32_t   m_sample_count;
+  std::uint32_t   m_other_count;
+  bool            m_running;
+
+  private:
+          auto  uld_find_bucket(const char*) noexcept -> profile_bucket_t*;
+          void  uld_attribute(const void*) noexcept;
+
+  public:
+          profiler_t(image*, int = 1024, allocator_t* = nullptr) noexcept;
+          profiler_t(const profiler_t&) noexcept = delete;
+          profiler_t(profiler_t&&) noexcept = delete;
+          ~profiler_t();
+
+          bool  start(int) noexcept;
+          void  stop() noexcept;
+          bool  is_running() const noexcept;
+          void  put_sample(const void*) noexcept;
+          int   drain() noexcept;
+          int   get_histogram(profile_bucket_t*, int) const noexcept;
+          int   get_bucket_count() const noexcept;
+          std::uint32_t get_sample_count() const noexcept;
+          std::uint32_t get_drop_count() const noexcept;
+          std::uint32_t get_other_count() const noexcept;
+          int   get_dump_size() const noexcept;
+          int   dump(std::uint8_t*, int) const noexcept;
+          void  clear() noexcept;
+
+          profiler_t& operator=(const profiler_t&) noexcept = delete;
+          profiler_t& operator=(profiler_t&&) noexcept = delete;
+};
+
+/*namespace uld*/ }
+#endif
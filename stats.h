@@ -0,0 +1,270 @@
+#ifndef uld_stats_h
+#define uld_stats_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "config.h"
+
+namespace uld {
+
+/* load_stats_t
+   statistics collected while loading objects into an image, see `image::get_load_stats()`
+*/
+struct load_stats_t
+{
+  static constexpr int phase_prefetch = 0;
+  static constexpr int phase_import = 1;
+  static constexpr int phase_bind = 2;
+  static constexpr int phase_resolve = 3;
+  static constexpr int phase_export = 4;
+  static constexpr int phase_fixup = 5;
+  static constexpr int phase_count = 6;
+
+  static constexpr int rel_type_max = 256;
+
+  std::uint32_t phase_time[phase_count];  // time spent in each of the load phases, in microseconds
+  std::uint32_t read_count;               // f_read() calls
+  std::uint32_t read_bytes;               // bytes returned by f_read()
+  std::uint32_t seek_count;               // f_lseek() calls
+  std::uint32_t cache_hit_count;          // data cache requests served from the buffer
+  std::uint32_t cache_miss_count;         // data cache requests which needed a file read
+  std::uint32_t cache_refill_count;       // data cache seeks outside the buffer, discarding its contents
+  std::uint32_t lookup_count;             // symbol lookups
+  std::uint32_t lookup_probe_count;       // entries compared by all the symbol lookups
+  std::uint32_t lookup_probe_max;         // entries compared by the longest symbol lookup
+  std::uint32_t rel_count;                // relocations applied
+  std::uint32_t rel_type_count[rel_type_max];  // relocations applied, per type
+  std::uint32_t heap_used;                // bytes held by the pools, as of the end of the load
+  std::uint32_t heap_peak;                // most bytes held by the pools at any time during the load
+  std::uint32_t align_pad_size;           // bytes skipped to align the sections to their `sh_addralign`
+  std::int32_t  align_saved_size;         // bytes saved over rounding every section to the alignment of its segment
+};
+
+/* memory_stats_t
+   memory held by one or more pools, see `image::get_memory_stats()`; each page splits into header (and rounding) bytes,
+   used bytes and slack at its end, such that `alloc_size` == `head_size` + `used_size` + `slack_size`
+*/
+struct memory_stats_t
+{
+  std::uint32_t page_count;
+  std::uint32_t alloc_size;               // bytes allocated for the pages
+  std::uint32_t head_size;                // bytes taken by the page headers or too few to hold an element
+  std::uint32_t used_size;                // bytes handed out, padding included
+  std::uint32_t pad_size;                 // bytes of alignment padding and size rounding, part of `used_size`
+  std::uint32_t slack_size;               // bytes left unused at the end of the pages
+
+  inline  void  add(const memory_stats_t& stats) noexcept {
+          page_count += stats.page_count;
+          alloc_size += stats.alloc_size;
+          head_size += stats.head_size;
+          used_size += stats.used_size;
+          pad_size += stats.pad_size;
+          slack_size += stats.slack_size;
+  }
+};
+
+/* image_memory_stats_t
+   memory held by an image, per pool
+*/
+struct image_memory_stats_t
+{
+  memory_stats_t string_table;
+  memory_stats_t symbol_table;
+  memory_stats_t fixup_table;
+  memory_stats_t program_table;           // all the segments, see `program_table_t::get_segment_memory_stats()`
+  memory_stats_t total;
+  std::uint32_t  heap_used;               // bytes currently held by the pools of all the images
+  std::uint32_t  heap_peak;               // most bytes held by the pools of all the images during the latest load
+};
+
+namespace stats {
+
+/* s_heap_used, s_heap_peak
+   bytes held by pool pages and their high watermark since the latest reset_heap_peak(); tracked regardless of
+   `load_stats_enable`
+*/
+inline std::uint32_t s_heap_used = 0;
+inline std::uint32_t s_heap_peak = 0;
+
+inline  void  reset_heap_peak() noexcept {
+        s_heap_peak = s_heap_used;
+}
+
+/* s_load_stats
+   stats of the load currently in progress, if any
+*/
+inline load_stats_t* s_load_stats = nullptr;
+
+/* begin()
+   start collecting stats into `stats_ptr`, whose heap figures start from the bytes the pools already hold
+*/
+inline  void  begin(load_stats_t* stats_ptr) noexcept {
+        if constexpr (load_stats_enable) {
+            s_load_stats = stats_ptr;
+            if(s_load_stats != nullptr) {
+                s_load_stats->heap_used = s_heap_used;
+                s_load_stats->heap_peak = s_heap_used;
+            }
+        }
+}
+
+/* end()
+   stop collecting stats
+*/
+inline  void  end() noexcept {
+        if constexpr (load_stats_enable) {
+            s_load_stats = nullptr;
+        }
+}
+
+inline  std::uint32_t get_time() noexcept {
+        if constexpr (load_stats_enable) {
+            return time_us_32();
+        }
+        return 0;
+}
+
+/* on_phase()
+   account the time elapsed since `time_base` to the load phase `phase`
+*/
+inline  void  on_phase(int phase, std::uint32_t time_base) noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->phase_time[phase] += time_us_32() - time_base;
+            }
+        }
+}
+
+inline  void  on_read(int size) noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->read_count++;
+                s_load_stats->read_bytes += size;
+            }
+        }
+}
+
+inline  void  on_seek() noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->seek_count++;
+            }
+        }
+}
+
+inline  void  on_cache_hit() noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->cache_hit_count++;
+            }
+        }
+}
+
+inline  void  on_cache_miss() noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->cache_miss_count++;
+            }
+        }
+}
+
+inline  void  on_cache_refill() noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->cache_refill_count++;
+            }
+        }
+}
+
+/* on_lookup()
+   account a symbol lookup which compared `probe_count` entries
+*/
+inline  void  on_lookup(int probe_count) noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->lookup_count++;
+                s_load_stats->lookup_probe_count += probe_count;
+                if(s_load_stats->lookup_probe_max < static_cast<std::uint32_t>(probe_count)) {
+                    s_load_stats->lookup_probe_max = probe_count;
+                }
+            }
+        }
+}
+
+inline  void  on_rel(int type) noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->rel_count++;
+                if((type >= 0) &&
+                    (type < load_stats_t::rel_type_max)) {
+                    s_load_stats->rel_type_count[type]++;
+                }
+            }
+        }
+}
+
+/* on_align()
+   account the `pad_size` bytes a section was aligned by, against the `default_size` bytes rounding its size to the
+   alignment of its segment would have taken
+*/
+inline  void  on_align(int pad_size, int default_size) noexcept {
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->align_pad_size += pad_size;
+                s_load_stats->align_saved_size += default_size - pad_size;
+            }
+        }
+}
+
+inline  void  on_alloc(int size) noexcept {
+        s_heap_used += size;
+        if(s_heap_peak < s_heap_used) {
+            s_heap_peak = s_heap_used;
+        }
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                s_load_stats->heap_used += size;
+                if(s_load_stats->heap_peak < s_load_stats->heap_used) {
+                    s_load_stats->heap_peak = s_load_stats->heap_used;
+                }
+            }
+        }
+}
+
+inline  void  on_free(int size) noexcept {
+        if(s_heap_used > static_cast<std::uint32_t>(size)) {
+            s_heap_used -= size;
+        } else
+            s_heap_used = 0;
+        if constexpr (load_stats_enable) {
+            if(s_load_stats != nullptr) {
+                if(s_load_stats->heap_used > static_cast<std::uint32_t>(size)) {
+                    s_load_stats->heap_used -= size;
+                } else
+                    s_load_stats->heap_used = 0;
+            }
+        }
+}
+
+/*namespace stats*/ }
+/*namespace uld*/ }
+#endif
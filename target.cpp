@@ -22,6 +22,7 @@
 #include "target.h"
 #include <elf.h>
 #include "hardware/regs/addressmap.h"
+#include <cstring>
 #include <limits>
 
 namespace uld {
@@ -60,13 +61,21 @@ static const char* s_section_name[] =
       m_class(machine_class),
       m_vle_bit(machine_vle == true),
       m_lsb_bit(machine_lsb == true),
-      m_msb_bit(machine_lsb == false)
+      m_msb_bit(machine_lsb == false),
+      m_region_list{},
+      m_arena_list{},
+      m_region_count(0)
 {
       // set machine-specific defaults
       if(m_machine == EM_ARM) {
           m_abi_id = ELFOSABI_ARM;
           m_abi_version = 0u;
           m_class = bin_32;
+      } else
+      if(m_machine == EM_X86_64) {
+          m_abi_id = ELFOSABI_NONE;
+          m_abi_version = 0u;
+          m_class = bin_64;
       }
 }
 
@@ -189,9 +198,12 @@ int   target::get_default_align() const noexcept
       return 0;
 }
 
+/* get_vle_bit()
+   offset VLE targets (like thumb) add to the address of their functions; 0 for the others
+*/
 long int target::get_vle_bit() const noexcept
 {
-      return 1;
+      return m_vle_bit ? 1 : 0;
 }
 
 long int target::get_vle_mask() const noexcept
@@ -199,6 +211,90 @@ long int target::get_vle_mask() const noexcept
       return std::numeric_limits<long int>::max() ^ get_vle_bit();
 }
 
+/* add_region()
+   add a region of `size` bytes at `base` to the memory map of the target, which the placement rules of the images (see
+   `program_table_t::add_region_rule()`) can then send sections to; the segments of a region take their memory from
+   `allocator` or, given none, from an arena over the region, if it's writable. The name isn't copied.
+   Regions can't overlap; a region over a static array (i.e. one the linker puts into a scratch bank) simulates a
+   memory of the target on a host.
+*/
+auto  target::add_region(const char* name, void* base, std::size_t size, unsigned int flags, allocator_t* allocator) noexcept -> const region_t*
+{
+      std::uint8_t* l_region_base = reinterpret_cast<std::uint8_t*>(base);
+      if((name == nullptr) ||
+          (size == 0) ||
+          (m_region_count >= region_count_max)) {
+          return nullptr;
+      }
+      for(int i_region = 0; i_region < m_region_count; i_region++) {
+          const region_t& l_region = m_region_list[i_region];
+          if(std::strcmp(l_region.name, name) == 0) {
+              return nullptr;
+          }
+          if((l_region_base < l_region.base + l_region.size) &&
+              (l_region.base < l_region_base + size)) {
+              return nullptr;
+          }
+      }
+      if(allocator == nullptr) {
+          if(flags & region_write) {
+              auto l_arena_ptr = std::unique_ptr<arena_allocator_t>(new(std::nothrow) arena_allocator_t(base, size));
+              if(l_arena_ptr == nullptr) {
+                  return nullptr;
+              }
+              allocator = l_arena_ptr.get();
+              m_arena_list[m_region_count] = std::move(l_arena_ptr);
+          }
+      }
+      region_t& l_region = m_region_list[m_region_count++];
+      l_region.name = name;
+      l_region.base = l_region_base;
+      l_region.size = size;
+      l_region.flags = flags;
+      l_region.allocator = allocator;
+      return std::addressof(l_region);
+}
+
+auto  target::get_region(int index) const noexcept -> const region_t*
+{
+      if((index >= 0) &&
+          (index < m_region_count)) {
+          return std::addressof(m_region_list[index]);
+      }
+      return nullptr;
+}
+
+auto  target::get_region_by_name(const char* name) const noexcept -> const region_t*
+{
+      for(int i_region = 0; i_region < m_region_count; i_region++) {
+          if(std::strcmp(m_region_list[i_region].name, name) == 0) {
+              return std::addressof(m_region_list[i_region]);
+          }
+      }
+      return nullptr;
+}
+
+/* get_region_by_address()
+   region of the memory map holding `address`, if any
+*/
+auto  target::get_region_by_address(const void* address) const noexcept -> const region_t*
+{
+      const std::uint8_t* l_address = reinterpret_cast<const std::uint8_t*>(address);
+      for(int i_region = 0; i_region < m_region_count; i_region++) {
+          const region_t& l_region = m_region_list[i_region];
+          if((l_address >= l_region.base) &&
+              (l_address < l_region.base + l_region.size)) {
+              return std::addressof(l_region);
+          }
+      }
+      return nullptr;
+}
+
+int   target::get_region_count() const noexcept
+{
+      return m_region_count;
+}
+
 bool  target::is_vle() const noexcept
 {
       return m_vle_bit;
@@ -22,10 +22,25 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "uld.h"
+#include "image/allocator.h"
+#include <memory>
 #include <string>
 
 namespace uld {
 
+/* region_t
+   named range of the target address space, along with the allocator the segments placed into it take their memory
+   from, see `target::add_region()`
+*/
+struct region_t
+{
+  const char*   name;
+  std::uint8_t* base;
+  std::size_t   size;
+  unsigned int  flags;          // region_* attributes, see `target`
+  allocator_t*  allocator;      // nullptr if the loader can't place anything into the region
+};
+
 /* target
    runtime configuration object for runtime images
 */
@@ -62,6 +77,26 @@ class target
   bool  m_lsb_bit;
   bool  m_msb_bit;
 
+  public:
+  /* region_*
+     memory region attributes
+  */
+  static constexpr unsigned int region_read    = 0x00000001;
+  static constexpr unsigned int region_write   = 0x00000002;
+  static constexpr unsigned int region_execute = 0x00000004;
+  static constexpr unsigned int region_xip     = 0x00000010;  // flash behind the execute-in-place cache
+  static constexpr unsigned int region_rwx     = region_read | region_write | region_execute;
+
+  static constexpr int region_count_max = 8;
+
+  private:
+  /* m_region_list
+     memory map of the target, see add_region(); regions the caller gives no allocator for get an arena over their range
+  */
+  region_t  m_region_list[region_count_max];
+  std::unique_ptr<arena_allocator_t> m_arena_list[region_count_max];
+  int       m_region_count;
+
   public:
   /* smt_*
      section meta-types
@@ -112,6 +147,12 @@ class target
           long int      get_vle_bit() const noexcept;
           long int      get_vle_mask() const noexcept;
 
+          auto          add_region(const char*, void*, std::size_t, unsigned int, allocator_t* = nullptr) noexcept -> const region_t*;
+          auto          get_region(int) const noexcept -> const region_t*;
+          auto          get_region_by_name(const char*) const noexcept -> const region_t*;
+          auto          get_region_by_address(const void*) const noexcept -> const region_t*;
+          int           get_region_count() const noexcept;
+
           bool          is_vle() const noexcept;
 
           bool          is_lsb() const noexcept;
@@ -0,0 +1,352 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <elf.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* exportgen
+   build-time generator for the firmware export table (see image/export_table.h): writes a source file which defines
+   `uld_export_table`, sorted and hashed at compile time and kept in flash along with the names, for the image to resolve
+   the firmware exports against without registering them at startup. The addresses are left to the linker, the table
+   referring to each export by its symbol name.
+
+   usage: exportgen [-o <file>] [-e <elf>] [<list>...]
+     -o  write the table to <file> instead of stdout
+     -e  export the global and weak function and object definitions of the ELF file <elf> (i.e. a previous build of the
+         firmware), only those the lists name if any are given
+     <list> text file naming one export per line, as `<name> [function|object] [weak]` (default: function); `#` starts
+         a comment
+*/
+
+namespace {
+
+struct entry_t
+{
+  std::string   name;
+  std::uint32_t hash;
+  bool          object;
+  bool          weak;
+};
+
+FILE*        s_out = stdout;
+
+/* get_name_hash()
+   FNV-1a hash of a name: the same as uld::get_name_hash(), which the generated table checks its order against
+*/
+std::uint32_t get_name_hash(const std::string& name) noexcept
+{
+      std::uint32_t l_hash = 2166136261u;
+      for(unsigned char l_char : name) {
+          l_hash ^= l_char;
+          l_hash *= 16777619u;
+      }
+      return l_hash;
+}
+
+bool  is_entry_less(const entry_t& lhs, const entry_t& rhs) noexcept
+{
+      return (lhs.hash < rhs.hash) || ((lhs.hash == rhs.hash) && (lhs.name < rhs.name));
+}
+
+bool  is_entry_same(const entry_t& lhs, const entry_t& rhs) noexcept
+{
+      return lhs.name == rhs.name;
+}
+
+/* read_list()
+   append the exports named in the list file at `path`
+*/
+bool  read_list(const char* path, std::vector<entry_t>& entry_list) noexcept
+{
+      FILE* l_file = std::fopen(path, "r");
+      if(l_file == nullptr) {
+          std::fprintf(stderr, "exportgen: cannot open `%s`\n", path);
+          return false;
+      }
+      char l_line[512];
+      int  l_line_index = 0;
+      bool l_result = true;
+      while(std::fgets(l_line, sizeof(l_line), l_file) != nullptr) {
+          l_line_index++;
+          if(char*
+              l_comment = std::strchr(l_line, '#');
+              l_comment != nullptr) {
+              *l_comment = 0;
+          }
+          char* l_save = nullptr;
+          char* l_name = strtok_r(l_line, " \t\r\n", &l_save);
+          if(l_name == nullptr) {
+              continue;
+          }
+          entry_t l_entry{l_name, 0, false, false};
+          while(char*
+              l_word = strtok_r(nullptr, " \t\r\n", &l_save)) {
+              if(std::strcmp(l_word, "function") == 0) {
+                  l_entry.object = false;
+              } else
+              if(std::strcmp(l_word, "object") == 0) {
+                  l_entry.object = true;
+              } else
+              if(std::strcmp(l_word, "weak") == 0) {
+                  l_entry.weak = true;
+              } else {
+                  std::fprintf(stderr, "exportgen: %s:%d: unknown attribute `%s`\n", path, l_line_index, l_word);
+                  l_result = false;
+              }
+          }
+          entry_list.push_back(l_entry);
+      }
+      std::fclose(l_file);
+      return l_result;
+}
+
+/* read_elf()
+   append the global and weak, visible, function and object definitions of an ELF file
+*/
+template<typename Ehdr, typename Shdr, typename Sym>
+bool  read_elf(const std::vector<std::uint8_t>& data, std::vector<entry_t>& entry_list) noexcept
+{
+      const Ehdr* l_ehdr = reinterpret_cast<const Ehdr*>(data.data());
+      if((l_ehdr->e_shoff == 0) ||
+          (l_ehdr->e_shentsize != sizeof(Shdr)) ||
+          (l_ehdr->e_shoff + l_ehdr->e_shnum * sizeof(Shdr) > data.size())) {
+          return false;
+      }
+      const Shdr* l_shdr_list = reinterpret_cast<const Shdr*>(data.data() + l_ehdr->e_shoff);
+      // prefer the full symbol table, the dynamic one otherwise
+      const Shdr* l_symtab = nullptr;
+      for(int i_shdr = 0; i_shdr < l_ehdr->e_shnum; i_shdr++) {
+          if(l_shdr_list[i_shdr].sh_type == SHT_SYMTAB) {
+              l_symtab = l_shdr_list + i_shdr;
+              break;
+          }
+          if(l_shdr_list[i_shdr].sh_type == SHT_DYNSYM) {
+              l_symtab = l_shdr_list + i_shdr;
+          }
+      }
+      if((l_symtab == nullptr) ||
+          (l_symtab->sh_link >= l_ehdr->e_shnum) ||
+          (l_symtab->sh_offset + l_symtab->sh_size > data.size())) {
+          return false;
+      }
+      const Shdr& l_strtab = l_shdr_list[l_symtab->sh_link];
+      if(l_strtab.sh_offset + l_strtab.sh_size > data.size()) {
+          return false;
+      }
+      const Sym*  l_sym_list = reinterpret_cast<const Sym*>(data.data() + l_symtab->sh_offset);
+      const char* l_str_list = reinterpret_cast<const char*>(data.data() + l_strtab.sh_offset);
+      int         l_sym_count = l_symtab->sh_size / sizeof(Sym);
+      for(int i_sym = 1; i_sym < l_sym_count; i_sym++) {
+          const Sym&   l_sym = l_sym_list[i_sym];
+          unsigned int l_type = l_sym.st_info & 15;
+          unsigned int l_bind = l_sym.st_info >> 4;
+          unsigned int l_visibility = l_sym.st_other & 3;
+          if((l_sym.st_shndx == SHN_UNDEF) ||
+              (l_sym.st_name == 0) ||
+              (l_sym.st_name >= l_strtab.sh_size)) {
+              continue;
+          }
+          if((l_type != STT_FUNC) &&
+              (l_type != STT_OBJECT)) {
+              continue;
+          }
+          if((l_bind != STB_GLOBAL) &&
+              (l_bind != STB_WEAK)) {
+              continue;
+          }
+          if((l_visibility == STV_HIDDEN) ||
+              (l_visibility == STV_INTERNAL)) {
+              continue;
+          }
+          entry_list.push_back(entry_t{l_str_list + l_sym.st_name, 0, l_type == STT_OBJECT, l_bind == STB_WEAK});
+      }
+      return true;
+}
+
+bool  read_elf(const char* path, std::vector<entry_t>& entry_list) noexcept
+{
+      std::vector<std::uint8_t> l_data;
+      if(FILE*
+          l_file = std::fopen(path, "rb");
+          l_file != nullptr) {
+          std::uint8_t l_buffer[4096];
+          std::size_t  l_size;
+          while((l_size = std::fread(l_buffer, 1, sizeof(l_buffer), l_file)) > 0) {
+              l_data.insert(l_data.end(), l_buffer, l_buffer + l_size);
+          }
+          std::fclose(l_file);
+      } else {
+          std::fprintf(stderr, "exportgen: cannot open `%s`\n", path);
+          return false;
+      }
+      bool l_result = false;
+      if((l_data.size() >= EI_NIDENT) &&
+          (std::memcmp(l_data.data(), ELFMAG, SELFMAG) == 0)) {
+          if((l_data[EI_CLASS] == ELFCLASS32) &&
+              (l_data.size() >= sizeof(Elf32_Ehdr))) {
+              l_result = read_elf<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym>(l_data, entry_list);
+          } else
+          if((l_data[EI_CLASS] == ELFCLASS64) &&
+              (l_data.size() >= sizeof(Elf64_Ehdr))) {
+              l_result = read_elf<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym>(l_data, entry_list);
+          }
+      }
+      if(l_result == false) {
+          std::fprintf(stderr, "exportgen: `%s` is not an ELF file with a symbol table\n", path);
+      }
+      return l_result;
+}
+
+/* put_string()
+   write a name as a C string literal
+*/
+void  put_string(const std::string& name) noexcept
+{
+      std::fputc('"', s_out);
+      for(char l_char : name) {
+          if((l_char == '"') ||
+              (l_char == '\\')) {
+              std::fputc('\\', s_out);
+          }
+          std::fputc(l_char, s_out);
+      }
+      std::fputc('"', s_out);
+}
+
+/* put_table()
+   write the source of the table: each export is referred to by a declaration of its own, with the export name given as
+   the assembler name, such that none of them clashes with the declarations the firmware headers may have
+*/
+void  put_table(const std::vector<entry_t>& entry_list) noexcept
+{
+      std::fprintf(s_out, "// generated by exportgen, do not edit\n#include <image/export_table.h>\n\n");
+      if(entry_list.empty()) {
+          std::fprintf(s_out, "extern \"C\" constexpr uld::export_table_t uld_export_table(nullptr, 0);\n");
+          return;
+      }
+      std::fprintf(s_out, "extern \"C\" {\n");
+      for(std::size_t i_entry = 0; i_entry < entry_list.size(); i_entry++) {
+          std::fprintf(s_out, "extern char uld_export_%zu[] __asm__(", i_entry);
+          put_string(entry_list[i_entry].name);
+          std::fprintf(s_out, ");\n");
+      }
+      std::fprintf(s_out, "}\n\nnamespace {\n\nconstexpr uld::export_t s_export_list[] = {\n");
+      for(std::size_t i_entry = 0; i_entry < entry_list.size(); i_entry++) {
+          const entry_t& l_entry = entry_list[i_entry];
+          std::fprintf(s_out, "    {");
+          put_string(l_entry.name);
+          std::fprintf(s_out, ", uld::get_name_hash(");
+          put_string(l_entry.name);
+          std::fprintf(
+              s_out,
+              "), uld::symbol_t::%s, uld::symbol_t::%s, uld_export_%zu},\n",
+              l_entry.object ? "type_object" : "type_function",
+              l_entry.weak ? "bind_weak" : "bind_global",
+              i_entry
+          );
+      }
+      std::fprintf(
+          s_out,
+          "};\n\n"
+          "static_assert(uld::export_table_t::is_sorted(s_export_list), \"export table out of order\");\n\n"
+          "/*namespace*/ }\n\n"
+          "extern \"C\" constexpr uld::export_table_t uld_export_table(s_export_list);\n"
+      );
+}
+
+/*namespace*/ }
+
+int   main(int argc, char** argv)
+{
+      const char*              l_out_path = nullptr;
+      const char*              l_elf_path = nullptr;
+      std::vector<const char*> l_list_path_list;
+      for(int i_arg = 1; i_arg < argc; i_arg++) {
+          if((std::strcmp(argv[i_arg], "-o") == 0) && (i_arg + 1 < argc)) {
+              l_out_path = argv[++i_arg];
+          } else
+          if((std::strcmp(argv[i_arg], "-e") == 0) && (i_arg + 1 < argc)) {
+              l_elf_path = argv[++i_arg];
+          } else
+          if(argv[i_arg][0] == '-') {
+              std::fprintf(stderr, "usage: exportgen [-o <file>] [-e <elf>] [<list>...]\n");
+              return 1;
+          } else {
+              l_list_path_list.push_back(argv[i_arg]);
+          }
+      }
+
+      std::vector<entry_t> l_list;
+      for(const char* l_path : l_list_path_list) {
+          if(read_list(l_path, l_list) == false) {
+              return 1;
+          }
+      }
+
+      std::vector<entry_t> l_entry_list;
+      if(l_elf_path != nullptr) {
+          if(read_elf(l_elf_path, l_entry_list) == false) {
+              return 1;
+          }
+          if(l_list_path_list.empty() == false) {
+              // keep only the definitions the lists name, with the types the ELF gives them
+              std::vector<std::string> l_name_list;
+              for(const entry_t& l_entry : l_list) {
+                  l_name_list.push_back(l_entry.name);
+              }
+              std::sort(l_name_list.begin(), l_name_list.end());
+              std::vector<entry_t> l_keep_list;
+              for(const entry_t& l_entry : l_entry_list) {
+                  if(std::binary_search(l_name_list.begin(), l_name_list.end(), l_entry.name)) {
+                      l_keep_list.push_back(l_entry);
+                  }
+              }
+              l_entry_list.swap(l_keep_list);
+          }
+      } else {
+          l_entry_list.swap(l_list);
+      }
+
+      // sort by hash, then by name for the duplicates to follow each other
+      for(entry_t& l_entry : l_entry_list) {
+          l_entry.hash = get_name_hash(l_entry.name);
+      }
+      std::sort(l_entry_list.begin(), l_entry_list.end(), is_entry_less);
+      l_entry_list.erase(std::unique(l_entry_list.begin(), l_entry_list.end(), is_entry_same), l_entry_list.end());
+
+      if(l_out_path != nullptr) {
+          s_out = std::fopen(l_out_path, "w");
+          if(s_out == nullptr) {
+              std::fprintf(stderr, "exportgen: cannot open `%s`\n", l_out_path);
+              return 1;
+          }
+      }
+      put_table(l_entry_list);
+      if(s_out != stdout) {
+          std::fclose(s_out);
+      }
+      return 0;
+}
@@ -0,0 +1,156 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* profdump
+   prints the histogram of a profile dump (see profile.h, `profiler_t::dump()`), by descending sample count
+
+   usage: profdump [-n <count>] <dump>
+     -n  print the <count> buckets with the most samples only
+*/
+
+namespace {
+
+constexpr std::uint32_t s_profile_magic = 0x50444c55;
+constexpr std::uint32_t s_profile_version = 1u;
+constexpr std::size_t   s_header_size = 28;
+constexpr std::size_t   s_bucket_size = 24;
+
+struct bucket_t
+{
+  std::uint64_t address;
+  std::uint32_t size;
+  std::uint32_t count;
+  std::uint32_t type;
+  std::string   name;
+};
+
+std::uint32_t get_u32(const std::uint8_t* data) noexcept
+{
+      return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+}
+
+std::uint64_t get_u64(const std::uint8_t* data) noexcept
+{
+      return get_u32(data) | (static_cast<std::uint64_t>(get_u32(data + 4)) << 32);
+}
+
+bool  is_bucket_more(const bucket_t& lhs, const bucket_t& rhs) noexcept
+{
+      return lhs.count > rhs.count;
+}
+
+/*namespace*/ }
+
+int   main(int argc, char** argv)
+{
+      const char* l_path = nullptr;
+      int         l_count = -1;
+      for(int i_arg = 1; i_arg < argc; i_arg++) {
+          if((std::strcmp(argv[i_arg], "-n") == 0) && (i_arg + 1 < argc)) {
+              l_count = std::atoi(argv[++i_arg]);
+          } else
+          if((argv[i_arg][0] == '-') || (l_path != nullptr)) {
+              std::fprintf(stderr, "usage: profdump [-n <count>] <dump>\n");
+              return 1;
+          } else {
+              l_path = argv[i_arg];
+          }
+      }
+      if(l_path == nullptr) {
+          std::fprintf(stderr, "usage: profdump [-n <count>] <dump>\n");
+          return 1;
+      }
+
+      std::vector<std::uint8_t> l_data;
+      if(FILE* l_file = std::fopen(l_path, "rb"); l_file != nullptr) {
+          std::uint8_t l_block[4096];
+          std::size_t  l_size;
+          while((l_size = std::fread(l_block, 1, sizeof(l_block), l_file)) > 0) {
+              l_data.insert(l_data.end(), l_block, l_block + l_size);
+          }
+          std::fclose(l_file);
+      } else {
+          std::fprintf(stderr, "profdump: failed to open `%s`.\n", l_path);
+          return 1;
+      }
+      if((l_data.size() < s_header_size) ||
+          (get_u32(l_data.data()) != s_profile_magic) ||
+          (get_u32(l_data.data() + 4) != s_profile_version)) {
+          std::fprintf(stderr, "profdump: `%s` is not a profile dump.\n", l_path);
+          return 1;
+      }
+      std::uint32_t l_sample_count = get_u32(l_data.data() + 8);
+      std::uint32_t l_drop_count = get_u32(l_data.data() + 12);
+      std::uint32_t l_other_count = get_u32(l_data.data() + 16);
+      std::uint32_t l_bucket_count = get_u32(l_data.data() + 20);
+      std::uint32_t l_name_size = get_u32(l_data.data() + 24);
+      std::size_t   l_name_base = s_header_size + l_bucket_count * s_bucket_size;
+      if(l_data.size() < l_name_base + l_name_size) {
+          std::fprintf(stderr, "profdump: `%s` is truncated.\n", l_path);
+          return 1;
+      }
+
+      std::vector<bucket_t> l_bucket_list;
+      for(std::uint32_t i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+          const std::uint8_t* l_bucket_ptr = l_data.data() + s_header_size + i_bucket * s_bucket_size;
+          std::uint32_t       l_name_offset = get_u32(l_bucket_ptr + 20);
+          if(l_name_offset >= l_name_size) {
+              std::fprintf(stderr, "profdump: `%s` is corrupt.\n", l_path);
+              return 1;
+          }
+          const char*   l_name_ptr = reinterpret_cast<const char*>(l_data.data() + l_name_base + l_name_offset);
+          l_bucket_list.push_back(
+              bucket_t{
+                  get_u64(l_bucket_ptr),
+                  get_u32(l_bucket_ptr + 8),
+                  get_u32(l_bucket_ptr + 12),
+                  get_u32(l_bucket_ptr + 16),
+                  std::string(l_name_ptr, strnlen(l_name_ptr, l_name_size - l_name_offset))
+              }
+          );
+      }
+      std::stable_sort(l_bucket_list.begin(), l_bucket_list.end(), is_bucket_more);
+      if((l_count >= 0) &&
+          (l_bucket_list.size() > static_cast<std::size_t>(l_count))) {
+          l_bucket_list.resize(l_count);
+      }
+
+      std::printf("samples %u, dropped %u, other %u\n", l_sample_count, l_drop_count, l_other_count);
+      for(const bucket_t& l_bucket : l_bucket_list) {
+          std::printf(
+              "%10u %6.2f%%  %016llx %8u  %s%s\n",
+              l_bucket.count,
+              l_sample_count > 0 ? l_bucket.count * 100.0 / l_sample_count : 0.0,
+              static_cast<unsigned long long>(l_bucket.address),
+              l_bucket.size,
+              l_bucket.name.c_str(),
+              l_bucket.type != 0 ? " (segment)" : ""
+          );
+      }
+      return 0;
+}
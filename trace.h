@@ -0,0 +1,119 @@
+#ifndef uld_trace_h
+#define uld_trace_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <uld.h>
+#include "config.h"
+
+namespace uld {
+
+/* io_trace_t
+   receiver for the file accesses of the loader, as seen by the data caches (`util::data_cache_t`) and by the direct section
+   reads which bypass them; caches and files are identified by address: `file` is the FatFs FIL the access applies to
+*/
+struct io_trace_t
+{
+  void* context;
+  void  (*on_cache_make)(void* context, const void* cache, const void* file, int reserve_size);
+  void  (*on_cache_free)(void* context, const void* cache);
+  void  (*on_cache_seek)(void* context, const void* cache, int position);
+  void  (*on_cache_fetch)(void* context, const void* cache, int size);
+  void  (*on_cache_lock)(void* context, const void* cache);
+  void  (*on_cache_unlock)(void* context, const void* cache);
+  void  (*on_file_read)(void* context, const void* file, int position, int size);
+};
+
+namespace trace {
+
+/* s_io_trace
+   current trace receiver, if any
+*/
+inline io_trace_t* s_io_trace = nullptr;
+
+/* set_io_trace()
+   start reporting file accesses to `trace_ptr`, or stop, with nullptr
+*/
+inline  void  set_io_trace(io_trace_t* trace_ptr) noexcept {
+        if constexpr (io_trace_enable) {
+            s_io_trace = trace_ptr;
+        }
+}
+
+inline  void  on_cache_make(const void* cache, const void* file, int reserve_size) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_cache_make(s_io_trace->context, cache, file, reserve_size);
+            }
+        }
+}
+
+inline  void  on_cache_free(const void* cache) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_cache_free(s_io_trace->context, cache);
+            }
+        }
+}
+
+inline  void  on_cache_seek(const void* cache, int position) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_cache_seek(s_io_trace->context, cache, position);
+            }
+        }
+}
+
+inline  void  on_cache_fetch(const void* cache, int size) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_cache_fetch(s_io_trace->context, cache, size);
+            }
+        }
+}
+
+inline  void  on_cache_lock(const void* cache) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_cache_lock(s_io_trace->context, cache);
+            }
+        }
+}
+
+inline  void  on_cache_unlock(const void* cache) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_cache_unlock(s_io_trace->context, cache);
+            }
+        }
+}
+
+inline  void  on_file_read(const void* file, int position, int size) noexcept {
+        if constexpr (io_trace_enable) {
+            if(s_io_trace != nullptr) {
+                s_io_trace->on_file_read(s_io_trace->context, file, position, size);
+            }
+        }
+}
+
+/*namespace trace*/ }
+/*namespace uld*/ }
+#endif
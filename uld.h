@@ -37,6 +37,14 @@ class image;
 class segment;
 class program;
 
+namespace elf32 {
+class factory;
+/*namespace elf32*/ }
+
+namespace elf64 {
+class factory;
+/*namespace elf64*/ }
+
 /* bin_*
     values for binary class
 */